@@ -0,0 +1,6 @@
+#include "guarded_header.h"
+
+void a(Guarded& guarded)
+{
+	guarded.method();
+}
@@ -0,0 +1,6 @@
+#include "guarded_header.h"
+
+void b(Guarded& guarded)
+{
+	guarded.method();
+}
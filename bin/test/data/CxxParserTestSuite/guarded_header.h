@@ -0,0 +1,10 @@
+#ifndef GUARDED_HEADER_H
+#define GUARDED_HEADER_H
+
+class Guarded
+{
+public:
+	void method();
+};
+
+#endif	  // GUARDED_HEADER_H
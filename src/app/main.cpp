@@ -1,8 +1,13 @@
 #include "includes.h"
 
+#include <algorithm>
+#include <atomic>
 #include <csignal>
+#include <fstream>
 #include <iostream>
 
+#include <QTimer>
+
 #include "language_packages.h"
 
 #include "Application.h"
@@ -11,14 +16,20 @@
 #include "CommandLineParser.h"
 #include "ConsoleLogger.h"
 #include "FileLogger.h"
+#include "GraphMetricsReport.h"
+#include "IndexingProfile.h"
 #include "LanguagePackageManager.h"
 #include "LogManager.h"
 #include "MessageIndexingInterrupted.h"
 #include "MessageLoadProject.h"
 #include "MessageStatus.h"
+#include "PersistentStorage.h"
+#include "Project.h"
+#include "ProjectSettings.h"
 #include "QtApplication.h"
 #include "QtCoreApplication.h"
 #include "QtNetworkFactory.h"
+#include "QtProjectWatcher.h"
 #include "QtViewFactory.h"
 #include "ResourcePaths.h"
 #include "ScopedFunctor.h"
@@ -46,8 +57,29 @@
 #	include "SourceGroupFactoryModulePython.h"
 #endif	  // BUILD_PYTHON_LANGUAGE_PACKAGE
 
+bool s_watchProject = false;
+std::atomic<bool> s_signalReceived(false);
+
 void signalHandler(int signum)
 {
+	// only async-signal-safe operations are allowed here, the signal is handled on the event loop
+	s_signalReceived = true;
+}
+
+void handleReceivedSignal()
+{
+	if (!s_signalReceived.exchange(false))
+	{
+		return;
+	}
+
+	if (s_watchProject)
+	{
+		std::cout << "stop watching" << std::endl;
+		s_watchProject = false;
+		Application::getInstance()->setWatchMode(false);
+	}
+
 	std::cout << "interrupt indexing" << std::endl;
 	MessageIndexingInterrupted().dispatch();
 }
@@ -91,6 +123,63 @@ void addLanguagePackages()
 #endif	  // BUILD_JAVA_LANGUAGE_PACKAGE
 }
 
+int printGraphMetrics(const commandline::CommandLineParser& commandLineParser)
+{
+	ProjectSettings settings(commandLineParser.getProjectFilePath());
+	if (!settings.reload())
+	{
+		std::cerr << "ERROR: project file could not be loaded" << std::endl;
+		return 1;
+	}
+
+	const FilePath dbFilePath = settings.getDBFilePath();
+	if (!dbFilePath.exists())
+	{
+		std::cerr << "ERROR: project has not been indexed yet" << std::endl;
+		return 1;
+	}
+
+	PersistentStorage storage(dbFilePath, settings.getBookmarkDBFilePath());
+	if (storage.isEmpty() || storage.isIncompatible())
+	{
+		std::cerr << "ERROR: project needs to be reindexed" << std::endl;
+		return 1;
+	}
+
+	storage.setup();
+	storage.setMode(SqliteIndexStorage::STORAGE_MODE_READ);
+	storage.buildCaches();
+
+	// member edges only lead from parents to their children
+	Edge::TypeMask edgeTypes = ~Edge::EDGE_MEMBER;
+	if (commandLineParser.getMetricsCallsOnly())
+	{
+		edgeTypes = Edge::EDGE_CALL;
+	}
+
+	const std::string report = GraphMetricsReport::create(
+		storage,
+		edgeTypes,
+		commandLineParser.getMetricsTopCount(),
+		static_cast<size_t>(std::max(utility::getIdealThreadCount(), 1)));
+
+	const FilePath& outputFilePath = commandLineParser.getMetricsOutputFilePath();
+	if (outputFilePath.empty())
+	{
+		std::cout << report << std::endl;
+		return 0;
+	}
+
+	std::ofstream outputFile(outputFilePath.str());
+	outputFile << report << std::endl;
+	if (!outputFile)
+	{
+		std::cerr << "ERROR: metrics could not be written to " << outputFilePath.str() << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
 int main(int argc, char* argv[])
 {
 	QCoreApplication::addLibraryPath(QStringLiteral("."));
@@ -148,6 +237,10 @@ int main(int argc, char* argv[])
 		signal(SIGTERM, signalHandler);
 		signal(SIGABRT, signalHandler);
 
+		QTimer signalTimer;
+		QObject::connect(&signalTimer, &QTimer::timeout, handleReceivedSignal);
+		signalTimer.start(100);
+
 		commandLineParser.parse();
 
 		if (commandLineParser.exitApplication())
@@ -155,12 +248,29 @@ int main(int argc, char* argv[])
 			return 0;
 		}
 
+		std::shared_ptr<QtProjectWatcher> projectWatcher;
+
 		if (commandLineParser.hasError())
 		{
 			std::wcout << commandLineParser.getError() << std::endl;
 		}
 		else
 		{
+			if (commandLineParser.getMetricsRequested())
+			{
+				return printGraphMetrics(commandLineParser);
+			}
+
+			if (commandLineParser.getWatchRequested())
+			{
+				s_watchProject = true;
+				Application::getInstance()->setWatchMode(true);
+				projectWatcher = std::make_shared<QtProjectWatcher>(
+					commandLineParser.getWatchDebounceMs());
+			}
+
+			IndexingProfile::setEnabled(commandLineParser.getIndexingProfileRequested());
+
 			MessageLoadProject(
 				commandLineParser.getProjectFilePath(),
 				false,
@@ -169,7 +279,19 @@ int main(int argc, char* argv[])
 				.dispatch();
 		}
 
-		return qtApp.exec();
+		const int ret = qtApp.exec();
+
+		if (commandLineParser.getIndexingProfileRequested())
+		{
+			if (std::shared_ptr<const Project> project =
+					Application::getInstance()->getCurrentProject())
+			{
+				std::cout << IndexingProfile::createReport(
+					project->getIndexingPhaseDurations(), 20);
+			}
+		}
+
+		return ret;
 	}
 	else
 	{
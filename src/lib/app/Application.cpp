@@ -177,6 +177,16 @@ bool Application::hasGUI()
 	return m_hasGUI;
 }
 
+void Application::setWatchMode(bool watchMode)
+{
+	m_watchMode = watchMode;
+
+	if (!m_hasGUI && !m_watchMode && !(m_project && m_project->isIndexing()))
+	{
+		MessageQuitApplication().dispatch();
+	}
+}
+
 int Application::handleDialog(const std::wstring& message)
 {
 	return getDialogView(DialogView::UseCase::GENERAL)->confirm(message);
@@ -236,7 +246,7 @@ void Application::handleMessage(MessageIndexingFinished* message)
 	{
 		MessageRefreshUI().afterIndexing().dispatch();
 	}
-	else
+	else if (!m_watchMode)
 	{
 		MessageQuitApplication().dispatch();
 	}
@@ -434,7 +444,7 @@ void Application::refreshProject(RefreshMode refreshMode, bool shallowIndexingRe
 		m_project->refresh(
 			getDialogView(DialogView::UseCase::INDEXING), refreshMode, shallowIndexingRequested);
 
-		if (!m_hasGUI && !m_project->isIndexing())
+		if (!m_hasGUI && !m_watchMode && !m_project->isIndexing())
 		{
 			MessageQuitApplication().dispatch();
 		}
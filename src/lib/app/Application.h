@@ -1,6 +1,7 @@
 #ifndef APPLICATION_H
 #define APPLICATION_H
 
+#include <atomic>
 #include <memory>
 
 #include "DialogView.h"
@@ -53,6 +54,9 @@ public:
 
 	bool hasGUI();
 
+	// keeps a headless application running after indexing, quits when disabled while idle
+	void setWatchMode(bool watchMode);
+
 	int handleDialog(const std::wstring& message);
 	int handleDialog(const std::wstring& message, const std::vector<std::wstring>& options);
 	std::shared_ptr<DialogView> getDialogView(DialogView::UseCase useCase);
@@ -90,6 +94,7 @@ private:
 
 	const bool m_hasGUI;
 	bool m_loadedWindow = false;
+	std::atomic<bool> m_watchMode = false;
 
 	std::shared_ptr<Project> m_project;
 	std::shared_ptr<StorageCache> m_storageCache;
@@ -1,6 +1,9 @@
 #include "TabId.h"
 
+#include <limits>
+
 Id TabId::s_nextTabId = 10;
+Id TabId::s_nextTabBackgroundId = std::numeric_limits<Id>::max();
 Id TabId::s_currentTabId = 0;
 
 Id TabId::app()
@@ -28,6 +31,11 @@ Id TabId::currentTab()
 	return s_currentTabId;
 }
 
+Id TabId::nextTabBackground()
+{
+	return s_nextTabBackgroundId--;
+}
+
 void TabId::setCurrentTabId(Id currentTabId)
 {
 	s_currentTabId = currentTabId;
@@ -13,10 +13,14 @@ public:
 	static Id nextTab();
 	static Id currentTab();
 
+	// scheduler for background work of a single tab, taken from a range apart from the tab ids
+	static Id nextTabBackground();
+
 	static void setCurrentTabId(Id currentTabId);
 
 private:
 	static Id s_nextTabId;
+	static Id s_nextTabBackgroundId;
 	static Id s_currentTabId;
 };
 
@@ -13,6 +13,10 @@
 #include "MessageActivateNodes.h"
 #include "MessageStatus.h"
 #include "StorageAccess.h"
+#include "TabId.h"
+#include "TaskLambda.h"
+#include "TaskManager.h"
+#include "TaskScheduler.h"
 #include "TokenComponentAccess.h"
 #include "TokenComponentFilePath.h"
 #include "TokenComponentInheritanceChain.h"
@@ -22,9 +26,44 @@
 #include "utility.h"
 #include "utilityString.h"
 
+namespace
+{
+bool addDummyNodePath(DummyNode* node, const DummyNode* target, std::vector<DummyNode*>* path)
+{
+	path->push_back(node);
+
+	if (node == target)
+	{
+		return true;
+	}
+
+	for (const std::shared_ptr<DummyNode>& subNode: node->subNodes)
+	{
+		if (addDummyNodePath(subNode.get(), target, path))
+		{
+			return true;
+		}
+	}
+
+	path->pop_back();
+	return false;
+}
+}	 // namespace
+
 GraphController::GraphController(StorageAccess* storageAccess)
-	: m_storageAccess(storageAccess), m_useBezierEdges(false)
+	: m_storageAccess(storageAccess)
+	, m_useBezierEdges(false)
+	, m_querySchedulerId(TabId::nextTabBackground())
+{
+	TaskManager::createScheduler(m_querySchedulerId)->startSchedulerLoopThreaded();
+}
+
+GraphController::~GraphController()
 {
+	cancelGraphQuery();
+
+	TaskManager::getScheduler(m_querySchedulerId)->stopSchedulerLoop();
+	TaskManager::destroyScheduler(m_querySchedulerId);
 }
 
 Id GraphController::getSchedulerId() const
@@ -97,6 +136,8 @@ void GraphController::handleMessage(MessageActivateTokens* message)
 
 	if (message->isEdge || message->keepContent())
 	{
+		finishGraphQuery();
+
 		m_activeEdgeIds = message->tokenIds;
 		if (message->isBundledEdges)	   // only on redo
 		{
@@ -119,7 +160,10 @@ void GraphController::handleMessage(MessageActivateTokens* message)
 		getView()->activateEdge(edgeId);
 		return;
 	}
-	else if (message->isBundledEdges)
+
+	cancelGraphQuery();
+
+	if (message->isBundledEdges)
 	{
 		m_activeNodeIds.clear();
 		m_activeEdgeIds = message->tokenIds;
@@ -136,81 +180,15 @@ void GraphController::handleMessage(MessageActivateTokens* message)
 		return;
 	}
 
-	std::vector<Id> tokenIds = utility::concat(m_activeNodeIds, m_activeEdgeIds);
-
-	bool isNamespace = false;
-	std::shared_ptr<Graph> graph = m_storageAccess->getGraphForActiveTokenIds(
-		tokenIds, getExpandedNodeIds(), &isNamespace);
-
-	createDummyGraphAndSetActiveAndVisibility(tokenIds, graph, !message->isFromSearch);
-
-	if (isNamespace)
-	{
-		addCharacterIndex();
-
-		DummyNode* group = groupAllNodes(GroupType::NAMESPACE, tokenIds[0]);
-		group->groupLayout = GroupLayout::LIST;
-
-		if (!group->name.size())
-		{
-			group->name = m_storageAccess->getNameHierarchyForNodeId(tokenIds[0]).getQualifiedName();
-			group->tokenId = tokenIds[0];
-		}
-
-		layoutNesting();
-		layoutList();
-	}
-	else
-	{
-		if (m_activeNodeIds.size() == 1)
-		{
-			bundleNodes();
-		}
-		else if (message->isBundledEdges)
-		{
-			bool isInheritanceChain = true;
-			for (const auto& edge: m_dummyEdges)
-			{
-				if (!edge->data->isType(Edge::EDGE_INHERITANCE))
-				{
-					isInheritanceChain = false;
-					break;
-				}
-			}
-
-			if (isInheritanceChain)
-			{
-				for (auto& node: m_dummyNodes)
-				{
-					node->bundleInfo.layoutVertical = true;
-				}
-			}
-
-			m_useBezierEdges = !isInheritanceChain;
-
-			for (const std::shared_ptr<DummyEdge>& edge: m_dummyEdges)
-			{
-				edge->active = false;
-			}
-		}
-
-		groupNodesByParents(getView()->getGrouping());
-
-		layoutNesting();
-		layoutGraph(true);
-		assignBundleIds();
-	}
-
-	GraphView::GraphParams params;
-	params.centerActiveNode = !isNamespace;
-	params.scrollToTop = isNamespace;
-	buildGraph(message, params);
+	startGraphQuery(message, utility::concat(m_activeNodeIds, m_activeEdgeIds));
 }
 
 void GraphController::handleMessage(MessageActivateTrail* message)
 {
 	TRACE("trail activate");
 
+	cancelGraphQuery();
+
 	MessageStatus(L"Retrieving graph data", false, true).dispatch();
 
 	m_activeEdgeIds.clear();
@@ -222,7 +200,8 @@ void GraphController::handleMessage(MessageActivateTrail* message)
 		message->edgeTypes,
 		message->nodeNonIndexed,
 		message->depth,
-		true /* !message->custom || (message->originId && message->targetId) */);
+		true /* !message->custom || (message->originId && message->targetId) */,
+		message->maxPathCount);
 
 	// remove non-indexed files from include graph if indexed file is origin
 	if (!message->custom && message->edgeTypes & Edge::EDGE_INCLUDE)
@@ -310,6 +289,8 @@ void GraphController::handleMessage(MessageActivateTrailEdge* message)
 {
 	TRACE("trail edge activate");
 
+	finishGraphQuery();
+
 	m_activeEdgeIds = message->edgeIds;
 	setVisibility(setActive(utility::concat(m_activeNodeIds, m_activeEdgeIds), true));
 
@@ -320,6 +301,8 @@ void GraphController::handleMessage(MessageDeactivateEdge* message)
 {
 	TRACE("edge deactivate");
 
+	finishGraphQuery();
+
 	m_activeEdgeIds.clear();
 	setActive(utility::concat(m_activeNodeIds, m_activeEdgeIds), false);
 
@@ -328,6 +311,8 @@ void GraphController::handleMessage(MessageDeactivateEdge* message)
 
 void GraphController::handleMessage(MessageFocusChanged* message)
 {
+	finishGraphQuery();
+
 	if (message->isReplayed() && message->isFromGraph())
 	{
 		m_tokenIdToFocus = message->tokenOrLocationId;
@@ -336,6 +321,8 @@ void GraphController::handleMessage(MessageFocusChanged* message)
 
 void GraphController::handleMessage(MessageFlushUpdates* message)
 {
+	finishGraphQuery();
+
 	GraphView::GraphParams params;
 	params.centerActiveNode = true;
 	params.animatedTransition = !message->keepContent();
@@ -344,6 +331,8 @@ void GraphController::handleMessage(MessageFlushUpdates* message)
 
 void GraphController::handleMessage(MessageScrollGraph* message)
 {
+	finishGraphQuery();
+
 	if (message->isReplayed())
 	{
 		getView()->scrollToValues(message->xValue, message->yValue);
@@ -352,16 +341,22 @@ void GraphController::handleMessage(MessageScrollGraph* message)
 
 void GraphController::handleMessage(MessageFocusIn* message)
 {
+	finishGraphQuery();
+
 	getView()->coFocusTokenIds(message->tokenIds);
 }
 
 void GraphController::handleMessage(MessageFocusOut* message)
 {
+	finishGraphQuery();
+
 	getView()->deCoFocusTokenIds(message->tokenIds);
 }
 
 void GraphController::handleMessage(MessageGraphNodeBundleSplit* message)
 {
+	finishGraphQuery();
+
 	std::wstring name;
 	if (m_dummyNodes.size() == 1 && m_dummyNodes[0]->isGroupNode())
 	{
@@ -438,6 +433,8 @@ void GraphController::handleMessage(MessageGraphNodeBundleSplit* message)
 
 void GraphController::handleMessage(MessageGraphNodeExpand* message)
 {
+	finishGraphQuery();
+
 	if (message->ignoreIfNotReplayed && !message->isReplayed())
 	{
 		return;
@@ -457,6 +454,7 @@ void GraphController::handleMessage(MessageGraphNodeExpand* message)
 	if (dummyNode)
 	{
 		dummyNode->expanded = message->expand;
+		bool addedEdges = false;
 
 		if (message->expand && dummyNode->hasMissingChildNodes())
 		{
@@ -504,13 +502,14 @@ void GraphController::handleMessage(MessageGraphNodeExpand* message)
 							m_storageAccess->getGraphForActiveTokenIds(
 								bundledEdgesIds, std::vector<Id>());
 
-						bundledEdgesGraph->forEachEdge([this](Edge* e) {
+						bundledEdgesGraph->forEachEdge([this, &addedEdges](Edge* e) {
 							if (!e->isType(Edge::EDGE_MEMBER))
 							{
 								m_dummyEdges.push_back(std::make_shared<DummyEdge>(
 									e->getFrom()->getId(),
 									e->getTo()->getId(),
 									m_graph->addEdgeAsPlainCopy(e)));
+								addedEdges = true;
 							}
 						});
 					}
@@ -520,7 +519,15 @@ void GraphController::handleMessage(MessageGraphNodeExpand* message)
 
 		setActiveAndVisibility(utility::concat(m_activeNodeIds, m_activeEdgeIds));
 
-		layoutNesting();
+		// new edges can connect nodes outside of the expanded node
+		if (addedEdges)
+		{
+			layoutNesting();
+		}
+		else
+		{
+			layoutNestingOfNode(dummyNode);
+		}
 		layoutGraph();
 
 		buildGraph(message, GraphView::GraphParams());
@@ -529,6 +536,8 @@ void GraphController::handleMessage(MessageGraphNodeExpand* message)
 
 void GraphController::handleMessage(MessageGraphNodeHide* message)
 {
+	finishGraphQuery();
+
 	DummyNode* node = getDummyGraphNodeById(message->tokenId).get();
 	DummyEdge* edge = nullptr;
 	if (node)
@@ -572,6 +581,8 @@ void GraphController::handleMessage(MessageGraphNodeHide* message)
 
 void GraphController::handleMessage(MessageGraphNodeMove* message)
 {
+	finishGraphQuery();
+
 	DummyNode* node = getDummyGraphNodeById(message->tokenId).get();
 	if (node)
 	{
@@ -611,6 +622,8 @@ void GraphController::handleMessage(MessageGraphNodeMove* message)
 
 void GraphController::handleMessage(MessageShowReference* message)
 {
+	finishGraphQuery();
+
 	if (!message->tokenId || !message->fromUser)
 	{
 		return;
@@ -631,6 +644,8 @@ GraphView* GraphController::getView() const
 
 void GraphController::clear()
 {
+	cancelGraphQuery();
+
 	m_dummyNodes.clear();
 	m_dummyEdges.clear();
 
@@ -648,6 +663,161 @@ void GraphController::clear()
 	getView()->clear();
 }
 
+void GraphController::startGraphQuery(
+	MessageActivateTokens* message, const std::vector<Id>& tokenIds)
+{
+	std::shared_ptr<GraphQuery> query = std::make_shared<GraphQuery>();
+	query->message = std::make_shared<MessageActivateTokens>(*message);
+	query->tokenIds = tokenIds;
+
+	{
+		std::lock_guard<std::mutex> lock(m_graphQueryMutex);
+		query->generation = m_graphQueryGeneration;
+		m_graphQuery = query;
+	}
+
+	Task::dispatch(
+		m_querySchedulerId,
+		std::make_shared<TaskLambda>([this, query, expandedNodeIds = getExpandedNodeIds()]() {
+			std::function<bool()> isCancelled = [this, query]() {
+				std::lock_guard<std::mutex> lock(m_graphQueryMutex);
+				return query->generation != m_graphQueryGeneration;
+			};
+
+			std::shared_ptr<Graph> graph;
+			bool isActiveNamespace = false;
+			if (!isCancelled())
+			{
+				graph = m_storageAccess->getGraphForActiveTokenIds(
+					query->tokenIds, expandedNodeIds, &isActiveNamespace, isCancelled);
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(m_graphQueryMutex);
+				query->graph = graph;
+				query->isActiveNamespace = isActiveNamespace;
+				query->finished = true;
+			}
+			m_graphQueryCondition.notify_all();
+
+			if (!isCancelled())
+			{
+				Task::dispatch(getSchedulerId(), std::make_shared<TaskLambda>([this, query]() {
+								   {
+									   std::lock_guard<std::mutex> lock(m_graphQueryMutex);
+									   if (m_graphQuery != query)
+									   {
+										   return;
+									   }
+								   }
+
+								   finishGraphQuery();
+							   }));
+			}
+		}));
+}
+
+void GraphController::finishGraphQuery()
+{
+	std::shared_ptr<GraphQuery> query;
+	{
+		std::unique_lock<std::mutex> lock(m_graphQueryMutex);
+		if (!m_graphQuery)
+		{
+			return;
+		}
+
+		query = m_graphQuery;
+		m_graphQueryCondition.wait(lock, [&query]() { return query->finished; });
+		m_graphQuery.reset();
+
+		if (query->generation != m_graphQueryGeneration)
+		{
+			return;
+		}
+	}
+
+	showGraphForActiveTokenIds(*query);
+}
+
+void GraphController::cancelGraphQuery()
+{
+	std::lock_guard<std::mutex> lock(m_graphQueryMutex);
+	m_graphQueryGeneration++;
+	m_graphQuery.reset();
+}
+
+void GraphController::showGraphForActiveTokenIds(const GraphQuery& query)
+{
+	MessageActivateTokens* message = query.message.get();
+	const std::vector<Id>& tokenIds = query.tokenIds;
+	const bool isNamespace = query.isActiveNamespace;
+
+	createDummyGraphAndSetActiveAndVisibility(tokenIds, query.graph, !message->isFromSearch);
+
+	if (isNamespace)
+	{
+		addCharacterIndex();
+
+		DummyNode* group = groupAllNodes(GroupType::NAMESPACE, tokenIds[0]);
+		group->groupLayout = GroupLayout::LIST;
+
+		if (!group->name.size())
+		{
+			group->name = m_storageAccess->getNameHierarchyForNodeId(tokenIds[0]).getQualifiedName();
+			group->tokenId = tokenIds[0];
+		}
+
+		layoutNesting();
+		layoutList();
+	}
+	else
+	{
+		if (m_activeNodeIds.size() == 1)
+		{
+			bundleNodes();
+		}
+		else if (message->isBundledEdges)
+		{
+			bool isInheritanceChain = true;
+			for (const auto& edge: m_dummyEdges)
+			{
+				if (!edge->data->isType(Edge::EDGE_INHERITANCE))
+				{
+					isInheritanceChain = false;
+					break;
+				}
+			}
+
+			if (isInheritanceChain)
+			{
+				for (auto& node: m_dummyNodes)
+				{
+					node->bundleInfo.layoutVertical = true;
+				}
+			}
+
+			m_useBezierEdges = !isInheritanceChain;
+
+			for (const std::shared_ptr<DummyEdge>& edge: m_dummyEdges)
+			{
+				edge->active = false;
+			}
+		}
+
+		groupNodesByParents(getView()->getGrouping());
+
+		layoutNesting();
+		layoutGraph(true);
+		assignBundleIds();
+	}
+
+	GraphView::GraphParams params;
+	params.centerActiveNode = !isNamespace;
+	params.scrollToTop = isNamespace;
+	buildGraph(message, params);
+}
+
 void GraphController::createDummyGraph(const std::shared_ptr<Graph> graph)
 {
 	TRACE();
@@ -1869,6 +2039,60 @@ void GraphController::layoutNesting()
 	}
 }
 
+void GraphController::layoutNestingOfNode(DummyNode* node)
+{
+	TRACE();
+
+	// Only the subtree of the node and its ancestors are laid out again, all other nodes keep
+	// their sizes from the last layout.
+	std::vector<DummyNode*> path;
+	for (const std::shared_ptr<DummyNode>& topLevelNode: m_dummyNodes)
+	{
+		if (addDummyNodePath(topLevelNode.get(), node, &path))
+		{
+			break;
+		}
+	}
+
+	if (!path.size())
+	{
+		layoutNesting();
+		return;
+	}
+
+	// access nodes next to the path are laid out again to get their widths, but their sub nodes
+	// stay unchanged. Expand toggle nodes are recreated while laying out their parent, so they
+	// are never kept.
+	std::set<const DummyNode*> unchangedNodes;
+	for (size_t i = 0; i + 1 < path.size(); i++)
+	{
+		for (const std::shared_ptr<DummyNode>& subNode: path[i]->subNodes)
+		{
+			if (subNode.get() == path[i + 1] || subNode->isExpandToggleNode())
+			{
+				continue;
+			}
+
+			if (subNode->isAccessNode())
+			{
+				for (const std::shared_ptr<DummyNode>& subSubNode: subNode->subNodes)
+				{
+					unchangedNodes.insert(subSubNode.get());
+				}
+			}
+			else
+			{
+				unchangedNodes.insert(subNode.get());
+			}
+		}
+	}
+
+	extendEqualFunctionNames(node->subNodes);
+
+	layoutNestingRecursive(path[0], -1, &unchangedNodes);
+	layoutToGrid(path[0]);
+}
+
 void GraphController::extendEqualFunctionNames(const std::vector<std::shared_ptr<DummyNode>>& nodes) const
 {
 	std::multimap<std::wstring, std::shared_ptr<DummyNode>> functionNames;
@@ -1904,12 +2128,19 @@ void GraphController::extendEqualFunctionNames(const std::vector<std::shared_ptr
 	}
 }
 
-Vec4i GraphController::layoutNestingRecursive(DummyNode* node, int relayoutAccessMaxWidth) const
+Vec4i GraphController::layoutNestingRecursive(
+	DummyNode* node,
+	int relayoutAccessMaxWidth,
+	const std::set<const DummyNode*>* unchangedNodes) const
 {
 	if (!node->visible)
 	{
 		return Vec4i(0, 0, 0, 0);
 	}
+	else if (unchangedNodes && unchangedNodes->find(node) != unchangedNodes->end())
+	{
+		return ListLayouter::boundingRect(node->subNodes);
+	}
 
 	GraphViewStyle::NodeMargins margins;
 
@@ -1994,7 +2225,7 @@ Vec4i GraphController::layoutNestingRecursive(DummyNode* node, int relayoutAcces
 				continue;
 			}
 
-			Vec4i rect = layoutNestingRecursive(subNode.get());
+			Vec4i rect = layoutNestingRecursive(subNode.get(), -1, unchangedNodes);
 
 			if (subNode->isExpandToggleNode())
 			{
@@ -2013,7 +2244,7 @@ Vec4i GraphController::layoutNestingRecursive(DummyNode* node, int relayoutAcces
 			{
 				if (subNode->visible && subNode->isAccessNode() && subNode != maxWidthAccessNode)
 				{
-					layoutNestingRecursive(subNode.get(), maxAccessWidth);
+					layoutNestingRecursive(subNode.get(), maxAccessWidth, unchangedNodes);
 				}
 			}
 		}
@@ -1,7 +1,10 @@
 #ifndef GRAPH_CONTROLLER_H
 #define GRAPH_CONTROLLER_H
 
+#include <condition_variable>
 #include <list>
+#include <mutex>
+#include <set>
 #include <vector>
 
 #include "MessageActivateErrors.h"
@@ -56,11 +59,21 @@ class GraphController
 {
 public:
 	GraphController(StorageAccess* storageAccess);
-	~GraphController() = default;
+	~GraphController();
 
 	Id getSchedulerId() const override;
 
 private:
+	struct GraphQuery
+	{
+		size_t generation = 0;
+		std::shared_ptr<MessageActivateTokens> message;
+		std::vector<Id> tokenIds;
+		std::shared_ptr<Graph> graph;
+		bool isActiveNamespace = false;
+		bool finished = false;
+	};
+
 	void handleMessage(MessageActivateErrors* message) override;
 	void handleMessage(MessageActivateFullTextSearch* message) override;
 	void handleMessage(MessageActivateLegend* message) override;
@@ -84,6 +97,11 @@ private:
 
 	void clear() override;
 
+	void startGraphQuery(MessageActivateTokens* message, const std::vector<Id>& tokenIds);
+	void finishGraphQuery();
+	void cancelGraphQuery();
+	void showGraphForActiveTokenIds(const GraphQuery& query);
+
 	void createDummyGraph(const std::shared_ptr<Graph> graph);
 	void createDummyGraphAndSetActiveAndVisibility(
 		const std::vector<Id>& tokenIds,
@@ -131,8 +149,12 @@ private:
 	void groupTrailNodes(GroupType groupType);
 
 	void layoutNesting();
+	void layoutNestingOfNode(DummyNode* node);
 	void extendEqualFunctionNames(const std::vector<std::shared_ptr<DummyNode>>& nodes) const;
-	Vec4i layoutNestingRecursive(DummyNode* node, int relayoutAccessMaxWidth = -1) const;
+	Vec4i layoutNestingRecursive(
+		DummyNode* node,
+		int relayoutAccessMaxWidth = -1,
+		const std::set<const DummyNode*>* unchangedNodes = nullptr) const;
 	void addExpandToggleNode(DummyNode* node) const;
 	void layoutToGrid(DummyNode* node) const;
 
@@ -174,6 +196,19 @@ private:
 	bool m_useBezierEdges = false;
 	bool m_showsLegend = false;
 	Id m_tokenIdToFocus = 0;
+
+	// graphs of activated tokens are queried on a separate scheduler of this tab, so that a newer
+	// activation can cancel the running query instead of waiting for it. Each cancellation
+	// increases the generation, which the running query compares against its own in between its
+	// steps.
+	const Id m_querySchedulerId;
+	std::shared_ptr<GraphQuery> m_graphQuery;
+	size_t m_graphQueryGeneration = 0;
+	std::mutex m_graphQueryMutex;
+	std::condition_variable m_graphQueryCondition;
+
+	// lays out dummy nodes without view and storage in GraphControllerTestSuite
+	friend class GraphControllerTestAccess;
 };
 
 #endif	  // GRAPH_CONTROLLER_H
@@ -1,7 +1,21 @@
 #include "TrailLayouter.h"
 
+#include <algorithm>
 #include <iostream>
 
+namespace
+{
+template <typename T>
+void eraseElement(std::vector<T>& elements, const T& element)
+{
+	auto it = std::find(elements.begin(), elements.end(), element);
+	if (it != elements.end())
+	{
+		elements.erase(it);
+	}
+}
+}	 // namespace
+
 TrailLayouter::TrailLayouter(LayoutDirection dir): m_direction(dir), m_rootNode(nullptr) {}
 
 void TrailLayouter::layoutGraph(
@@ -17,7 +31,8 @@ void TrailLayouter::layoutGraph(
 	}
 
 	removeDeadEnds();
-	makeAcyclicRecursive(m_rootNode, std::set<TrailNode*>());
+	makeAcyclic();
+	sortNodesTopologically();
 
 	assignLongestPathLevels();
 	assignRemainingLevels();
@@ -59,7 +74,8 @@ void TrailLayouter::buildGraph(
 
 void TrailLayouter::removeDeadEnds()
 {
-	std::set<TrailNode*> predecessors;
+	std::vector<bool> predecessors(m_allNodes.size(), false);
+	size_t predecessorCount = 0;
 
 	std::set<TrailNode*> deadEnds;
 	std::set<TrailNode*> loseEnds;
@@ -72,13 +88,14 @@ void TrailLayouter::removeDeadEnds()
 		TrailNode* node = nodes.front();
 		nodes.pop_front();
 
-		if (predecessors.find(node) == predecessors.end())
+		if (!predecessors[node->index])
 		{
-			predecessors.insert(node);
+			predecessors[node->index] = true;
+			predecessorCount++;
 
 			for (TrailEdge* edge: node->outgoingEdges)
 			{
-				if (predecessors.find(edge->target) == predecessors.end())
+				if (!predecessors[edge->target->index])
 				{
 					nodes.push_back(edge->target);
 				}
@@ -86,7 +103,7 @@ void TrailLayouter::removeDeadEnds()
 
 			for (TrailEdge* edge: node->incomingEdges)
 			{
-				if (predecessors.find(edge->origin) == predecessors.end())
+				if (!predecessors[edge->origin->index])
 				{
 					loseEnds.insert(edge->origin);
 				}
@@ -99,7 +116,7 @@ void TrailLayouter::removeDeadEnds()
 		}
 
 		while (!nodes.size() && (deadEnds.size() || loseEnds.size()) &&
-			   predecessors.size() < m_allNodes.size())
+			   predecessorCount < m_allNodes.size())
 		{
 			if (deadEnds.size())
 			{
@@ -108,7 +125,7 @@ void TrailLayouter::removeDeadEnds()
 
 				for (TrailEdge* edge: deadEnd->incomingEdges)
 				{
-					if (predecessors.find(edge->origin) == predecessors.end())
+					if (!predecessors[edge->origin->index])
 					{
 						nodes.push_back(edge->origin);
 						switchEdge(edge);
@@ -121,11 +138,11 @@ void TrailLayouter::removeDeadEnds()
 				TrailNode* loseEnd = *loseEnds.begin();
 				loseEnds.erase(loseEnds.begin());
 
-				if (predecessors.find(loseEnd) == predecessors.end())
+				if (!predecessors[loseEnd->index])
 				{
 					for (TrailEdge* edge: loseEnd->outgoingEdges)
 					{
-						if (predecessors.find(edge->target) != predecessors.end())
+						if (predecessors[edge->target->index])
 						{
 							nodes.push_back(loseEnd);
 							switchEdge(edge);
@@ -138,131 +155,160 @@ void TrailLayouter::removeDeadEnds()
 	}
 }
 
-void TrailLayouter::makeAcyclicRecursive(TrailNode* node, std::set<TrailNode*> predecessors)
+void TrailLayouter::makeAcyclic()
 {
-	predecessors.insert(node);
+	// depth first search from the root node, which runs on an explicit stack to handle deep
+	// trails. An edge pointing back to a node on the current path closes a cycle and gets switched
+	// once all edges of its origin are processed.
+	enum NodeState
+	{
+		NODE_UNVISITED,
+		NODE_ON_PATH,
+		NODE_DONE
+	};
+
+	std::vector<NodeState> states(m_allNodes.size(), NODE_UNVISITED);
+	std::vector<std::pair<TrailNode*, size_t>> path;
 
-	std::set<TrailEdge*> edgesToSwitch;
-	for (TrailEdge* edge: node->outgoingEdges)
+	states[m_rootNode->index] = NODE_ON_PATH;
+	path.emplace_back(m_rootNode, 0);
+
+	while (path.size())
 	{
-		if (predecessors.find(edge->target) != predecessors.end())
+		TrailNode* node = path.back().first;
+		const size_t edgeIndex = path.back().second;
+
+		if (edgeIndex < node->outgoingEdges.size())
 		{
-			edgesToSwitch.insert(edge);
+			path.back().second++;
+
+			TrailNode* target = node->outgoingEdges[edgeIndex]->target;
+			if (states[target->index] == NODE_UNVISITED)
+			{
+				states[target->index] = NODE_ON_PATH;
+				path.emplace_back(target, 0);
+			}
+			continue;
 		}
-		else
+
+		std::vector<TrailEdge*> edgesToSwitch;
+		for (TrailEdge* edge: node->outgoingEdges)
 		{
-			makeAcyclicRecursive(edge->target, predecessors);
+			if (states[edge->target->index] == NODE_ON_PATH)
+			{
+				edgesToSwitch.push_back(edge);
+			}
 		}
-	}
 
-	for (TrailEdge* edge: edgesToSwitch)
-	{
-		switchEdge(edge);
+		for (TrailEdge* edge: edgesToSwitch)
+		{
+			switchEdge(edge);
+		}
+
+		states[node->index] = NODE_DONE;
+		path.pop_back();
 	}
 }
 
-void TrailLayouter::assignLongestPathLevels()
+void TrailLayouter::sortNodesTopologically()
 {
-	std::set<TrailNode*> nodes;
-	nodes.insert(m_rootNode);
+	std::vector<TrailNode*> reachedNodes;
+	std::vector<bool> reached(m_allNodes.size(), false);
 
-	std::map<TrailNode*, TrailNode*> predecessorNodes;
+	reached[m_rootNode->index] = true;
+	reachedNodes.push_back(m_rootNode);
 
-	int level = 0;
-
-	while (nodes.size())
+	for (size_t i = 0; i < reachedNodes.size(); i++)
 	{
-		std::set<TrailNode*> newNodes;
-
-		for (TrailNode* node: nodes)
+		for (TrailEdge* edge: reachedNodes[i]->outgoingEdges)
 		{
-			for (TrailEdge* edge: node->outgoingEdges)
+			if (!reached[edge->target->index])
 			{
-				newNodes.insert(edge->target);
-				predecessorNodes[edge->target] = node;
+				reached[edge->target->index] = true;
+				reachedNodes.push_back(edge->target);
 			}
 		}
+	}
 
-		if (!newNodes.size())
+	std::vector<size_t> incomingCounts(m_allNodes.size(), 0);
+	for (TrailNode* node: reachedNodes)
+	{
+		for (TrailEdge* edge: node->outgoingEdges)
 		{
-			break;
+			incomingCounts[edge->target->index]++;
 		}
-
-		nodes = newNodes;
-		level++;
 	}
 
-	while (nodes.size())
-	{
-		std::set<TrailNode*> newNodes;
+	m_sortedNodes.clear();
+	m_sortedNodes.push_back(m_rootNode);
 
-		for (TrailNode* node: nodes)
+	for (size_t i = 0; i < m_sortedNodes.size(); i++)
+	{
+		for (TrailEdge* edge: m_sortedNodes[i]->outgoingEdges)
 		{
-			node->level = level;
-
-			if (level > 0)
+			if (--incomingCounts[edge->target->index] == 0)
 			{
-				newNodes.insert(predecessorNodes[node]);
+				m_sortedNodes.push_back(edge->target);
 			}
 		}
-
-		nodes = newNodes;
-		level--;
 	}
 }
 
-void TrailLayouter::assignRemainingLevels()
+void TrailLayouter::assignLongestPathLevels()
 {
-	std::multimap<int, TrailNode*> nodes;
-	nodes.emplace(m_rootNode->level, m_rootNode);
+	std::vector<int> distances(m_allNodes.size(), -1);
+	std::vector<TrailNode*> predecessorNodes(m_allNodes.size(), nullptr);
 
-	std::set<TrailNode*> allNodes;
-	allNodes.insert(m_rootNode);
+	distances[m_rootNode->index] = 0;
+	int maxDistance = 0;
 
-	while (nodes.size())
+	for (TrailNode* node: m_sortedNodes)
 	{
-		std::multimap<int, TrailNode*> newNodes;
+		const int distance = distances[node->index];
+		maxDistance = std::max(maxDistance, distance);
 
-		for (std::pair<int, TrailNode*> p: nodes)
+		for (TrailEdge* edge: node->outgoingEdges)
 		{
-			TrailNode* node = p.second;
-
-			for (TrailEdge* edge: node->outgoingEdges)
+			if (distances[edge->target->index] < distance + 1)
 			{
-				if (allNodes.insert(edge->target).second)
-				{
-					newNodes.emplace(edge->target->level, edge->target);
-				}
+				distances[edge->target->index] = distance + 1;
+				predecessorNodes[edge->target->index] = node;
 			}
+		}
+	}
 
-			if (node->level < 0)
+	// only nodes on the longest paths get their level here
+	for (TrailNode* node: m_sortedNodes)
+	{
+		if (distances[node->index] == maxDistance)
+		{
+			for (TrailNode* n = node; n && n->level < 0; n = predecessorNodes[n->index])
 			{
-				int level = -1;
-
-				for (TrailEdge* edge: node->incomingEdges)
-				{
-					if (edge->origin->level == -1)
-					{
-						if (allNodes.insert(edge->origin).second)
-						{
-							newNodes.emplace(edge->origin->level, edge->origin);
-						}
+				n->level = distances[n->index];
+			}
+		}
+	}
+}
 
-						level = node->level;
-						newNodes.emplace(level, node);
-						break;
-					}
-					else
-					{
-						level = std::max(level, edge->origin->level + 1);
-					}
-				}
+void TrailLayouter::assignRemainingLevels()
+{
+	for (TrailNode* node: m_sortedNodes)
+	{
+		if (node->level >= 0)
+		{
+			continue;
+		}
 
-				node->level = level;
+		int level = -1;
+		for (TrailEdge* edge: node->incomingEdges)
+		{
+			if (edge->origin->level >= 0)
+			{
+				level = std::max(level, edge->origin->level + 1);
 			}
 		}
 
-		nodes = newNodes;
+		node->level = level;
 	}
 }
 
@@ -279,6 +325,7 @@ void TrailLayouter::addVirtualNodes()
 			virtualNode->name = L"<virtual>";
 			virtualNode->dummyNode = nullptr;
 			virtualNode->level = i;
+			virtualNode->index = m_allNodes.size();
 
 			virtualNode->size = Vec2i(50, 20);
 
@@ -290,12 +337,15 @@ void TrailLayouter::addVirtualNodes()
 			virtualEdge->id = 0;
 
 			virtualEdge->origin = edge->origin;
-			virtualEdge->origin->outgoingEdges.erase(edge.get());
-			virtualEdge->origin->outgoingEdges.insert(virtualEdge.get());
+			std::replace(
+				virtualEdge->origin->outgoingEdges.begin(),
+				virtualEdge->origin->outgoingEdges.end(),
+				edge.get(),
+				virtualEdge.get());
 
 			virtualEdge->target = virtualNode.get();
-			virtualEdge->target->incomingEdges.insert(virtualEdge.get());
-			virtualEdge->target->outgoingEdges.insert(edge.get());
+			virtualEdge->target->incomingEdges.push_back(virtualEdge.get());
+			virtualEdge->target->outgoingEdges.push_back(edge.get());
 
 			edge->origin = virtualNode.get();
 			newEdges.push_back(virtualEdge);
@@ -315,71 +365,178 @@ void TrailLayouter::buildColumns()
 			m_nodesPerCol.push_back(std::vector<TrailNode*>());
 		}
 
+		node->columnIndex = m_nodesPerCol[level].size();
 		m_nodesPerCol[level].push_back(node.get());
 	}
 }
 
 void TrailLayouter::reduceEdgeCrossings()
 {
+	// first sweep orders each column by its predecessors, or by its successors if all
+	// predecessors are in a single node
 	for (size_t i = 1; i < m_nodesPerCol.size(); i++)
 	{
-		std::vector<TrailNode*> nodes = m_nodesPerCol[i];
-
-		bool usePredecessors = true;
-		std::vector<TrailNode*> neighbors = m_nodesPerCol[i - 1];
-		if (neighbors.size() == 1 && i + 1 < m_nodesPerCol.size() && m_nodesPerCol[i + 1].size() > 0)
+		if (m_nodesPerCol[i - 1].size() == 1 && i + 1 < m_nodesPerCol.size() &&
+			m_nodesPerCol[i + 1].size() > 0)
 		{
-			neighbors = m_nodesPerCol[i + 1];
-			usePredecessors = false;
+			orderColumnByBarycenters(i, i + 1);
 		}
-
-		std::map<TrailNode*, size_t> neighborIndices;
-		for (size_t j = 0; j < neighbors.size(); j++)
+		else
 		{
-			neighborIndices.emplace(neighbors[j], j);
+			orderColumnByBarycenters(i, i - 1);
 		}
+	}
 
-		std::multimap<float, TrailNode*> newOrder;
+	// further sweeps alternate in direction and are kept as long as they remove crossings
+	size_t crossingCount = countEdgeCrossings();
+	for (size_t sweep = 0; sweep < 8 && crossingCount > 0; sweep++)
+	{
+		std::vector<std::vector<TrailNode*>> previousNodesPerCol = m_nodesPerCol;
 
-		for (size_t j = 0; j < nodes.size(); j++)
+		if (sweep % 2 == 0)
 		{
-			TrailNode* node = nodes[j];
-
-			size_t sum = 0;
-			size_t count = 0;
+			for (size_t i = m_nodesPerCol.size() - 1; i > 1; i--)
+			{
+				orderColumnByBarycenters(i - 1, i);
+			}
+		}
+		else
+		{
+			for (size_t i = 2; i < m_nodesPerCol.size(); i++)
+			{
+				orderColumnByBarycenters(i, i - 1);
+			}
+		}
 
-			if (usePredecessors)
+		const size_t newCrossingCount = countEdgeCrossings();
+		if (newCrossingCount >= crossingCount)
+		{
+			m_nodesPerCol = previousNodesPerCol;
+			for (std::vector<TrailNode*>& nodes: m_nodesPerCol)
 			{
-				for (TrailEdge* edge: node->incomingEdges)
+				for (size_t j = 0; j < nodes.size(); j++)
 				{
-					sum += neighborIndices[edge->origin];
-					count++;
+					nodes[j]->columnIndex = j;
 				}
 			}
-			else
+			break;
+		}
+
+		crossingCount = newCrossingCount;
+	}
+}
+
+void TrailLayouter::orderColumnByBarycenters(size_t col, size_t neighborCol)
+{
+	std::vector<TrailNode*>& nodes = m_nodesPerCol[col];
+
+	std::vector<std::pair<float, TrailNode*>> newOrder;
+	newOrder.reserve(nodes.size());
+
+	for (size_t j = 0; j < nodes.size(); j++)
+	{
+		TrailNode* node = nodes[j];
+
+		size_t sum = 0;
+		size_t count = 0;
+
+		for (TrailEdge* edge: node->incomingEdges)
+		{
+			if (isInColumn(edge->origin, neighborCol))
 			{
-				for (TrailEdge* edge: node->outgoingEdges)
-				{
-					sum += neighborIndices[edge->target];
-					count++;
-				}
+				sum += edge->origin->columnIndex;
+				count++;
+			}
+		}
+
+		for (TrailEdge* edge: node->outgoingEdges)
+		{
+			if (isInColumn(edge->target, neighborCol))
+			{
+				sum += edge->target->columnIndex;
+				count++;
+			}
+		}
+
+		float value = float(j);
+		if (count)
+		{
+			value = float(sum) / count;
+		}
+		newOrder.emplace_back(value, node);
+	}
+
+	std::stable_sort(
+		newOrder.begin(),
+		newOrder.end(),
+		[](const std::pair<float, TrailNode*>& a, const std::pair<float, TrailNode*>& b) {
+			return a.first < b.first;
+		});
+
+	for (size_t j = 0; j < newOrder.size(); j++)
+	{
+		nodes[j] = newOrder[j].second;
+		nodes[j]->columnIndex = j;
+	}
+}
+
+size_t TrailLayouter::countEdgeCrossings() const
+{
+	size_t crossingCount = 0;
+	for (size_t i = 1; i + 1 < m_nodesPerCol.size(); i++)
+	{
+		crossingCount += countEdgeCrossings(i);
+	}
+	return crossingCount;
+}
+
+size_t TrailLayouter::countEdgeCrossings(size_t col) const
+{
+	// counts crossings between a column and the next one in O(E log V): with the edges sorted by
+	// their position in this column, every pair of edges that is inverted in the next column
+	// crosses. The inversions are counted with a binary indexed tree over the next column.
+	std::vector<std::pair<size_t, size_t>> edgePositions;
+	for (TrailNode* node: m_nodesPerCol[col])
+	{
+		for (TrailEdge* edge: node->outgoingEdges)
+		{
+			if (isInColumn(edge->target, col + 1))
+			{
+				edgePositions.emplace_back(node->columnIndex, edge->target->columnIndex);
 			}
+		}
 
-			float value = float(j);
-			if (count)
+		for (TrailEdge* edge: node->incomingEdges)
+		{
+			if (isInColumn(edge->origin, col + 1))
 			{
-				value = float(sum) / count;
+				edgePositions.emplace_back(node->columnIndex, edge->origin->columnIndex);
 			}
-			newOrder.emplace(value, node);
 		}
+	}
+
+	std::sort(edgePositions.begin(), edgePositions.end());
+
+	std::vector<size_t> tree(m_nodesPerCol[col + 1].size() + 1, 0);
+	size_t crossingCount = 0;
+
+	for (size_t i = 0; i < edgePositions.size(); i++)
+	{
+		size_t notCrossingCount = 0;
+		for (size_t j = edgePositions[i].second + 1; j > 0; j -= j & (~j + 1))
+		{
+			notCrossingCount += tree[j];
+		}
+
+		crossingCount += i - notCrossingCount;
 
-		nodes.clear();
-		for (std::pair<float, TrailNode*> p: newOrder)
+		for (size_t j = edgePositions[i].second + 1; j < tree.size(); j += j & (~j + 1))
 		{
-			nodes.push_back(p.second);
+			tree[j]++;
 		}
-		m_nodesPerCol[i] = nodes;
 	}
+
+	return crossingCount;
 }
 
 void TrailLayouter::layout()
@@ -465,7 +622,7 @@ void TrailLayouter::layout()
 	// put into grid
 }
 
-void TrailLayouter::moveNodesToAveragePosition(std::vector<TrailNode*> nodes, bool forward)
+void TrailLayouter::moveNodesToAveragePosition(const std::vector<TrailNode*>& nodes, bool forward)
 {
 	unsigned int yIdx = horizontalLayout() ? 1 : 0;
 
@@ -657,6 +814,8 @@ void TrailLayouter::addNode(const std::shared_ptr<DummyNode>& dummyNode)
 	node->name = dummyNode->name;
 	node->dummyNode = dummyNode.get();
 	node->level = -1;
+	node->index = m_allNodes.size();
+	node->columnIndex = 0;
 
 	node->size = dummyNode->size;
 
@@ -703,35 +862,41 @@ void TrailLayouter::addEdge(
 	edge->origin = origin->second;
 	edge->target = target->second;
 
-	for (std::shared_ptr<TrailEdge>& e: m_allEdges)
+	// edges between the same nodes in either direction are merged
+	auto it = m_edgesByNodes.emplace(
+		std::make_pair(
+			std::min(edge->origin, edge->target), std::max(edge->origin, edge->target)),
+		edge.get());
+	if (!it.second)
 	{
-		if ((e->origin == edge->origin && e->target == edge->target) ||
-			(e->origin == edge->target && e->target == edge->origin))
-		{
-			e->dummyEdges.push_back(dummyEdge.get());
-			return;
-		}
+		it.first->second->dummyEdges.push_back(dummyEdge.get());
+		return;
 	}
 
 	edge->dummyEdges.push_back(dummyEdge.get());
 
-	edge->origin->outgoingEdges.insert(edge.get());
-	edge->target->incomingEdges.insert(edge.get());
+	edge->origin->outgoingEdges.push_back(edge.get());
+	edge->target->incomingEdges.push_back(edge.get());
 
 	m_allEdges.push_back(edge);
 }
 
 void TrailLayouter::switchEdge(TrailEdge* edge)
 {
-	edge->origin->outgoingEdges.erase(edge);
-	edge->origin->incomingEdges.insert(edge);
+	eraseElement(edge->origin->outgoingEdges, edge);
+	edge->origin->incomingEdges.push_back(edge);
 
-	edge->target->incomingEdges.erase(edge);
-	edge->target->outgoingEdges.insert(edge);
+	eraseElement(edge->target->incomingEdges, edge);
+	edge->target->outgoingEdges.push_back(edge);
 
 	std::swap(edge->origin, edge->target);
 }
 
+bool TrailLayouter::isInColumn(const TrailNode* node, size_t col) const
+{
+	return node->level + 1 == static_cast<int>(col);
+}
+
 bool TrailLayouter::horizontalLayout() const
 {
 	return m_direction == LAYOUT_LEFT_RIGHT || m_direction == LAYOUT_RIGHT_LEFT;
@@ -40,10 +40,13 @@ private:
 		Vec2i pos;
 		Vec2i size;
 
-		std::set<TrailEdge*> incomingEdges;
-		std::set<TrailEdge*> outgoingEdges;
+		std::vector<TrailEdge*> incomingEdges;
+		std::vector<TrailEdge*> outgoingEdges;
 
 		DummyNode* dummyNode;
+
+		size_t index;	   // position in m_allNodes
+		size_t columnIndex;	   // position in its column of m_nodesPerCol
 	};
 
 	struct TrailEdge
@@ -63,7 +66,8 @@ private:
 		const std::map<Id, Id>& topLevelAncestorIds);
 
 	void removeDeadEnds();
-	void makeAcyclicRecursive(TrailNode* node, std::set<TrailNode*> predecessors);
+	void makeAcyclic();
+	void sortNodesTopologically();
 
 	void assignLongestPathLevels();
 	void assignRemainingLevels();
@@ -71,9 +75,12 @@ private:
 	void addVirtualNodes();
 	void buildColumns();
 	void reduceEdgeCrossings();
+	void orderColumnByBarycenters(size_t col, size_t neighborCol);
+	size_t countEdgeCrossings() const;
+	size_t countEdgeCrossings(size_t col) const;
 
 	void layout();
-	void moveNodesToAveragePosition(std::vector<TrailNode*> nodes, bool forward);
+	void moveNodesToAveragePosition(const std::vector<TrailNode*>& nodes, bool forward);
 	void retrievePositions(const std::map<Id, Id>& topLevelAncestorIds);
 
 	void print();
@@ -82,6 +89,8 @@ private:
 	void addEdge(const std::shared_ptr<DummyEdge> dummyEdge, const std::map<Id, Id>& topLevelAncestorIds);
 	void switchEdge(TrailEdge* edge);
 
+	bool isInColumn(const TrailNode* node, size_t col) const;
+
 	bool horizontalLayout() const;
 	bool invertedLayout() const;
 
@@ -91,8 +100,12 @@ private:
 	std::vector<std::shared_ptr<TrailEdge>> m_allEdges;
 
 	std::map<Id, TrailNode*> m_nodesById;
+	std::map<std::pair<TrailNode*, TrailNode*>, TrailEdge*> m_edgesByNodes;
 	TrailNode* m_rootNode;
 
+	// nodes reachable from the root node, sorted so that edges only point to later nodes
+	std::vector<TrailNode*> m_sortedNodes;
+
 	std::vector<std::vector<TrailNode*>> m_nodesPerCol;
 };
 
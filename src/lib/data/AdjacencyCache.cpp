@@ -0,0 +1,160 @@
+#include "AdjacencyCache.h"
+
+void AdjacencyCache::clear()
+{
+	m_nodeIndices.clear();
+	m_nodeIds.clear();
+	m_nodeKinds.clear();
+
+	m_edgeIds.clear();
+	m_edgeTypes.clear();
+	m_edgeSourceIds.clear();
+	m_edgeTargetIds.clear();
+
+	m_outgoingOffsets.clear();
+	m_outgoing.clear();
+	m_incomingOffsets.clear();
+	m_incoming.clear();
+}
+
+void AdjacencyCache::addNode(Id nodeId, NodeKind kind)
+{
+	if (nodeId >= m_nodeIndices.size())
+	{
+		m_nodeIndices.resize(nodeId + 1, INVALID_INDEX);
+	}
+
+	if (m_nodeIndices[nodeId] == INVALID_INDEX)
+	{
+		m_nodeIndices[nodeId] = static_cast<uint32_t>(m_nodeIds.size());
+		m_nodeIds.push_back(nodeId);
+		m_nodeKinds.push_back(kind);
+	}
+}
+
+void AdjacencyCache::addEdge(Id edgeId, Edge::EdgeType type, Id sourceId, Id targetId)
+{
+	m_edgeIds.push_back(edgeId);
+	m_edgeTypes.push_back(type);
+	m_edgeSourceIds.push_back(sourceId);
+	m_edgeTargetIds.push_back(targetId);
+}
+
+void AdjacencyCache::finishSetup()
+{
+	std::vector<uint32_t> sourceNodes;
+	std::vector<uint32_t> targetNodes;
+	sourceNodes.reserve(m_edgeIds.size());
+	targetNodes.reserve(m_edgeIds.size());
+
+	for (size_t i = 0; i < m_edgeIds.size(); i++)
+	{
+		sourceNodes.push_back(getNodeIndex(m_edgeSourceIds[i]));
+		targetNodes.push_back(getNodeIndex(m_edgeTargetIds[i]));
+	}
+
+	m_edgeSourceIds.clear();
+	m_edgeSourceIds.shrink_to_fit();
+	m_edgeTargetIds.clear();
+	m_edgeTargetIds.shrink_to_fit();
+
+	buildRows(m_nodeIds.size(), sourceNodes, targetNodes, &m_outgoingOffsets, &m_outgoing);
+	buildRows(m_nodeIds.size(), targetNodes, sourceNodes, &m_incomingOffsets, &m_incoming);
+}
+
+size_t AdjacencyCache::getNodeCount() const
+{
+	return m_nodeIds.size();
+}
+
+size_t AdjacencyCache::getEdgeCount() const
+{
+	return m_edgeIds.size();
+}
+
+uint32_t AdjacencyCache::getNodeIndex(Id nodeId) const
+{
+	if (nodeId < m_nodeIndices.size())
+	{
+		return m_nodeIndices[nodeId];
+	}
+	return INVALID_INDEX;
+}
+
+Id AdjacencyCache::getNodeId(uint32_t nodeIndex) const
+{
+	return m_nodeIds[nodeIndex];
+}
+
+NodeKind AdjacencyCache::getNodeKind(uint32_t nodeIndex) const
+{
+	return m_nodeKinds[nodeIndex];
+}
+
+Id AdjacencyCache::getEdgeId(uint32_t edgeIndex) const
+{
+	return m_edgeIds[edgeIndex];
+}
+
+Edge::EdgeType AdjacencyCache::getEdgeType(uint32_t edgeIndex) const
+{
+	return m_edgeTypes[edgeIndex];
+}
+
+AdjacencyCache::NeighborRange AdjacencyCache::getOutgoing(uint32_t nodeIndex) const
+{
+	if (nodeIndex + 1 >= m_outgoingOffsets.size())
+	{
+		return NeighborRange(nullptr, nullptr);
+	}
+
+	const Neighbor* data = m_outgoing.data();
+	return NeighborRange(
+		data + m_outgoingOffsets[nodeIndex], data + m_outgoingOffsets[nodeIndex + 1]);
+}
+
+AdjacencyCache::NeighborRange AdjacencyCache::getIncoming(uint32_t nodeIndex) const
+{
+	if (nodeIndex + 1 >= m_incomingOffsets.size())
+	{
+		return NeighborRange(nullptr, nullptr);
+	}
+
+	const Neighbor* data = m_incoming.data();
+	return NeighborRange(
+		data + m_incomingOffsets[nodeIndex], data + m_incomingOffsets[nodeIndex + 1]);
+}
+
+void AdjacencyCache::buildRows(
+	size_t nodeCount,
+	const std::vector<uint32_t>& fromNodes,
+	const std::vector<uint32_t>& toNodes,
+	std::vector<uint32_t>* offsets,
+	std::vector<Neighbor>* neighbors)
+{
+	// counting sort of the edges by their first node, keeping the order of the edges per row
+	offsets->assign(nodeCount + 1, 0);
+	for (size_t i = 0; i < fromNodes.size(); i++)
+	{
+		if (fromNodes[i] != INVALID_INDEX && toNodes[i] != INVALID_INDEX)
+		{
+			(*offsets)[fromNodes[i] + 1]++;
+		}
+	}
+
+	for (size_t i = 0; i < nodeCount; i++)
+	{
+		(*offsets)[i + 1] += (*offsets)[i];
+	}
+
+	std::vector<uint32_t> positions(offsets->begin(), offsets->end() - 1);
+	neighbors->resize(offsets->back());
+
+	for (size_t i = 0; i < fromNodes.size(); i++)
+	{
+		if (fromNodes[i] != INVALID_INDEX && toNodes[i] != INVALID_INDEX)
+		{
+			(*neighbors)[positions[fromNodes[i]]++] = {toNodes[i], static_cast<uint32_t>(i)};
+		}
+	}
+}
@@ -0,0 +1,87 @@
+#ifndef ADJACENCY_CACHE_H
+#define ADJACENCY_CACHE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Edge.h"
+#include "NodeKind.h"
+#include "types.h"
+
+// Compressed sparse row adjacency of all edges in the index. Each node gets a dense index and the
+// outgoing and incoming edges of a node are stored consecutively, so traversals run in memory.
+class AdjacencyCache
+{
+public:
+	static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+	struct Neighbor
+	{
+		uint32_t nodeIndex;
+		uint32_t edgeIndex;
+	};
+
+	class NeighborRange
+	{
+	public:
+		NeighborRange(const Neighbor* begin, const Neighbor* end): m_begin(begin), m_end(end) {}
+
+		const Neighbor* begin() const
+		{
+			return m_begin;
+		}
+
+		const Neighbor* end() const
+		{
+			return m_end;
+		}
+
+	private:
+		const Neighbor* m_begin;
+		const Neighbor* m_end;
+	};
+
+	void clear();
+
+	// nodes and edges can be added in any order, edges with unknown nodes are ignored
+	void addNode(Id nodeId, NodeKind kind);
+	void addEdge(Id edgeId, Edge::EdgeType type, Id sourceId, Id targetId);
+	void finishSetup();
+
+	size_t getNodeCount() const;
+	size_t getEdgeCount() const;
+
+	uint32_t getNodeIndex(Id nodeId) const;
+	Id getNodeId(uint32_t nodeIndex) const;
+	NodeKind getNodeKind(uint32_t nodeIndex) const;
+
+	Id getEdgeId(uint32_t edgeIndex) const;
+	Edge::EdgeType getEdgeType(uint32_t edgeIndex) const;
+
+	NeighborRange getOutgoing(uint32_t nodeIndex) const;
+	NeighborRange getIncoming(uint32_t nodeIndex) const;
+
+private:
+	static void buildRows(
+		size_t nodeCount,
+		const std::vector<uint32_t>& fromNodes,
+		const std::vector<uint32_t>& toNodes,
+		std::vector<uint32_t>* offsets,
+		std::vector<Neighbor>* neighbors);
+
+	std::vector<uint32_t> m_nodeIndices;	// indexed by node id
+	std::vector<Id> m_nodeIds;
+	std::vector<NodeKind> m_nodeKinds;
+
+	std::vector<Id> m_edgeIds;
+	std::vector<Edge::EdgeType> m_edgeTypes;
+	std::vector<Id> m_edgeSourceIds;
+	std::vector<Id> m_edgeTargetIds;
+
+	std::vector<uint32_t> m_outgoingOffsets;
+	std::vector<Neighbor> m_outgoing;
+	std::vector<uint32_t> m_incomingOffsets;
+	std::vector<Neighbor> m_incoming;
+};
+
+#endif	  // ADJACENCY_CACHE_H
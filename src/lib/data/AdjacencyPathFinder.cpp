@@ -0,0 +1,336 @@
+#include "AdjacencyPathFinder.h"
+
+#include <algorithm>
+#include <set>
+
+AdjacencyPathFinder::AdjacencyPathFinder(
+	const AdjacencyCache& cache,
+	Edge::TypeMask edgeTypes,
+	bool directed,
+	std::function<bool(uint32_t)> isNodeAccepted)
+	: m_cache(cache), m_edgeTypes(edgeTypes), m_directed(directed), m_isNodeAccepted(isNodeAccepted)
+{
+}
+
+bool AdjacencyPathFinder::findAllShortestPaths(
+	uint32_t originIndex,
+	uint32_t targetIndex,
+	size_t maxLength,
+	std::vector<uint32_t>* nodeIndices,
+	std::vector<uint32_t>* edgeIndices) const
+{
+	Steps forwardSteps;
+	Steps backwardSteps;
+	std::vector<uint32_t> meetingNodes;
+	if (!search(
+			originIndex,
+			targetIndex,
+			maxLength,
+			{},
+			{},
+			&forwardSteps,
+			&backwardSteps,
+			&meetingNodes))
+	{
+		return false;
+	}
+
+	std::unordered_set<uint32_t> nodes;
+	std::unordered_set<uint32_t> edges;
+
+	// every shortest path passes a meeting node, from there the distances of both searches lead
+	// back to the origin and on to the target
+	for (const bool forward: {true, false})
+	{
+		const Steps& steps = forward ? forwardSteps : backwardSteps;
+
+		std::unordered_set<uint32_t> visitedNodes;
+		std::vector<uint32_t> nodesToProcess = meetingNodes;
+		while (nodesToProcess.size())
+		{
+			const uint32_t nodeIndex = nodesToProcess.back();
+			nodesToProcess.pop_back();
+
+			if (!visitedNodes.insert(nodeIndex).second)
+			{
+				continue;
+			}
+
+			nodes.insert(nodeIndex);
+
+			const uint32_t distance = steps.find(nodeIndex)->second.distance;
+			if (distance == 0)
+			{
+				continue;
+			}
+
+			forEachStep(nodeIndex, !forward, [&](uint32_t nextIndex, uint32_t edgeIndex) {
+				auto it = steps.find(nextIndex);
+				if (it != steps.end() && it->second.distance + 1 == distance)
+				{
+					edges.insert(edgeIndex);
+					nodesToProcess.push_back(nextIndex);
+				}
+			});
+		}
+	}
+
+	nodeIndices->assign(nodes.begin(), nodes.end());
+	edgeIndices->assign(edges.begin(), edges.end());
+	std::sort(nodeIndices->begin(), nodeIndices->end());
+	std::sort(edgeIndices->begin(), edgeIndices->end());
+	return true;
+}
+
+std::vector<AdjacencyPathFinder::Path> AdjacencyPathFinder::findShortestPaths(
+	uint32_t originIndex, uint32_t targetIndex, size_t maxLength, size_t pathCount) const
+{
+	std::vector<Path> paths;
+
+	Path shortestPath;
+	if (!pathCount || !findShortestPath(originIndex, targetIndex, maxLength, {}, {}, &shortestPath))
+	{
+		return paths;
+	}
+
+	paths.push_back(shortestPath);
+
+	std::vector<Path> candidates;
+	std::set<std::vector<uint32_t>> knownEdgeSequences = {shortestPath.edgeIndices};
+
+	while (paths.size() < pathCount)
+	{
+		const Path previousPath = paths.back();
+
+		// deviate from the previous path at each of its nodes, avoiding the edges all known paths
+		// with the same root take from there and the nodes of the root itself
+		for (size_t i = 0; i < previousPath.edgeIndices.size(); i++)
+		{
+			if (maxLength && i >= maxLength)
+			{
+				break;
+			}
+
+			std::unordered_set<uint32_t> blockedEdges;
+			for (const Path& path: paths)
+			{
+				if (path.edgeIndices.size() > i &&
+					std::equal(
+						previousPath.edgeIndices.begin(),
+						previousPath.edgeIndices.begin() + i,
+						path.edgeIndices.begin()))
+				{
+					blockedEdges.insert(path.edgeIndices[i]);
+				}
+			}
+
+			const std::unordered_set<uint32_t> blockedNodes(
+				previousPath.nodeIndices.begin(), previousPath.nodeIndices.begin() + i);
+
+			Path spurPath;
+			if (findShortestPath(
+					previousPath.nodeIndices[i],
+					targetIndex,
+					maxLength ? maxLength - i : 0,
+					blockedNodes,
+					blockedEdges,
+					&spurPath))
+			{
+				Path path;
+				path.nodeIndices.assign(
+					previousPath.nodeIndices.begin(), previousPath.nodeIndices.begin() + i);
+				path.nodeIndices.insert(
+					path.nodeIndices.end(),
+					spurPath.nodeIndices.begin(),
+					spurPath.nodeIndices.end());
+				path.edgeIndices.assign(
+					previousPath.edgeIndices.begin(), previousPath.edgeIndices.begin() + i);
+				path.edgeIndices.insert(
+					path.edgeIndices.end(),
+					spurPath.edgeIndices.begin(),
+					spurPath.edgeIndices.end());
+
+				if (knownEdgeSequences.insert(path.edgeIndices).second)
+				{
+					candidates.push_back(path);
+				}
+			}
+		}
+
+		if (candidates.empty())
+		{
+			break;
+		}
+
+		auto it = std::min_element(
+			candidates.begin(), candidates.end(), [](const Path& a, const Path& b) {
+				return a.edgeIndices.size() != b.edgeIndices.size()
+					? a.edgeIndices.size() < b.edgeIndices.size()
+					: a.edgeIndices < b.edgeIndices;
+			});
+		paths.push_back(*it);
+		candidates.erase(it);
+	}
+
+	return paths;
+}
+
+template <typename FuncType>
+void AdjacencyPathFinder::forEachStep(uint32_t nodeIndex, bool forward, FuncType func) const
+{
+	// an edge leads from source to target, unless it is laid out vertically
+	for (const AdjacencyCache::Neighbor& neighbor: m_cache.getOutgoing(nodeIndex))
+	{
+		const Edge::EdgeType type = m_cache.getEdgeType(neighbor.edgeIndex);
+		if (type & m_edgeTypes && neighbor.nodeIndex != nodeIndex &&
+			(!m_directed || forward != bool(type & Edge::LAYOUT_VERTICAL)))
+		{
+			func(neighbor.nodeIndex, neighbor.edgeIndex);
+		}
+	}
+
+	for (const AdjacencyCache::Neighbor& neighbor: m_cache.getIncoming(nodeIndex))
+	{
+		const Edge::EdgeType type = m_cache.getEdgeType(neighbor.edgeIndex);
+		if (type & m_edgeTypes && neighbor.nodeIndex != nodeIndex &&
+			(!m_directed || forward == bool(type & Edge::LAYOUT_VERTICAL)))
+		{
+			func(neighbor.nodeIndex, neighbor.edgeIndex);
+		}
+	}
+}
+
+bool AdjacencyPathFinder::search(
+	uint32_t originIndex,
+	uint32_t targetIndex,
+	size_t maxLength,
+	const std::unordered_set<uint32_t>& blockedNodes,
+	const std::unordered_set<uint32_t>& blockedEdges,
+	Steps* forwardSteps,
+	Steps* backwardSteps,
+	std::vector<uint32_t>* meetingNodes) const
+{
+	forwardSteps->clear();
+	backwardSteps->clear();
+	meetingNodes->clear();
+
+	if (originIndex == targetIndex)
+	{
+		forwardSteps->emplace(originIndex, Step {0, originIndex, 0});
+		backwardSteps->emplace(targetIndex, Step {0, targetIndex, 0});
+		meetingNodes->push_back(originIndex);
+		return true;
+	}
+
+	if (!m_isNodeAccepted(targetIndex))
+	{
+		return false;
+	}
+
+	forwardSteps->emplace(originIndex, Step {0, originIndex, 0});
+	backwardSteps->emplace(targetIndex, Step {0, targetIndex, 0});
+
+	std::vector<uint32_t> forwardFrontier = {originIndex};
+	std::vector<uint32_t> backwardFrontier = {targetIndex};
+	size_t forwardDepth = 0;
+	size_t backwardDepth = 0;
+
+	while (forwardFrontier.size() && backwardFrontier.size() &&
+		   (!maxLength || forwardDepth + backwardDepth < maxLength))
+	{
+		// expanding the smaller frontier keeps the number of visited nodes low, the first level
+		// on which both searches meet determines the length of the shortest paths
+		const bool forward = forwardFrontier.size() <= backwardFrontier.size();
+		std::vector<uint32_t>& frontier = forward ? forwardFrontier : backwardFrontier;
+		Steps& steps = forward ? *forwardSteps : *backwardSteps;
+		const Steps& otherSteps = forward ? *backwardSteps : *forwardSteps;
+		const uint32_t distance = static_cast<uint32_t>(forward ? ++forwardDepth : ++backwardDepth);
+
+		std::vector<uint32_t> nextFrontier;
+		for (const uint32_t nodeIndex: frontier)
+		{
+			forEachStep(nodeIndex, forward, [&](uint32_t nextIndex, uint32_t edgeIndex) {
+				if (steps.find(nextIndex) != steps.end() || blockedNodes.count(nextIndex) ||
+					blockedEdges.count(edgeIndex))
+				{
+					return;
+				}
+
+				if (nextIndex != originIndex && nextIndex != targetIndex &&
+					!m_isNodeAccepted(nextIndex))
+				{
+					return;
+				}
+
+				steps.emplace(nextIndex, Step {distance, nodeIndex, edgeIndex});
+				nextFrontier.push_back(nextIndex);
+
+				if (otherSteps.find(nextIndex) != otherSteps.end())
+				{
+					meetingNodes->push_back(nextIndex);
+				}
+			});
+		}
+		frontier.swap(nextFrontier);
+
+		if (meetingNodes->size())
+		{
+			std::sort(meetingNodes->begin(), meetingNodes->end());
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool AdjacencyPathFinder::findShortestPath(
+	uint32_t originIndex,
+	uint32_t targetIndex,
+	size_t maxLength,
+	const std::unordered_set<uint32_t>& blockedNodes,
+	const std::unordered_set<uint32_t>& blockedEdges,
+	Path* path) const
+{
+	Steps forwardSteps;
+	Steps backwardSteps;
+	std::vector<uint32_t> meetingNodes;
+	if (!search(
+			originIndex,
+			targetIndex,
+			maxLength,
+			blockedNodes,
+			blockedEdges,
+			&forwardSteps,
+			&backwardSteps,
+			&meetingNodes))
+	{
+		return false;
+	}
+
+	const uint32_t meetingIndex = meetingNodes.front();
+
+	path->nodeIndices.clear();
+	path->edgeIndices.clear();
+
+	for (uint32_t nodeIndex = meetingIndex; nodeIndex != originIndex;)
+	{
+		const Step& step = forwardSteps.find(nodeIndex)->second;
+		path->nodeIndices.push_back(nodeIndex);
+		path->edgeIndices.push_back(step.edgeIndex);
+		nodeIndex = step.nodeIndex;
+	}
+	path->nodeIndices.push_back(originIndex);
+
+	std::reverse(path->nodeIndices.begin(), path->nodeIndices.end());
+	std::reverse(path->edgeIndices.begin(), path->edgeIndices.end());
+
+	for (uint32_t nodeIndex = meetingIndex; nodeIndex != targetIndex;)
+	{
+		const Step& step = backwardSteps.find(nodeIndex)->second;
+		path->edgeIndices.push_back(step.edgeIndex);
+		nodeIndex = step.nodeIndex;
+		path->nodeIndices.push_back(nodeIndex);
+	}
+
+	return true;
+}
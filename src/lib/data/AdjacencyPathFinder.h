@@ -0,0 +1,79 @@
+#ifndef ADJACENCY_PATH_FINDER_H
+#define ADJACENCY_PATH_FINDER_H
+
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "AdjacencyCache.h"
+
+// Finds shortest paths between two nodes of an AdjacencyCache with a bidirectional breadth-first
+// search. Edges are followed in their layout direction, so vertical edges (e.g. inheritance) are
+// walked from target to source. Filters are applied while expanding, not afterwards.
+class AdjacencyPathFinder
+{
+public:
+	struct Path
+	{
+		std::vector<uint32_t> nodeIndices;
+		std::vector<uint32_t> edgeIndices;
+	};
+
+	AdjacencyPathFinder(
+		const AdjacencyCache& cache,
+		Edge::TypeMask edgeTypes,
+		bool directed,
+		std::function<bool(uint32_t)> isNodeAccepted);
+
+	// Union of all shortest paths with at most maxLength edges (0 for unlimited). Returns false if
+	// the target can't be reached.
+	bool findAllShortestPaths(
+		uint32_t originIndex,
+		uint32_t targetIndex,
+		size_t maxLength,
+		std::vector<uint32_t>* nodeIndices,
+		std::vector<uint32_t>* edgeIndices) const;
+
+	// Up to pathCount loopless paths ordered by length (Yen's algorithm).
+	std::vector<Path> findShortestPaths(
+		uint32_t originIndex, uint32_t targetIndex, size_t maxLength, size_t pathCount) const;
+
+private:
+	struct Step
+	{
+		uint32_t distance;
+		uint32_t nodeIndex;	   // previous node on the way back to the start of the search
+		uint32_t edgeIndex;
+	};
+
+	typedef std::unordered_map<uint32_t, Step> Steps;
+
+	template <typename FuncType>
+	void forEachStep(uint32_t nodeIndex, bool forward, FuncType func) const;
+
+	bool search(
+		uint32_t originIndex,
+		uint32_t targetIndex,
+		size_t maxLength,
+		const std::unordered_set<uint32_t>& blockedNodes,
+		const std::unordered_set<uint32_t>& blockedEdges,
+		Steps* forwardSteps,
+		Steps* backwardSteps,
+		std::vector<uint32_t>* meetingNodes) const;
+
+	bool findShortestPath(
+		uint32_t originIndex,
+		uint32_t targetIndex,
+		size_t maxLength,
+		const std::unordered_set<uint32_t>& blockedNodes,
+		const std::unordered_set<uint32_t>& blockedEdges,
+		Path* path) const;
+
+	const AdjacencyCache& m_cache;
+	const Edge::TypeMask m_edgeTypes;
+	const bool m_directed;
+	std::function<bool(uint32_t)> m_isNodeAccepted;
+};
+
+#endif	  // ADJACENCY_PATH_FINDER_H
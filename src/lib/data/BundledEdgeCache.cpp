@@ -0,0 +1,119 @@
+#include "BundledEdgeCache.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "AdjacencyCache.h"
+#include "HierarchyCache.h"
+
+void BundledEdgeCache::clear()
+{
+	m_bundleOffsets.clear();
+	m_bundles.clear();
+	m_bundledEdges.clear();
+}
+
+void BundledEdgeCache::build(
+	const AdjacencyCache& adjacencyCache, const HierarchyCache& hierarchyCache)
+{
+	clear();
+
+	const size_t nodeCount = adjacencyCache.getNodeCount();
+
+	std::vector<uint32_t> parentIndices(nodeCount);
+	for (uint32_t i = 0; i < nodeCount; i++)
+	{
+		const uint32_t parentIndex = adjacencyCache.getNodeIndex(
+			hierarchyCache.getLastVisibleParentNodeId(adjacencyCache.getNodeId(i)));
+		parentIndices[i] = parentIndex != AdjacencyCache::INVALID_INDEX ? parentIndex : i;
+	}
+
+	struct Entry
+	{
+		uint32_t targetIndex;
+		BundledEdge edge;
+	};
+
+	// every edge between two parents is added to the rows of both, unless its end is the parent
+	std::vector<uint32_t> entryOffsets(nodeCount + 1, 0);
+	auto forEachEntry = [&](auto func) {
+		for (uint32_t sourceIndex = 0; sourceIndex < nodeCount; sourceIndex++)
+		{
+			const uint32_t sourceParentIndex = parentIndices[sourceIndex];
+			for (const AdjacencyCache::Neighbor& neighbor: adjacencyCache.getOutgoing(sourceIndex))
+			{
+				const uint32_t targetParentIndex = parentIndices[neighbor.nodeIndex];
+				if (sourceParentIndex == targetParentIndex)
+				{
+					continue;
+				}
+
+				if (sourceIndex != sourceParentIndex)
+				{
+					func(sourceParentIndex, Entry {targetParentIndex, {neighbor.edgeIndex, true}});
+				}
+
+				if (neighbor.nodeIndex != targetParentIndex)
+				{
+					func(targetParentIndex, Entry {sourceParentIndex, {neighbor.edgeIndex, false}});
+				}
+			}
+		}
+	};
+
+	forEachEntry([&](uint32_t rowIndex, const Entry&) { entryOffsets[rowIndex + 1]++; });
+	std::partial_sum(entryOffsets.begin(), entryOffsets.end(), entryOffsets.begin());
+
+	std::vector<Entry> entries(entryOffsets.back());
+	std::vector<uint32_t> positions(entryOffsets.begin(), entryOffsets.end() - 1);
+	forEachEntry([&](uint32_t rowIndex, const Entry& entry) {
+		entries[positions[rowIndex]++] = entry;
+	});
+
+	m_bundleOffsets.assign(nodeCount + 1, 0);
+	m_bundledEdges.reserve(entries.size());
+	for (uint32_t rowIndex = 0; rowIndex < nodeCount; rowIndex++)
+	{
+		auto rowBegin = entries.begin() + entryOffsets[rowIndex];
+		auto rowEnd = entries.begin() + entryOffsets[rowIndex + 1];
+		std::sort(rowBegin, rowEnd, [](const Entry& a, const Entry& b) {
+			return a.targetIndex != b.targetIndex ? a.targetIndex < b.targetIndex
+												  : a.edge.edgeIndex < b.edge.edgeIndex;
+		});
+
+		for (auto it = rowBegin; it != rowEnd; it++)
+		{
+			if (it == rowBegin || it->targetIndex != m_bundles.back().targetIndex)
+			{
+				m_bundles.push_back(
+					{it->targetIndex, static_cast<uint32_t>(m_bundledEdges.size()), 0});
+			}
+
+			m_bundles.back().edgeCount++;
+			m_bundledEdges.push_back(it->edge);
+		}
+
+		m_bundleOffsets[rowIndex + 1] = static_cast<uint32_t>(m_bundles.size());
+	}
+}
+
+BundledEdgeCache::Range<BundledEdgeCache::Bundle> BundledEdgeCache::getBundles(
+	uint32_t nodeIndex) const
+{
+	if (nodeIndex + 1 >= m_bundleOffsets.size())
+	{
+		return Range<Bundle>(nullptr, nullptr);
+	}
+
+	const Bundle* data = m_bundles.data();
+	return Range<Bundle>(
+		data + m_bundleOffsets[nodeIndex], data + m_bundleOffsets[nodeIndex + 1]);
+}
+
+BundledEdgeCache::Range<BundledEdgeCache::BundledEdge> BundledEdgeCache::getBundledEdges(
+	const Bundle& bundle) const
+{
+	const BundledEdge* data = m_bundledEdges.data();
+	return Range<BundledEdge>(
+		data + bundle.edgeOffset, data + bundle.edgeOffset + bundle.edgeCount);
+}
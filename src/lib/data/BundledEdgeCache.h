@@ -0,0 +1,64 @@
+#ifndef BUNDLED_EDGE_CACHE_H
+#define BUNDLED_EDGE_CACHE_H
+
+#include <cstdint>
+#include <vector>
+
+class AdjacencyCache;
+class HierarchyCache;
+
+// Edges between the members of different last visible parents, grouped by the pair of parents.
+// Activating a parent only has to copy the bundles of its row instead of collecting and grouping
+// all edges of its members. Node and edge indices refer to the AdjacencyCache.
+class BundledEdgeCache
+{
+public:
+	struct BundledEdge
+	{
+		uint32_t edgeIndex;
+		bool forward;	 // edge leads from a member of the parent to the bundle target
+	};
+
+	struct Bundle
+	{
+		uint32_t targetIndex;	 // last visible parent of the other ends
+		uint32_t edgeOffset;
+		uint32_t edgeCount;
+	};
+
+	template <typename T>
+	class Range
+	{
+	public:
+		Range(const T* begin, const T* end): m_begin(begin), m_end(end) {}
+
+		const T* begin() const
+		{
+			return m_begin;
+		}
+
+		const T* end() const
+		{
+			return m_end;
+		}
+
+	private:
+		const T* m_begin;
+		const T* m_end;
+	};
+
+	void clear();
+
+	void build(const AdjacencyCache& adjacencyCache, const HierarchyCache& hierarchyCache);
+
+	// bundles of the members of a last visible parent, edges of the parent itself are not included
+	Range<Bundle> getBundles(uint32_t nodeIndex) const;
+	Range<BundledEdge> getBundledEdges(const Bundle& bundle) const;
+
+private:
+	std::vector<uint32_t> m_bundleOffsets;
+	std::vector<Bundle> m_bundles;
+	std::vector<BundledEdge> m_bundledEdges;
+};
+
+#endif	  // BUNDLED_EDGE_CACHE_H
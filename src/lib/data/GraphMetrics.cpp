@@ -0,0 +1,543 @@
+#include "GraphMetrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <random>
+#include <thread>
+
+namespace
+{
+// upper bound of word operations for counting reachable nodes exactly
+const double s_maxExactReachabilityWork = 4e9;
+
+const size_t s_reachabilitySampleCount = 64;
+
+// runs func(begin, end) on equally sized parts of [0, count)
+template <typename FuncType>
+void runInParallel(size_t count, size_t threadCount, FuncType func)
+{
+	if (threadCount < 2 || count < 2)
+	{
+		func(size_t(0), count);
+		return;
+	}
+
+	const size_t partSize = (count + threadCount - 1) / threadCount;
+
+	std::vector<std::shared_ptr<std::thread>> threads;
+	for (size_t begin = 0; begin < count; begin += partSize)
+	{
+		threads.push_back(
+			std::make_shared<std::thread>(func, begin, std::min(begin + partSize, count)));
+	}
+
+	for (const std::shared_ptr<std::thread>& thread: threads)
+	{
+		thread->join();
+	}
+}
+}	 // namespace
+
+GraphMetrics::GraphMetrics(
+	const AdjacencyCache& cache, Edge::TypeMask edgeTypes, size_t threadCount)
+	: m_cache(cache), m_edgeTypes(edgeTypes), m_threadCount(std::max(threadCount, size_t(1)))
+{
+	computeFanInsAndFanOuts();
+	computeComponents();
+	computeComponentSuccessors();
+}
+
+size_t GraphMetrics::getEdgeCount() const
+{
+	return m_edgeCount;
+}
+
+uint32_t GraphMetrics::getFanIn(uint32_t nodeIndex) const
+{
+	return m_fanIns[nodeIndex];
+}
+
+uint32_t GraphMetrics::getFanOut(uint32_t nodeIndex) const
+{
+	return m_fanOuts[nodeIndex];
+}
+
+size_t GraphMetrics::getComponentCount() const
+{
+	return m_componentSizes.size();
+}
+
+uint32_t GraphMetrics::getComponentIndex(uint32_t nodeIndex) const
+{
+	return m_componentIndices[nodeIndex];
+}
+
+std::vector<std::vector<uint32_t>> GraphMetrics::getCyclicComponents() const
+{
+	std::vector<size_t> cyclicComponentIndices(m_componentSizes.size(), 0);
+
+	std::vector<std::vector<uint32_t>> components;
+	for (size_t i = 0; i < m_componentSizes.size(); i++)
+	{
+		if (m_componentSizes[i] > 1)
+		{
+			cyclicComponentIndices[i] = components.size();
+			components.emplace_back();
+			components.back().reserve(m_componentSizes[i]);
+		}
+	}
+
+	for (uint32_t nodeIndex = 0; nodeIndex < m_componentIndices.size(); nodeIndex++)
+	{
+		const uint32_t componentIndex = m_componentIndices[nodeIndex];
+		if (m_componentSizes[componentIndex] > 1)
+		{
+			components[cyclicComponentIndices[componentIndex]].push_back(nodeIndex);
+		}
+	}
+
+	std::stable_sort(
+		components.begin(),
+		components.end(),
+		[](const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+			return a.size() > b.size();
+		});
+
+	return components;
+}
+
+std::vector<double> GraphMetrics::computePageRanks(
+	double damping, double tolerance, size_t maxIterationCount) const
+{
+	const size_t nodeCount = m_cache.getNodeCount();
+	if (!nodeCount)
+	{
+		return {};
+	}
+
+	// sources of the followed incoming edges, so iterations don't need to look up edge types
+	std::vector<uint32_t> sourceOffsets(nodeCount + 1, 0);
+	for (size_t i = 0; i < nodeCount; i++)
+	{
+		sourceOffsets[i + 1] = sourceOffsets[i] + m_fanIns[i];
+	}
+
+	std::vector<uint32_t> sources(sourceOffsets.back());
+	runInParallel(nodeCount, m_threadCount, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++)
+		{
+			const uint32_t nodeIndex = static_cast<uint32_t>(i);
+
+			uint32_t position = sourceOffsets[i];
+			for (const AdjacencyCache::Neighbor& neighbor: m_cache.getIncoming(nodeIndex))
+			{
+				if (isFollowed(neighbor, nodeIndex))
+				{
+					sources[position++] = neighbor.nodeIndex;
+				}
+			}
+		}
+	});
+
+	std::vector<double> ranks(nodeCount, 1.0 / nodeCount);
+	std::vector<double> contributions(nodeCount);
+	std::vector<double> nextRanks(nodeCount);
+
+	for (size_t iteration = 0; iteration < maxIterationCount; iteration++)
+	{
+		// nodes without outgoing edges distribute their rank to all nodes
+		double danglingRank = 0.0;
+		for (size_t i = 0; i < nodeCount; i++)
+		{
+			if (m_fanOuts[i])
+			{
+				contributions[i] = ranks[i] / m_fanOuts[i];
+			}
+			else
+			{
+				contributions[i] = 0.0;
+				danglingRank += ranks[i];
+			}
+		}
+
+		const double baseRank = (1.0 - damping + damping * danglingRank) / nodeCount;
+
+		runInParallel(nodeCount, m_threadCount, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++)
+			{
+				double rank = 0.0;
+				for (uint32_t j = sourceOffsets[i]; j < sourceOffsets[i + 1]; j++)
+				{
+					rank += contributions[sources[j]];
+				}
+				nextRanks[i] = baseRank + damping * rank;
+			}
+		});
+
+		double change = 0.0;
+		for (size_t i = 0; i < nodeCount; i++)
+		{
+			change += std::abs(nextRanks[i] - ranks[i]);
+		}
+
+		ranks.swap(nextRanks);
+
+		if (change < tolerance)
+		{
+			break;
+		}
+	}
+
+	return ranks;
+}
+
+std::vector<size_t> GraphMetrics::computeReachableNodeCounts(bool* exact) const
+{
+	const double componentCount = static_cast<double>(m_componentSizes.size());
+	const double work = std::ceil(componentCount / 64) * (componentCount + m_successors.size());
+
+	*exact = work <= s_maxExactReachabilityWork;
+
+	const std::vector<size_t> componentNodeCounts = *exact
+		? countReachableComponentNodes()
+		: estimateReachableComponentNodes();
+
+	// the node itself is part of the nodes reachable from its component
+	std::vector<size_t> counts(m_componentIndices.size());
+	for (size_t i = 0; i < counts.size(); i++)
+	{
+		counts[i] = componentNodeCounts[m_componentIndices[i]] - 1;
+	}
+	return counts;
+}
+
+bool GraphMetrics::isFollowed(const AdjacencyCache::Neighbor& neighbor, uint32_t nodeIndex) const
+{
+	return neighbor.nodeIndex != nodeIndex &&
+		(m_cache.getEdgeType(neighbor.edgeIndex) & m_edgeTypes);
+}
+
+void GraphMetrics::computeFanInsAndFanOuts()
+{
+	const size_t nodeCount = m_cache.getNodeCount();
+	m_fanIns.assign(nodeCount, 0);
+	m_fanOuts.assign(nodeCount, 0);
+
+	runInParallel(nodeCount, m_threadCount, [this](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++)
+		{
+			const uint32_t nodeIndex = static_cast<uint32_t>(i);
+
+			for (const AdjacencyCache::Neighbor& neighbor: m_cache.getIncoming(nodeIndex))
+			{
+				if (isFollowed(neighbor, nodeIndex))
+				{
+					m_fanIns[i]++;
+				}
+			}
+
+			for (const AdjacencyCache::Neighbor& neighbor: m_cache.getOutgoing(nodeIndex))
+			{
+				if (isFollowed(neighbor, nodeIndex))
+				{
+					m_fanOuts[i]++;
+				}
+			}
+		}
+	});
+
+	m_edgeCount = 0;
+	for (uint32_t fanOut: m_fanOuts)
+	{
+		m_edgeCount += fanOut;
+	}
+}
+
+void GraphMetrics::computeComponents()
+{
+	const uint32_t nodeCount = static_cast<uint32_t>(m_cache.getNodeCount());
+	const uint32_t unvisited = AdjacencyCache::INVALID_INDEX;
+
+	struct Frame
+	{
+		uint32_t nodeIndex;
+		const AdjacencyCache::Neighbor* nextNeighbor;
+	};
+
+	std::vector<uint32_t> visitIndices(nodeCount, unvisited);
+	std::vector<uint32_t> lowLinks(nodeCount, 0);
+	std::vector<bool> onStack(nodeCount, false);
+	std::vector<uint32_t> stack;
+	std::vector<Frame> frames;
+	uint32_t visitCount = 0;
+
+	m_componentIndices.assign(nodeCount, 0);
+	m_componentSizes.clear();
+
+	auto visit = [&](uint32_t nodeIndex) {
+		visitIndices[nodeIndex] = visitCount;
+		lowLinks[nodeIndex] = visitCount;
+		visitCount++;
+
+		stack.push_back(nodeIndex);
+		onStack[nodeIndex] = true;
+		frames.push_back({nodeIndex, m_cache.getOutgoing(nodeIndex).begin()});
+	};
+
+	for (uint32_t rootIndex = 0; rootIndex < nodeCount; rootIndex++)
+	{
+		if (visitIndices[rootIndex] != unvisited)
+		{
+			continue;
+		}
+
+		visit(rootIndex);
+
+		while (frames.size())
+		{
+			const uint32_t nodeIndex = frames.back().nodeIndex;
+			const AdjacencyCache::Neighbor* end = m_cache.getOutgoing(nodeIndex).end();
+
+			uint32_t childIndex = unvisited;
+			while (frames.back().nextNeighbor != end)
+			{
+				const AdjacencyCache::Neighbor& neighbor = *(frames.back().nextNeighbor++);
+				if (!isFollowed(neighbor, nodeIndex))
+				{
+					continue;
+				}
+
+				if (visitIndices[neighbor.nodeIndex] == unvisited)
+				{
+					childIndex = neighbor.nodeIndex;
+					break;
+				}
+				else if (onStack[neighbor.nodeIndex])
+				{
+					lowLinks[nodeIndex] = std::min(
+						lowLinks[nodeIndex], visitIndices[neighbor.nodeIndex]);
+				}
+			}
+
+			if (childIndex != unvisited)
+			{
+				visit(childIndex);
+				continue;
+			}
+
+			frames.pop_back();
+			if (frames.size())
+			{
+				const uint32_t parentIndex = frames.back().nodeIndex;
+				lowLinks[parentIndex] = std::min(lowLinks[parentIndex], lowLinks[nodeIndex]);
+			}
+
+			if (lowLinks[nodeIndex] == visitIndices[nodeIndex])
+			{
+				const uint32_t componentIndex = static_cast<uint32_t>(m_componentSizes.size());
+				uint32_t componentSize = 0;
+
+				uint32_t memberIndex;
+				do
+				{
+					memberIndex = stack.back();
+					stack.pop_back();
+					onStack[memberIndex] = false;
+
+					m_componentIndices[memberIndex] = componentIndex;
+					componentSize++;
+				} while (memberIndex != nodeIndex);
+
+				m_componentSizes.push_back(componentSize);
+			}
+		}
+	}
+}
+
+void GraphMetrics::computeComponentSuccessors()
+{
+	const size_t nodeCount = m_componentIndices.size();
+	const size_t componentCount = m_componentSizes.size();
+
+	// group the nodes by their component
+	std::vector<uint32_t> nodeOffsets(componentCount + 1, 0);
+	for (uint32_t componentIndex: m_componentIndices)
+	{
+		nodeOffsets[componentIndex + 1]++;
+	}
+	for (size_t i = 0; i < componentCount; i++)
+	{
+		nodeOffsets[i + 1] += nodeOffsets[i];
+	}
+
+	std::vector<uint32_t> componentNodes(nodeCount);
+	{
+		std::vector<uint32_t> positions(nodeOffsets.begin(), nodeOffsets.end() - 1);
+		for (uint32_t nodeIndex = 0; nodeIndex < nodeCount; nodeIndex++)
+		{
+			componentNodes[positions[m_componentIndices[nodeIndex]]++] = nodeIndex;
+		}
+	}
+
+	m_successorOffsets.assign(componentCount + 1, 0);
+	m_successors.clear();
+
+	// remembers the last component that added a successor to skip duplicates
+	std::vector<uint32_t> addedBy(componentCount, AdjacencyCache::INVALID_INDEX);
+
+	for (uint32_t componentIndex = 0; componentIndex < componentCount; componentIndex++)
+	{
+		for (uint32_t i = nodeOffsets[componentIndex]; i < nodeOffsets[componentIndex + 1]; i++)
+		{
+			const uint32_t nodeIndex = componentNodes[i];
+			for (const AdjacencyCache::Neighbor& neighbor: m_cache.getOutgoing(nodeIndex))
+			{
+				const uint32_t successorIndex = m_componentIndices[neighbor.nodeIndex];
+				if (successorIndex != componentIndex && addedBy[successorIndex] != componentIndex &&
+					isFollowed(neighbor, nodeIndex))
+				{
+					addedBy[successorIndex] = componentIndex;
+					m_successors.push_back(successorIndex);
+				}
+			}
+		}
+
+		m_successorOffsets[componentIndex + 1] = static_cast<uint32_t>(m_successors.size());
+	}
+}
+
+std::vector<size_t> GraphMetrics::countReachableComponentNodes() const
+{
+	const size_t componentCount = m_componentSizes.size();
+	const size_t chunkCount = (componentCount + 63) / 64;
+	if (!chunkCount)
+	{
+		return {};
+	}
+
+	// every thread marks the reachable components of separate chunks of 64 components in a word
+	std::vector<std::vector<size_t>> threadCounts(std::min(m_threadCount, chunkCount));
+	const size_t chunksPerThread = (chunkCount + threadCounts.size() - 1) / threadCounts.size();
+
+	runInParallel(chunkCount, threadCounts.size(), [&](size_t beginChunk, size_t endChunk) {
+		std::vector<size_t>& counts = threadCounts[beginChunk / chunksPerThread];
+		counts.assign(componentCount, 0);
+
+		std::vector<uint64_t> reachable(componentCount, 0);
+
+		for (size_t chunk = beginChunk; chunk < endChunk; chunk++)
+		{
+			const size_t chunkBegin = chunk * 64;
+			const size_t chunkEnd = std::min(chunkBegin + 64, componentCount);
+
+			// node count of every combination of 8 bits of the chunk
+			std::vector<size_t> byteSizes(8 * 256, 0);
+			for (size_t i = chunkBegin; i < chunkEnd; i++)
+			{
+				const size_t bit = i - chunkBegin;
+				size_t* table = &byteSizes[(bit / 8) * 256];
+				for (size_t value = 0; value < 256; value++)
+				{
+					if (value & (size_t(1) << (bit % 8)))
+					{
+						table[value] += m_componentSizes[i];
+					}
+				}
+			}
+
+			// components can only reach components with lower indices
+			for (size_t i = chunkBegin; i < componentCount; i++)
+			{
+				uint64_t bits = i < chunkEnd ? uint64_t(1) << (i - chunkBegin) : 0;
+				for (uint32_t j = m_successorOffsets[i]; j < m_successorOffsets[i + 1]; j++)
+				{
+					if (m_successors[j] >= chunkBegin)
+					{
+						bits |= reachable[m_successors[j]];
+					}
+				}
+				reachable[i] = bits;
+
+				for (size_t byte = 0; bits; byte++, bits >>= 8)
+				{
+					counts[i] += byteSizes[byte * 256 + (bits & 255)];
+				}
+			}
+		}
+	});
+
+	std::vector<size_t> counts(componentCount, 0);
+	for (const std::vector<size_t>& threadCount: threadCounts)
+	{
+		for (size_t i = 0; i < threadCount.size(); i++)
+		{
+			counts[i] += threadCount[i];
+		}
+	}
+	return counts;
+}
+
+std::vector<size_t> GraphMetrics::estimateReachableComponentNodes() const
+{
+	const size_t nodeCount = m_componentIndices.size();
+	const size_t componentCount = m_componentSizes.size();
+
+	// every thread sums the minimal ranks of separate samples
+	std::vector<std::vector<double>> threadSums(std::min(m_threadCount, s_reachabilitySampleCount));
+	const size_t samplesPerThread = (s_reachabilitySampleCount + threadSums.size() - 1) /
+		threadSums.size();
+
+	auto sumMinRanks = [&](size_t beginSample, size_t endSample) {
+		std::vector<double>& sums = threadSums[beginSample / samplesPerThread];
+		sums.assign(componentCount, 0.0);
+
+		std::vector<double> minRanks(componentCount);
+
+		for (size_t sample = beginSample; sample < endSample; sample++)
+		{
+			std::mt19937_64 random(sample + 1);
+			std::exponential_distribution<double> distribution(1.0);
+
+			std::fill(minRanks.begin(), minRanks.end(), std::numeric_limits<double>::infinity());
+			for (size_t i = 0; i < nodeCount; i++)
+			{
+				double& minRank = minRanks[m_componentIndices[i]];
+				minRank = std::min(minRank, distribution(random));
+			}
+
+			for (size_t i = 0; i < componentCount; i++)
+			{
+				for (uint32_t j = m_successorOffsets[i]; j < m_successorOffsets[i + 1]; j++)
+				{
+					minRanks[i] = std::min(minRanks[i], minRanks[m_successors[j]]);
+				}
+				sums[i] += minRanks[i];
+			}
+		}
+	};
+
+	runInParallel(s_reachabilitySampleCount, threadSums.size(), sumMinRanks);
+
+	std::vector<size_t> counts(componentCount, 0);
+	for (size_t i = 0; i < componentCount; i++)
+	{
+		if (m_successorOffsets[i] == m_successorOffsets[i + 1])
+		{
+			counts[i] = m_componentSizes[i];
+			continue;
+		}
+
+		double sum = 0.0;
+		for (const std::vector<double>& threadSum: threadSums)
+		{
+			sum += threadSum[i];
+		}
+
+		const double estimate = (s_reachabilitySampleCount - 1) / sum;
+		counts[i] = std::max(
+			static_cast<size_t>(std::llround(estimate)), size_t(m_componentSizes[i]) + 1);
+	}
+	return counts;
+}
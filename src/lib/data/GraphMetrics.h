@@ -0,0 +1,65 @@
+#ifndef GRAPH_METRICS_H
+#define GRAPH_METRICS_H
+
+#include <cstdint>
+#include <vector>
+
+#include "AdjacencyCache.h"
+
+// Metrics of the graph formed by the edges of an AdjacencyCache that match the given edge types.
+// Self loops are ignored. Strongly connected components are found with an iterative version of
+// Tarjan's algorithm while setting up, all other metrics are computed on multiple threads.
+class GraphMetrics
+{
+public:
+	GraphMetrics(const AdjacencyCache& cache, Edge::TypeMask edgeTypes, size_t threadCount);
+
+	size_t getEdgeCount() const;
+
+	uint32_t getFanIn(uint32_t nodeIndex) const;
+	uint32_t getFanOut(uint32_t nodeIndex) const;
+
+	// Components are numbered in reverse topological order, so edges between components always
+	// lead to a component with a lower index.
+	size_t getComponentCount() const;
+	uint32_t getComponentIndex(uint32_t nodeIndex) const;
+
+	// components with more than one node, largest first
+	std::vector<std::vector<uint32_t>> getCyclicComponents() const;
+
+	// Ranks of all nodes sum up to 1. Iterates until the ranks change by less than the tolerance.
+	std::vector<double> computePageRanks(
+		double damping, double tolerance, size_t maxIterationCount) const;
+
+	// Number of other nodes each node transitively leads to. The counts are exact unless the
+	// condensed graph is too large, then they are estimated from the minima of random ranks
+	// propagated along the edges (Cohen's size estimation).
+	std::vector<size_t> computeReachableNodeCounts(bool* exact) const;
+
+private:
+	bool isFollowed(const AdjacencyCache::Neighbor& neighbor, uint32_t nodeIndex) const;
+
+	void computeFanInsAndFanOuts();
+	void computeComponents();
+	void computeComponentSuccessors();
+
+	std::vector<size_t> countReachableComponentNodes() const;
+	std::vector<size_t> estimateReachableComponentNodes() const;
+
+	const AdjacencyCache& m_cache;
+	const Edge::TypeMask m_edgeTypes;
+	const size_t m_threadCount;
+
+	size_t m_edgeCount = 0;
+	std::vector<uint32_t> m_fanIns;
+	std::vector<uint32_t> m_fanOuts;
+
+	std::vector<uint32_t> m_componentIndices;	// indexed by node index
+	std::vector<uint32_t> m_componentSizes;
+
+	// distinct successors of each component, stored like the rows of the AdjacencyCache
+	std::vector<uint32_t> m_successorOffsets;
+	std::vector<uint32_t> m_successors;
+};
+
+#endif	  // GRAPH_METRICS_H
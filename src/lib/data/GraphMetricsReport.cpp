@@ -0,0 +1,111 @@
+#include "GraphMetricsReport.h"
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "GraphMetrics.h"
+#include "PersistentStorage.h"
+
+namespace
+{
+QJsonObject nodeToJson(
+	const PersistentStorage& storage, const AdjacencyCache& cache, uint32_t nodeIndex)
+{
+	const Id nodeId = cache.getNodeId(nodeIndex);
+
+	QJsonObject node;
+	node["id"] = static_cast<qint64>(nodeId);
+	node["name"] = QString::fromStdWString(
+		storage.getNameHierarchyForNodeId(nodeId).getQualifiedName());
+	node["kind"] = QString::fromStdString(getReadableNodeKindString(cache.getNodeKind(nodeIndex)));
+	return node;
+}
+
+// the topCount nodes with the highest values, leaving out nodes without a value
+QJsonArray topNodesToJson(
+	const PersistentStorage& storage,
+	const AdjacencyCache& cache,
+	size_t topCount,
+	std::function<double(uint32_t)> getValue)
+{
+	std::vector<std::pair<double, uint32_t>> values;
+	for (uint32_t i = 0; i < cache.getNodeCount(); i++)
+	{
+		const double value = getValue(i);
+		if (value > 0)
+		{
+			values.emplace_back(value, i);
+		}
+	}
+
+	const size_t count = std::min(topCount, values.size());
+	std::partial_sort(
+		values.begin(),
+		values.begin() + count,
+		values.end(),
+		[](const std::pair<double, uint32_t>& a, const std::pair<double, uint32_t>& b) {
+			return a.first > b.first || (a.first == b.first && a.second < b.second);
+		});
+
+	QJsonArray nodes;
+	for (size_t i = 0; i < count; i++)
+	{
+		QJsonObject node = nodeToJson(storage, cache, values[i].second);
+		node["value"] = values[i].first;
+		nodes.append(node);
+	}
+	return nodes;
+}
+}	 // namespace
+
+std::string GraphMetricsReport::create(
+	const PersistentStorage& storage, Edge::TypeMask edgeTypes, size_t topCount, size_t threadCount)
+{
+	const AdjacencyCache& cache = storage.getAdjacencyCache();
+	const GraphMetrics metrics(cache, edgeTypes, threadCount);
+
+	QJsonObject report;
+	report["nodeCount"] = static_cast<qint64>(cache.getNodeCount());
+	report["edgeCount"] = static_cast<qint64>(metrics.getEdgeCount());
+	report["componentCount"] = static_cast<qint64>(metrics.getComponentCount());
+
+	report["fanIn"] = topNodesToJson(
+		storage, cache, topCount, [&](uint32_t i) { return metrics.getFanIn(i); });
+	report["fanOut"] = topNodesToJson(
+		storage, cache, topCount, [&](uint32_t i) { return metrics.getFanOut(i); });
+
+	const std::vector<double> ranks = metrics.computePageRanks(0.85, 1e-6, 100);
+	report["pageRank"] = topNodesToJson(
+		storage, cache, topCount, [&](uint32_t i) { return ranks[i]; });
+
+	bool exact = false;
+	const std::vector<size_t> reachableCounts = metrics.computeReachableNodeCounts(&exact);
+	report["reachableNodes"] = topNodesToJson(storage, cache, topCount, [&](uint32_t i) {
+		return static_cast<double>(reachableCounts[i]);
+	});
+	report["reachableNodesExact"] = exact;
+
+	QJsonArray cycles;
+	const std::vector<std::vector<uint32_t>> components = metrics.getCyclicComponents();
+	for (size_t i = 0; i < components.size() && i < topCount; i++)
+	{
+		QJsonArray nodes;
+		for (size_t j = 0; j < components[i].size() && j < topCount; j++)
+		{
+			nodes.append(nodeToJson(storage, cache, components[i][j]));
+		}
+
+		QJsonObject cycle;
+		cycle["size"] = static_cast<qint64>(components[i].size());
+		cycle["nodes"] = nodes;
+		cycles.append(cycle);
+	}
+	report["cycles"] = cycles;
+
+	return QJsonDocument(report).toJson(QJsonDocument::Indented).toStdString();
+}
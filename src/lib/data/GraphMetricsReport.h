@@ -0,0 +1,22 @@
+#ifndef GRAPH_METRICS_REPORT_H
+#define GRAPH_METRICS_REPORT_H
+
+#include <string>
+
+#include "Edge.h"
+
+class PersistentStorage;
+
+class GraphMetricsReport
+{
+public:
+	// creates a JSON report with the topCount nodes of each metric and the largest cycles, the
+	// caches of the storage need to be built
+	static std::string create(
+		const PersistentStorage& storage,
+		Edge::TypeMask edgeTypes,
+		size_t topCount,
+		size_t threadCount);
+};
+
+#endif	  // GRAPH_METRICS_REPORT_H
@@ -1,217 +1,167 @@
 #include "HierarchyCache.h"
 
+#include <numeric>
+
 #include "utility.h"
 
-HierarchyCache::HierarchyNode::HierarchyNode(Id nodeId)
-	: m_nodeId(nodeId), m_edgeId(0), m_parent(nullptr), m_isVisible(true), m_isImplicit(false)
+namespace
 {
-}
-
-Id HierarchyCache::HierarchyNode::getNodeId() const
+template <typename T>
+void buildRows(
+	size_t nodeCount,
+	const std::vector<std::pair<uint32_t, T>>& entries,
+	std::vector<uint32_t>* offsets,
+	std::vector<T>* values)
 {
-	return m_nodeId;
-}
+	// counting sort of the entries by their node, keeping the order of the entries per row
+	offsets->assign(nodeCount + 1, 0);
+	for (const std::pair<uint32_t, T>& entry: entries)
+	{
+		(*offsets)[entry.first + 1]++;
+	}
+	std::partial_sum(offsets->begin(), offsets->end(), offsets->begin());
 
-Id HierarchyCache::HierarchyNode::getEdgeId() const
-{
-	return m_edgeId;
+	std::vector<uint32_t> positions(offsets->begin(), offsets->end() - 1);
+	values->resize(entries.size());
+	for (const std::pair<uint32_t, T>& entry: entries)
+	{
+		(*values)[positions[entry.first]++] = entry.second;
+	}
 }
+}	 // namespace
 
-void HierarchyCache::HierarchyNode::setEdgeId(Id edgeId)
+void HierarchyCache::clear()
 {
-	m_edgeId = edgeId;
-}
+	m_nodeIndices.clear();
+	m_nodeIds.clear();
+	m_edgeIds.clear();
+	m_parentIndices.clear();
+	m_lastVisibleParentIndices.clear();
+	m_flags.clear();
 
-HierarchyCache::HierarchyNode* HierarchyCache::HierarchyNode::getParent() const
-{
-	return m_parent;
-}
+	m_childOffsets.clear();
+	m_children.clear();
+	m_baseOffsets.clear();
+	m_bases.clear();
 
-void HierarchyCache::HierarchyNode::setParent(HierarchyNode* parent)
-{
-	m_parent = parent;
+	m_pendingChildren.clear();
+	m_pendingBases.clear();
 }
 
-void HierarchyCache::HierarchyNode::addBase(HierarchyNode* base, Id edgeId)
+void HierarchyCache::createConnection(
+	Id edgeId, Id fromId, Id toId, bool sourceVisible, bool sourceImplicit, bool targetImplicit)
 {
-	m_bases.push_back(base);
-	m_baseEdgeIds.push_back(edgeId);
-}
+	if (fromId == toId)
+	{
+		return;
+	}
 
-void HierarchyCache::HierarchyNode::addChild(HierarchyNode* child)
-{
-	m_children.push_back(child);
-}
+	const uint32_t fromIndex = createNode(fromId);
+	const uint32_t toIndex = createNode(toId);
 
-size_t HierarchyCache::HierarchyNode::getChildrenCount() const
-{
-	return m_children.size();
-}
+	m_pendingChildren.emplace_back(fromIndex, toIndex);
+	m_parentIndices[toIndex] = fromIndex;
 
-size_t HierarchyCache::HierarchyNode::getNonImplicitChildrenCount() const
-{
-	size_t count = 0;
-	for (const HierarchyNode* child: m_children)
-	{
-		if (!child->isImplicit())
-		{
-			count++;
-		}
-	}
-	return count;
-}
+	setFlag(fromIndex, NODE_FLAG_VISIBLE, sourceVisible);
+	setFlag(fromIndex, NODE_FLAG_IMPLICIT, sourceImplicit);
 
-void HierarchyCache::HierarchyNode::addChildIds(std::vector<Id>* nodeIds, std::vector<Id>* edgeIds) const
-{
-	for (const HierarchyNode* child: m_children)
-	{
-		nodeIds->push_back(child->getNodeId());
-		edgeIds->push_back(child->getEdgeId());
-	}
+	m_edgeIds[toIndex] = edgeId;
+	setFlag(toIndex, NODE_FLAG_IMPLICIT, targetImplicit);
 }
 
-void HierarchyCache::HierarchyNode::addNonImplicitChildIds(
-	std::vector<Id>* nodeIds, std::vector<Id>* edgeIds) const
+void HierarchyCache::createInheritance(Id edgeId, Id fromId, Id toId)
 {
-	for (const HierarchyNode* child: m_children)
+	if (fromId == toId)
 	{
-		if (!child->isImplicit())
-		{
-			nodeIds->push_back(child->getNodeId());
-			edgeIds->push_back(child->getEdgeId());
-		}
+		return;
 	}
-}
-
-void HierarchyCache::HierarchyNode::addChildIdsRecursive(std::set<Id>* nodeIds, std::set<Id>* edgeIds) const
-{
-	for (const HierarchyNode* child: m_children)
-	{
-		nodeIds->insert(child->getNodeId());
-		edgeIds->insert(child->getEdgeId());
 
-		child->addChildIdsRecursive(nodeIds, edgeIds);
-	}
-}
+	const uint32_t fromIndex = createNode(fromId);
+	const uint32_t toIndex = createNode(toId);
 
-bool HierarchyCache::HierarchyNode::isVisible() const
-{
-	return m_isVisible;
+	m_pendingBases.emplace_back(fromIndex, Base {toIndex, edgeId});
 }
 
-void HierarchyCache::HierarchyNode::setIsVisible(bool isVisible)
+void HierarchyCache::finishSetup()
 {
-	m_isVisible = isVisible;
-}
+	const size_t nodeCount = m_nodeIds.size();
 
-bool HierarchyCache::HierarchyNode::isImplicit() const
-{
-	return m_isImplicit;
-}
+	buildRows(nodeCount, m_pendingChildren, &m_childOffsets, &m_children);
+	buildRows(nodeCount, m_pendingBases, &m_baseOffsets, &m_bases);
 
-void HierarchyCache::HierarchyNode::setIsImplicit(bool isImplicit)
-{
-	m_isImplicit = isImplicit;
-}
+	m_pendingChildren.clear();
+	m_pendingChildren.shrink_to_fit();
+	m_pendingBases.clear();
+	m_pendingBases.shrink_to_fit();
 
-void HierarchyCache::HierarchyNode::addInheritanceEdgesRecursive(
-	Id startId,
-	const std::set<Id>& inheritanceEdgeIds,
-	const std::set<Id>& nodeIds,
-	std::vector<std::tuple<Id, Id, std::vector<Id>>>* inheritanceEdges)
-{
-	for (size_t i = 0; i < m_bases.size(); i++)
+	// the last visible parent of a visible node is the topmost node of the unbroken chain of
+	// visible parents above it, results of a chain are shared by all nodes on it
+	m_lastVisibleParentIndices.assign(nodeCount, INVALID_INDEX);
+	std::vector<uint32_t> chain;
+	for (uint32_t i = 0; i < nodeCount; i++)
 	{
-		if (inheritanceEdgeIds.find(m_baseEdgeIds[i]) != inheritanceEdgeIds.end())
+		if (m_lastVisibleParentIndices[i] != INVALID_INDEX)
 		{
 			continue;
 		}
 
-		HierarchyNode* base = m_bases[i];
-		Id baseId = base->getNodeId();
-
-		std::set<Id> inheritanceEdgeIds2 = inheritanceEdgeIds;
-		inheritanceEdgeIds2.insert(m_baseEdgeIds[i]);
-
-		if (nodeIds.find(baseId) != nodeIds.end())
+		if (!isVisible(i))
 		{
-			inheritanceEdges->push_back({startId, baseId, utility::toVector(inheritanceEdgeIds2)});
+			m_lastVisibleParentIndices[i] = i;
+			continue;
 		}
 
-		base->addInheritanceEdgesRecursive(startId, inheritanceEdgeIds2, nodeIds, inheritanceEdges);
-	}
-}
-
-
-void HierarchyCache::clear()
-{
-	m_nodes.clear();
-}
-
-void HierarchyCache::createConnection(
-	Id edgeId, Id fromId, Id toId, bool sourceVisible, bool sourceImplicit, bool targetImplicit)
-{
-	if (fromId == toId)
-	{
-		return;
-	}
-
-	HierarchyNode* from = createNode(fromId);
-	HierarchyNode* to = createNode(toId);
-
-	from->addChild(to);
-	to->setParent(from);
-
-	from->setIsVisible(sourceVisible);
-	from->setIsImplicit(sourceImplicit);
-
-	to->setEdgeId(edgeId);
-	to->setIsImplicit(targetImplicit);
-}
+		chain.clear();
+		uint32_t nodeIndex = i;
+		uint32_t lastVisibleIndex = i;
+		while (true)
+		{
+			chain.push_back(nodeIndex);
+
+			const uint32_t parentIndex = m_parentIndices[nodeIndex];
+			if (parentIndex == INVALID_INDEX || !isVisible(parentIndex) || chain.size() > nodeCount)
+			{
+				lastVisibleIndex = nodeIndex;
+				break;
+			}
+
+			if (m_lastVisibleParentIndices[parentIndex] != INVALID_INDEX)
+			{
+				lastVisibleIndex = m_lastVisibleParentIndices[parentIndex];
+				break;
+			}
+
+			nodeIndex = parentIndex;
+		}
 
-void HierarchyCache::createInheritance(Id edgeId, Id fromId, Id toId)
-{
-	if (fromId == toId)
-	{
-		return;
+		for (const uint32_t chainIndex: chain)
+		{
+			m_lastVisibleParentIndices[chainIndex] = lastVisibleIndex;
+		}
 	}
-
-	HierarchyNode* from = createNode(fromId);
-	HierarchyNode* to = createNode(toId);
-
-	from->addBase(to, edgeId);
 }
 
 Id HierarchyCache::getLastVisibleParentNodeId(Id nodeId) const
 {
-	HierarchyNode* node = nullptr;
-	HierarchyNode* parent = getNode(nodeId);
-
-	while (parent && parent->isVisible())
+	const uint32_t nodeIndex = getNodeIndex(nodeId);
+	if (nodeIndex == INVALID_INDEX)
 	{
-		node = parent;
-		parent = node->getParent();
-
-		nodeId = node->getNodeId();
+		return nodeId;
 	}
 
-	return nodeId;
+	return m_nodeIds[m_lastVisibleParentIndices[nodeIndex]];
 }
 
 size_t HierarchyCache::getIndexOfLastVisibleParentNode(Id nodeId) const
 {
-	HierarchyNode* node = nullptr;
-	HierarchyNode* parent = getNode(nodeId);
+	uint32_t nodeIndex = getNodeIndex(nodeId);
 
 	size_t idx = 0;
 	bool visible = false;
 
-	while (parent)
+	while (nodeIndex != INVALID_INDEX)
 	{
-		node = parent;
-		parent = node->getParent();
-
-		if (node->isVisible() && !idx)
+		if (isVisible(nodeIndex) && !idx)
 		{
 			visible = true;
 		}
@@ -219,6 +169,8 @@ size_t HierarchyCache::getIndexOfLastVisibleParentNode(Id nodeId) const
 		{
 			idx++;
 		}
+
+		nodeIndex = m_parentIndices[nodeIndex];
 	}
 
 	return idx;
@@ -227,92 +179,114 @@ size_t HierarchyCache::getIndexOfLastVisibleParentNode(Id nodeId) const
 void HierarchyCache::addAllVisibleParentIdsForNodeId(
 	Id nodeId, std::set<Id>* nodeIds, std::set<Id>* edgeIds) const
 {
-	HierarchyNode* node = getNode(nodeId);
+	uint32_t nodeIndex = getNodeIndex(nodeId);
 	Id edgeId = 0;
-	while (node && node->isVisible())
+	while (nodeIndex != INVALID_INDEX && isVisible(nodeIndex))
 	{
 		if (edgeId)
 		{
 			edgeIds->insert(edgeId);
 		}
 
-		nodeIds->insert(node->getNodeId());
-		edgeId = node->getEdgeId();
+		nodeIds->insert(m_nodeIds[nodeIndex]);
+		edgeId = m_edgeIds[nodeIndex];
 
-		node = node->getParent();
+		nodeIndex = m_parentIndices[nodeIndex];
 	}
 }
 
 void HierarchyCache::addAllChildIdsForNodeId(Id nodeId, std::set<Id>* nodeIds, std::set<Id>* edgeIds) const
 {
-	HierarchyNode* node = getNode(nodeId);
-	if (node && node->isVisible())
+	const uint32_t nodeIndex = getNodeIndex(nodeId);
+	if (nodeIndex == INVALID_INDEX || !isVisible(nodeIndex))
+	{
+		return;
+	}
+
+	std::vector<uint32_t> nodeIndicesToProcess = {nodeIndex};
+	while (nodeIndicesToProcess.size())
 	{
-		node->addChildIdsRecursive(nodeIds, edgeIds);
+		const uint32_t parentIndex = nodeIndicesToProcess.back();
+		nodeIndicesToProcess.pop_back();
+
+		for (uint32_t i = m_childOffsets[parentIndex]; i < m_childOffsets[parentIndex + 1]; i++)
+		{
+			const uint32_t childIndex = m_children[i];
+			nodeIds->insert(m_nodeIds[childIndex]);
+			edgeIds->insert(m_edgeIds[childIndex]);
+			nodeIndicesToProcess.push_back(childIndex);
+		}
 	}
 }
 
 void HierarchyCache::addFirstChildIdsForNodeId(
 	Id nodeId, std::vector<Id>* nodeIds, std::vector<Id>* edgeIds) const
 {
-	HierarchyNode* node = getNode(nodeId);
-	if (node)
+	const uint32_t nodeIndex = getNodeIndex(nodeId);
+	if (nodeIndex == INVALID_INDEX)
 	{
-		if (node->isImplicit())
-		{
-			node->addChildIds(nodeIds, edgeIds);
-		}
-		else
+		return;
+	}
+
+	const bool addImplicitChildren = isImplicit(nodeIndex);
+	for (uint32_t i = m_childOffsets[nodeIndex]; i < m_childOffsets[nodeIndex + 1]; i++)
+	{
+		const uint32_t childIndex = m_children[i];
+		if (addImplicitChildren || !isImplicit(childIndex))
 		{
-			node->addNonImplicitChildIds(nodeIds, edgeIds);
+			nodeIds->push_back(m_nodeIds[childIndex]);
+			edgeIds->push_back(m_edgeIds[childIndex]);
 		}
 	}
 }
 
 size_t HierarchyCache::getFirstChildIdsCountForNodeId(Id nodeId) const
 {
-	HierarchyNode* node = getNode(nodeId);
-	if (node)
+	const uint32_t nodeIndex = getNodeIndex(nodeId);
+	if (nodeIndex == INVALID_INDEX)
 	{
-		if (node->isImplicit())
-		{
-			return node->getChildrenCount();
-		}
-		else
+		return 0;
+	}
+
+	if (isImplicit(nodeIndex))
+	{
+		return m_childOffsets[nodeIndex + 1] - m_childOffsets[nodeIndex];
+	}
+
+	size_t count = 0;
+	for (uint32_t i = m_childOffsets[nodeIndex]; i < m_childOffsets[nodeIndex + 1]; i++)
+	{
+		if (!isImplicit(m_children[i]))
 		{
-			return node->getNonImplicitChildrenCount();
+			count++;
 		}
 	}
-	return 0;
+	return count;
 }
 
 bool HierarchyCache::isChildOfVisibleNodeOrInvisible(Id nodeId) const
 {
-	HierarchyNode* node = getNode(nodeId);
-	if (!node)
+	const uint32_t nodeIndex = getNodeIndex(nodeId);
+	if (nodeIndex == INVALID_INDEX)
 	{
 		return false;
 	}
 
-	if (!node->isVisible())
-	{
-		return true;
-	}
-
-	if (node->getParent() && node->getParent()->isVisible())
+	if (!isVisible(nodeIndex))
 	{
 		return true;
 	}
 
-	return false;
+	const uint32_t parentIndex = m_parentIndices[nodeIndex];
+	return parentIndex != INVALID_INDEX && isVisible(parentIndex);
 }
 
 bool HierarchyCache::nodeHasChildren(Id nodeId) const
 {
-	HierarchyNode* node = getNode(nodeId);
-	if (node)
+	const uint32_t nodeIndex = getNodeIndex(nodeId);
+	if (nodeIndex != INVALID_INDEX)
 	{
-		return node->getChildrenCount();
+		return m_childOffsets[nodeIndex + 1] != m_childOffsets[nodeIndex];
 	}
 
 	return false;
@@ -320,10 +294,10 @@ bool HierarchyCache::nodeHasChildren(Id nodeId) const
 
 bool HierarchyCache::nodeIsVisible(Id nodeId) const
 {
-	HierarchyNode* node = getNode(nodeId);
-	if (node)
+	const uint32_t nodeIndex = getNodeIndex(nodeId);
+	if (nodeIndex != INVALID_INDEX)
 	{
-		return node->isVisible();
+		return isVisible(nodeIndex);
 	}
 
 	return false;
@@ -331,10 +305,10 @@ bool HierarchyCache::nodeIsVisible(Id nodeId) const
 
 bool HierarchyCache::nodeIsImplicit(Id nodeId) const
 {
-	HierarchyNode* node = getNode(nodeId);
-	if (node)
+	const uint32_t nodeIndex = getNodeIndex(nodeId);
+	if (nodeIndex != INVALID_INDEX)
 	{
-		return node->isImplicit();
+		return isImplicit(nodeIndex);
 	}
 
 	return false;
@@ -345,35 +319,91 @@ std::vector<std::tuple<Id, Id, std::vector<Id>>> HierarchyCache::getInheritanceE
 {
 	std::vector<std::tuple<Id, Id, std::vector<Id>>> inheritanceEdges;
 
-	HierarchyNode* node = getNode(nodeId);
-	if (node)
+	const uint32_t nodeIndex = getNodeIndex(nodeId);
+	if (nodeIndex != INVALID_INDEX)
 	{
-		node->addInheritanceEdgesRecursive(node->getNodeId(), {}, nodeIds, &inheritanceEdges);
+		addInheritanceEdgesRecursive(nodeIndex, nodeId, {}, nodeIds, &inheritanceEdges);
 	}
 
 	return inheritanceEdges;
 }
 
-HierarchyCache::HierarchyNode* HierarchyCache::getNode(Id nodeId) const
+uint32_t HierarchyCache::getNodeIndex(Id nodeId) const
+{
+	if (nodeId < m_nodeIndices.size())
+	{
+		return m_nodeIndices[nodeId];
+	}
+	return INVALID_INDEX;
+}
+
+uint32_t HierarchyCache::createNode(Id nodeId)
 {
-	auto it = m_nodes.find(nodeId);
+	if (nodeId >= m_nodeIndices.size())
+	{
+		m_nodeIndices.resize(nodeId + 1, INVALID_INDEX);
+	}
 
-	if (it != m_nodes.end())
+	if (m_nodeIndices[nodeId] == INVALID_INDEX)
 	{
-		return it->second.get();
+		m_nodeIndices[nodeId] = static_cast<uint32_t>(m_nodeIds.size());
+		m_nodeIds.push_back(nodeId);
+		m_edgeIds.push_back(0);
+		m_parentIndices.push_back(INVALID_INDEX);
+		m_flags.push_back(NODE_FLAG_VISIBLE);
 	}
 
-	return nullptr;
+	return m_nodeIndices[nodeId];
+}
+
+bool HierarchyCache::isVisible(uint32_t nodeIndex) const
+{
+	return m_flags[nodeIndex] & NODE_FLAG_VISIBLE;
 }
 
-HierarchyCache::HierarchyNode* HierarchyCache::createNode(Id nodeId)
+bool HierarchyCache::isImplicit(uint32_t nodeIndex) const
 {
-	auto it = m_nodes.find(nodeId);
+	return m_flags[nodeIndex] & NODE_FLAG_IMPLICIT;
+}
 
-	if (it == m_nodes.end())
+void HierarchyCache::setFlag(uint32_t nodeIndex, NodeFlag flag, bool value)
+{
+	if (value)
+	{
+		m_flags[nodeIndex] |= flag;
+	}
+	else
 	{
-		it = m_nodes.emplace(nodeId, std::make_unique<HierarchyNode>(nodeId)).first;
+		m_flags[nodeIndex] &= ~flag;
 	}
+}
+
+void HierarchyCache::addInheritanceEdgesRecursive(
+	uint32_t nodeIndex,
+	Id startId,
+	const std::set<Id>& inheritanceEdgeIds,
+	const std::set<Id>& nodeIds,
+	std::vector<std::tuple<Id, Id, std::vector<Id>>>* inheritanceEdges) const
+{
+	for (uint32_t i = m_baseOffsets[nodeIndex]; i < m_baseOffsets[nodeIndex + 1]; i++)
+	{
+		const Base& base = m_bases[i];
+		if (inheritanceEdgeIds.find(base.edgeId) != inheritanceEdgeIds.end())
+		{
+			continue;
+		}
+
+		const Id baseId = m_nodeIds[base.nodeIndex];
+
+		std::set<Id> inheritanceEdgeIds2 = inheritanceEdgeIds;
+		inheritanceEdgeIds2.insert(base.edgeId);
+
+		if (nodeIds.find(baseId) != nodeIds.end())
+		{
+			inheritanceEdges->push_back({startId, baseId, utility::toVector(inheritanceEdgeIds2)});
+		}
 
-	return it->second.get();
+		addInheritanceEdgesRecursive(
+			base.nodeIndex, startId, inheritanceEdgeIds2, nodeIds, inheritanceEdges);
+	}
 }
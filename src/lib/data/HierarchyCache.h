@@ -1,21 +1,25 @@
 #ifndef HIERARCHY_CACHE_H
 #define HIERARCHY_CACHE_H
 
-#include <map>
-#include <memory>
+#include <cstdint>
 #include <set>
+#include <tuple>
 #include <vector>
 
 #include "types.h"
 
+// Member hierarchy of all nodes in the index. Nodes get a dense index and their data is kept in
+// parallel arrays, children and bases are stored consecutively per node once setup is finished.
 class HierarchyCache
 {
 public:
 	void clear();
 
+	// connections and inheritances can be added in any order, queries are valid after finishSetup
 	void createConnection(
 		Id edgeId, Id fromId, Id toId, bool sourceVisible, bool sourceImplicit, bool targetImplicit);
 	void createInheritance(Id edgeId, Id fromId, Id toId);
+	void finishSetup();
 
 	Id getLastVisibleParentNodeId(Id nodeId) const;
 	size_t getIndexOfLastVisibleParentNode(Id nodeId) const;
@@ -37,61 +41,49 @@ public:
 		Id nodeId, const std::set<Id>& nodeIds) const;
 
 private:
-	class HierarchyNode
-	{
-	public:
-		HierarchyNode(Id nodeId);
-
-		Id getNodeId() const;
-
-		Id getEdgeId() const;
-		void setEdgeId(Id edgeId);
-
-		HierarchyNode* getParent() const;
-		void setParent(HierarchyNode* parent);
-
-		void addBase(HierarchyNode* base, Id edgeId);
-
-		void addChild(HierarchyNode* child);
-
-		size_t getChildrenCount() const;
-		size_t getNonImplicitChildrenCount() const;
-
-		void addChildIds(std::vector<Id>* nodeIds, std::vector<Id>* edgeIds) const;
-		void addNonImplicitChildIds(std::vector<Id>* nodeIds, std::vector<Id>* edgeIds) const;
-		void addChildIdsRecursive(std::set<Id>* nodeIds, std::set<Id>* edgeIds) const;
-
-		bool isVisible() const;
-		void setIsVisible(bool isVisible);
+	static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
 
-		bool isImplicit() const;
-		void setIsImplicit(bool isImplicit);
-
-		void addInheritanceEdgesRecursive(
-			Id startId,
-			const std::set<Id>& inheritanceEdgeIds,
-			const std::set<Id>& nodeIds,
-			std::vector<std::tuple<Id, Id, std::vector<Id>>>* inheritanceEdges);
-
-	private:
-		const Id m_nodeId;
-		Id m_edgeId;
-
-		HierarchyNode* m_parent;
-
-		std::vector<HierarchyNode*> m_bases;
-		std::vector<Id> m_baseEdgeIds;
-
-		std::vector<HierarchyNode*> m_children;
-
-		bool m_isVisible;
-		bool m_isImplicit;
+	enum NodeFlag : uint8_t
+	{
+		NODE_FLAG_VISIBLE = 1 << 0,
+		NODE_FLAG_IMPLICIT = 1 << 1
 	};
 
-	HierarchyNode* getNode(Id nodeId) const;
-	HierarchyNode* createNode(Id nodeId);
+	struct Base
+	{
+		uint32_t nodeIndex;
+		Id edgeId;
+	};
 
-	std::map<Id, std::unique_ptr<HierarchyNode>> m_nodes;
+	uint32_t getNodeIndex(Id nodeId) const;
+	uint32_t createNode(Id nodeId);
+
+	bool isVisible(uint32_t nodeIndex) const;
+	bool isImplicit(uint32_t nodeIndex) const;
+	void setFlag(uint32_t nodeIndex, NodeFlag flag, bool value);
+
+	void addInheritanceEdgesRecursive(
+		uint32_t nodeIndex,
+		Id startId,
+		const std::set<Id>& inheritanceEdgeIds,
+		const std::set<Id>& nodeIds,
+		std::vector<std::tuple<Id, Id, std::vector<Id>>>* inheritanceEdges) const;
+
+	std::vector<uint32_t> m_nodeIndices;	// indexed by node id
+	std::vector<Id> m_nodeIds;
+	std::vector<Id> m_edgeIds;	  // member edge leading to the node from its parent
+	std::vector<uint32_t> m_parentIndices;
+	std::vector<uint32_t> m_lastVisibleParentIndices;
+	std::vector<uint8_t> m_flags;
+
+	std::vector<uint32_t> m_childOffsets;
+	std::vector<uint32_t> m_children;
+	std::vector<uint32_t> m_baseOffsets;
+	std::vector<Base> m_bases;
+
+	// connections added before finishSetup, as pairs of parent and child or derived and base
+	std::vector<std::pair<uint32_t, uint32_t>> m_pendingChildren;
+	std::vector<std::pair<uint32_t, Base>> m_pendingBases;
 };
 
 #endif	  // HIERARCHY_CACHE_H
@@ -2,6 +2,7 @@
 
 #include "Blackboard.h"
 #include "DialogView.h"
+#include "IndexingProfile.h"
 #include "MessageIndexingFinished.h"
 #include "MessageIndexingStatus.h"
 #include "MessageStatus.h"
@@ -32,6 +33,27 @@ Task::TaskState TaskFinishParsing::doUpdate(std::shared_ptr<Blackboard> blackboa
 {
 	TimeStamp start = TimeStamp::now();
 
+	if (blackboard->exists("indexing_durations"))
+	{
+		std::map<FilePath, size_t> indexingDurations;
+		blackboard->get("indexing_durations", indexingDurations);
+		m_storage->setIndexingDurations(indexingDurations);
+	}
+
+	if (IndexingProfile::isEnabled() && blackboard->exists("indexing_phase_durations"))
+	{
+		std::map<FilePath, std::map<std::string, size_t>> indexingPhaseDurations;
+		blackboard->get("indexing_phase_durations", indexingPhaseDurations);
+
+		// injection is not attributable to single translation units and is stored for the whole run
+		float injectionTime = 0;
+		blackboard->get("injection_time", injectionTime);
+		indexingPhaseDurations[FilePath()]["storage injection"] =
+			static_cast<size_t>(injectionTime * 1000);
+
+		m_storage->setIndexingPhaseDurations(indexingPhaseDurations);
+	}
+
 	m_dialogView->showUnknownProgressDialog(L"Finish Indexing", L"Optimizing database");
 	m_storage->optimizeMemory();
 	m_dialogView->hideUnknownProgressDialog();
@@ -1,7 +1,9 @@
 #include "TaskInjectStorage.h"
 
+#include "Blackboard.h"
 #include "Storage.h"
 #include "StorageProvider.h"
+#include "TimeStamp.h"
 
 TaskInjectStorage::TaskInjectStorage(
 	std::shared_ptr<StorageProvider> storageProvider, std::weak_ptr<Storage> target)
@@ -13,20 +15,49 @@ void TaskInjectStorage::doEnter(std::shared_ptr<Blackboard> blackboard) {}
 
 Task::TaskState TaskInjectStorage::doUpdate(std::shared_ptr<Blackboard> blackboard)
 {
-	if (m_storageProvider->getStorageCount() > 0)
+	std::shared_ptr<Storage> target = m_target.lock();
+	if (!target)
 	{
-		std::shared_ptr<IntermediateStorage> source = m_storageProvider->consumeLargestStorage();
-		if (source)
+		return STATE_FAILURE;
+	}
+
+	// only the batch that was already prepared when indexing got interrupted is dropped, storages
+	// of translation units that finished afterwards are still injected
+	if (m_interrupted.exchange(false))
+	{
+		discardNextBatch();
+	}
+
+	if (!m_nextBatch.valid())
+	{
+		prepareNextBatch();
+		if (!m_nextBatch.valid())
 		{
-			if (std::shared_ptr<Storage> target = m_target.lock())
-			{
-				target->inject(source.get());
-				return STATE_SUCCESS;
-			}
+			return STATE_FAILURE;
 		}
 	}
 
-	return STATE_FAILURE;
+	// keeps the source storage alive until its batch has been written
+	std::shared_ptr<IntermediateStorage> source = m_nextStorage;
+	std::shared_ptr<Storage::InjectionBatch> batch = m_nextBatch.get();
+
+	// the batch was prepared before indexing got interrupted
+	if (m_interrupted.exchange(false))
+	{
+		m_nextStorage.reset();
+		return STATE_SUCCESS;
+	}
+
+	prepareNextBatch();
+
+	TimeStamp start = TimeStamp::now();
+	target->inject(*batch);
+
+	float duration = static_cast<float>(TimeStamp::durationSeconds(start));
+	blackboard->update<float>(
+		"injection_time", [duration](float currentDuration) { return currentDuration + duration; });
+
+	return STATE_SUCCESS;
 }
 
 void TaskInjectStorage::doExit(std::shared_ptr<Blackboard> blackboard) {}
@@ -35,5 +66,27 @@ void TaskInjectStorage::doReset(std::shared_ptr<Blackboard> blackboard) {}
 
 void TaskInjectStorage::handleMessage(MessageIndexingInterrupted* message)
 {
+	m_interrupted = true;
 	m_storageProvider->clear();
 }
+
+void TaskInjectStorage::prepareNextBatch()
+{
+	m_nextStorage = m_storageProvider->consumeLargestStorage();
+	if (m_nextStorage)
+	{
+		m_nextBatch = std::async(
+			std::launch::async, &Storage::prepareInjection, m_nextStorage.get());
+	}
+}
+
+void TaskInjectStorage::discardNextBatch()
+{
+	if (m_nextBatch.valid())
+	{
+		// waits for the preparation to finish before the source storage is released
+		m_nextBatch.wait();
+		m_nextBatch = std::future<std::shared_ptr<Storage::InjectionBatch>>();
+	}
+	m_nextStorage.reset();
+}
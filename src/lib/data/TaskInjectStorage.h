@@ -1,13 +1,16 @@
 #ifndef TASK_INJECT_STORAGE_H
 #define TASK_INJECT_STORAGE_H
 
+#include <atomic>
+#include <future>
 #include <vector>
 
 #include "MessageIndexingInterrupted.h"
 #include "MessageListener.h"
+#include "Storage.h"
 #include "Task.h"
 
-class Storage;
+class IntermediateStorage;
 class StorageProvider;
 
 class TaskInjectStorage
@@ -25,8 +28,18 @@ private:
 
 	void handleMessage(MessageIndexingInterrupted* message) override;
 
+	void prepareNextBatch();
+	void discardNextBatch();
+
 	std::shared_ptr<StorageProvider> m_storageProvider;
 	std::weak_ptr<Storage> m_target;
+
+	// the next storage is prepared for injection while the current one is written to the target
+	std::shared_ptr<IntermediateStorage> m_nextStorage;
+	std::future<std::shared_ptr<Storage::InjectionBatch>> m_nextBatch;
+
+	// set when indexing got interrupted, cleared once the batch prepared at that time is dropped
+	std::atomic<bool> m_interrupted = false;
 };
 
 #endif	  // TASK_INJECT_STORAGE_H
@@ -11,27 +11,17 @@ void TaskMergeStorages::doEnter(std::shared_ptr<Blackboard> blackboard) {}
 
 Task::TaskState TaskMergeStorages::doUpdate(std::shared_ptr<Blackboard> blackboard)
 {
-	if (m_storageProvider->getStorageCount() > 2)	 // largest storage won't be touched here
+	// several merge tasks may run concurrently, each of them consumes its own pair of storages
+	std::pair<std::shared_ptr<IntermediateStorage>, std::shared_ptr<IntermediateStorage>> storages =
+		m_storageProvider->consumeStoragesToMerge();	// largest storage won't be touched here
+
+	std::shared_ptr<IntermediateStorage> target = storages.first;
+	std::shared_ptr<IntermediateStorage> source = storages.second;
+	if (target && source)
 	{
-		std::shared_ptr<IntermediateStorage> target = m_storageProvider->consumeSecondLargestStorage();
-		std::shared_ptr<IntermediateStorage> source = m_storageProvider->consumeSecondLargestStorage();
-		if (target && source)
-		{
-			target->inject(source.get());
-			m_storageProvider->insert(target);
-			return STATE_SUCCESS;
-		}
-		else
-		{
-			if (target)
-			{
-				m_storageProvider->insert(target);
-			}
-			if (source)
-			{
-				m_storageProvider->insert(source);
-			}
-		}
+		target->inject(source.get());
+		m_storageProvider->insert(target);
+		return STATE_SUCCESS;
 	}
 
 	return STATE_FAILURE;
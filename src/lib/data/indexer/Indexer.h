@@ -18,6 +18,9 @@ public:
 	std::shared_ptr<IntermediateStorage> index(std::shared_ptr<IndexerCommand> indexerCommand) override;
 	void interrupt() override;
 
+	void setSkippedHeaderFilePaths(const std::set<FilePath>& filePaths) override;
+	std::set<FilePath> getGuardedHeaderFilePaths() const override;
+
 private:
 	virtual void doIndex(
 		std::shared_ptr<T> indexerCommand,
@@ -46,6 +49,18 @@ void Indexer<T>::interrupt()
 	m_indexerStateInfo->indexingInterrupted = true;
 }
 
+template <typename T>
+void Indexer<T>::setSkippedHeaderFilePaths(const std::set<FilePath>& filePaths)
+{
+	m_indexerStateInfo->skippedHeaderFilePaths = filePaths;
+}
+
+template <typename T>
+std::set<FilePath> Indexer<T>::getGuardedHeaderFilePaths() const
+{
+	return m_indexerStateInfo->guardedHeaderFilePaths;
+}
+
 template <typename T>
 std::shared_ptr<IntermediateStorage> Indexer<T>::index(std::shared_ptr<IndexerCommand> indexerCommand)
 {
@@ -61,6 +76,8 @@ std::shared_ptr<IntermediateStorage> Indexer<T>::index(std::shared_ptr<IndexerCo
 		return nullptr;
 	}
 
+	m_indexerStateInfo->guardedHeaderFilePaths.clear();
+
 	std::shared_ptr<IntermediateStorage> storage = std::make_shared<IntermediateStorage>();
 	std::shared_ptr<ParserClientImpl> parserClient = std::make_shared<ParserClientImpl>(storage.get());
 
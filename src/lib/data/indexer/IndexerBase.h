@@ -2,10 +2,12 @@
 #define INDEXER_BASE_H
 
 #include <memory>
+#include <set>
 #include <string>
 
 #include "IndexerCommandType.h"
 
+class FilePath;
 class FileRegister;
 class IndexerCommand;
 class IntermediateStorage;
@@ -20,6 +22,11 @@ public:
 	virtual std::shared_ptr<IntermediateStorage> index(
 		std::shared_ptr<IndexerCommand> indexerCommand) = 0;
 	virtual void interrupt() = 0;
+
+	// headers passed here are skipped by subsequent calls to index()
+	virtual void setSkippedHeaderFilePaths(const std::set<FilePath>& filePaths) = 0;
+	// returns the include guarded project headers of the last call to index()
+	virtual std::set<FilePath> getGuardedHeaderFilePaths() const = 0;
 };
 
 #endif	  // INDEXER_BASE_H
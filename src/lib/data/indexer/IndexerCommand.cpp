@@ -25,6 +25,11 @@ const FilePath& IndexerCommand::getSourceFilePath() const
 	return m_sourceFilePath;
 }
 
+std::wstring IndexerCommand::getPreprocessorContext() const
+{
+	return L"";
+}
+
 QJsonObject IndexerCommand::doSerialize() const
 {
 	QJsonObject jsonObject;
@@ -25,6 +25,10 @@ public:
 
 	const FilePath& getSourceFilePath() const;
 
+	// identifies the preprocessor setup of this command, headers are only indexed once for each
+	// context; an empty context disables skipping of already indexed headers
+	virtual std::wstring getPreprocessorContext() const;
+
 protected:
 	virtual QJsonObject doSerialize() const;
 
@@ -3,6 +3,7 @@
 #include "IndexerCommand.h"
 #include "IntermediateStorage.h"
 #include "logging.h"
+#include "utility.h"
 
 IndexerComposite::~IndexerComposite() {}
 
@@ -37,3 +38,21 @@ void IndexerComposite::interrupt()
 		it.second->interrupt();
 	}
 }
+
+void IndexerComposite::setSkippedHeaderFilePaths(const std::set<FilePath>& filePaths)
+{
+	for (auto& it: m_indexers)
+	{
+		it.second->setSkippedHeaderFilePaths(filePaths);
+	}
+}
+
+std::set<FilePath> IndexerComposite::getGuardedHeaderFilePaths() const
+{
+	std::set<FilePath> filePaths;
+	for (auto& it: m_indexers)
+	{
+		utility::append(filePaths, it.second->getGuardedHeaderFilePaths());
+	}
+	return filePaths;
+}
@@ -19,6 +19,9 @@ public:
 
 	void interrupt() override;
 
+	void setSkippedHeaderFilePaths(const std::set<FilePath>& filePaths) override;
+	std::set<FilePath> getGuardedHeaderFilePaths() const override;
+
 private:
 	std::map<IndexerCommandType, std::shared_ptr<IndexerBase>> m_indexers;
 };
@@ -1,10 +1,20 @@
 #ifndef INDEXER_STATE_INFO_H
 #define INDEXER_STATE_INFO_H
 
+#include <set>
+
+#include "FilePath.h"
+
 struct IndexerStateInfo
 {
 public:
 	bool indexingInterrupted;
+
+	// project headers already indexed by another translation unit, these are not indexed again
+	std::set<FilePath> skippedHeaderFilePaths;
+
+	// include guarded project headers encountered while indexing the current translation unit
+	std::set<FilePath> guardedHeaderFilePaths;
 };
 
 #endif	  // INDEXER_STATE_INFO_H
@@ -0,0 +1,170 @@
+#include "IndexingProfile.h"
+
+#include <algorithm>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include "utilityString.h"
+
+std::string indexingPhaseToString(IndexingPhase phase)
+{
+	switch (phase)
+	{
+	case INDEXING_PHASE_FRONTEND:
+		return "clang frontend";
+	case INDEXING_PHASE_PREPROCESSOR:
+		return "preprocessor callbacks";
+	case INDEXING_PHASE_TRAVERSAL:
+		return "ast traversal";
+	case INDEXING_PHASE_NAME_RESOLUTION:
+		return "name resolution";
+	case INDEXING_PHASE_STORAGE:
+		return "intermediate storage";
+	case INDEXING_PHASE_IPC:
+		return "ipc push";
+	default:
+		break;
+	}
+	return "other";
+}
+
+std::atomic<bool> IndexingProfile::s_enabled = false;
+
+IndexingProfile::ScopedPhase::ScopedPhase(IndexingPhase phase)
+	: m_profile(nullptr), m_parentPhase(INDEXING_PHASE_OTHER)
+{
+	if (s_enabled.load(std::memory_order_relaxed))
+	{
+		m_profile = &IndexingProfile::getCurrent();
+		m_parentPhase = m_profile->switchPhase(phase);
+	}
+}
+
+IndexingProfile::ScopedPhase::~ScopedPhase()
+{
+	if (m_profile)
+	{
+		m_profile->switchPhase(m_parentPhase);
+	}
+}
+
+void IndexingProfile::setEnabled(bool enabled)
+{
+	s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool IndexingProfile::isEnabled()
+{
+	return s_enabled.load(std::memory_order_relaxed);
+}
+
+IndexingProfile& IndexingProfile::getCurrent()
+{
+	static thread_local IndexingProfile s_profile;
+	return s_profile;
+}
+
+std::string IndexingProfile::createReport(
+	const std::map<FilePath, std::map<std::string, size_t>>& phaseDurations, size_t fileCount)
+{
+	typedef std::pair<size_t, const FilePath*> FileDuration;
+
+	std::vector<FileDuration> fileDurations;
+	std::map<std::string, size_t> phaseTotals;
+	size_t total = 0;
+
+	for (const auto& p: phaseDurations)
+	{
+		size_t fileDuration = 0;
+		for (const auto& phase: p.second)
+		{
+			fileDuration += phase.second;
+			phaseTotals[phase.first] += phase.second;
+		}
+		total += fileDuration;
+
+		// run level phases are stored without a file path
+		if (!p.first.empty())
+		{
+			fileDurations.emplace_back(fileDuration, &p.first);
+		}
+	}
+
+	std::sort(fileDurations.begin(), fileDurations.end(), std::greater<FileDuration>());
+	fileDurations.resize(std::min(fileDurations.size(), fileCount));
+
+	std::stringstream ss;
+	ss << "Slowest translation units:\n";
+	for (const FileDuration& p: fileDurations)
+	{
+		ss << std::setw(10) << p.first << " ms  " << utility::encodeToUtf8(p.second->wstr())
+		   << '\n';
+		for (const auto& phase: phaseDurations.find(*p.second)->second)
+		{
+			ss << std::setw(20) << phase.second << " ms  " << phase.first << '\n';
+		}
+	}
+
+	ss << "\nTotal time per phase:\n";
+	for (const auto& phase: phaseTotals)
+	{
+		ss << std::setw(10) << phase.second << " ms  " << std::setw(5) << std::fixed
+		   << std::setprecision(1) << (total ? 100.0 * phase.second / total : 0.0) << " %  "
+		   << phase.first << '\n';
+	}
+	ss << std::setw(10) << total << " ms  total\n";
+
+	return ss.str();
+}
+
+IndexingProfile::IndexingProfile()
+{
+	clear();
+}
+
+void IndexingProfile::clear()
+{
+	std::fill(std::begin(m_durations), std::end(m_durations), Clock::duration::zero());
+	m_currentPhase = INDEXING_PHASE_OTHER;
+	m_lastSwitchTime = Clock::now();
+}
+
+std::map<std::string, size_t> IndexingProfile::getPhaseDurations() const
+{
+	std::map<std::string, size_t> phaseDurations;
+	if (!isEnabled())
+	{
+		return phaseDurations;
+	}
+
+	for (int i = 0; i < INDEXING_PHASE_COUNT; i++)
+	{
+		Clock::duration duration = m_durations[i];
+		if (i == m_currentPhase)
+		{
+			duration += Clock::now() - m_lastSwitchTime;
+		}
+
+		const size_t ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+		if (ms > 0)
+		{
+			phaseDurations[indexingPhaseToString(IndexingPhase(i))] = ms;
+		}
+	}
+	return phaseDurations;
+}
+
+IndexingPhase IndexingProfile::switchPhase(IndexingPhase phase)
+{
+	const IndexingPhase previousPhase = m_currentPhase;
+	if (phase != previousPhase)
+	{
+		const Clock::time_point now = Clock::now();
+		m_durations[previousPhase] += now - m_lastSwitchTime;
+		m_lastSwitchTime = now;
+		m_currentPhase = phase;
+	}
+	return previousPhase;
+}
@@ -0,0 +1,72 @@
+#ifndef INDEXING_PROFILE_H
+#define INDEXING_PROFILE_H
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <string>
+
+#include "FilePath.h"
+
+enum IndexingPhase
+{
+	INDEXING_PHASE_OTHER,
+	INDEXING_PHASE_FRONTEND,
+	INDEXING_PHASE_PREPROCESSOR,
+	INDEXING_PHASE_TRAVERSAL,
+	INDEXING_PHASE_NAME_RESOLUTION,
+	INDEXING_PHASE_STORAGE,
+	INDEXING_PHASE_IPC,
+	INDEXING_PHASE_COUNT
+};
+
+std::string indexingPhaseToString(IndexingPhase phase);
+
+// Records how the indexing time of a single translation unit is spent. Phases are timed
+// exclusively: entering a nested phase pauses the enclosing one until the nested phase is left.
+// Every indexer thread uses its own profile, so recording is lock free. Phases are only recorded
+// while profiling is enabled, otherwise a ScopedPhase only checks the flag.
+class IndexingProfile
+{
+public:
+	class ScopedPhase
+	{
+	public:
+		ScopedPhase(IndexingPhase phase);
+		~ScopedPhase();
+
+	private:
+		IndexingProfile* m_profile;
+		IndexingPhase m_parentPhase;
+	};
+
+	static void setEnabled(bool enabled);
+	static bool isEnabled();
+
+	static IndexingProfile& getCurrent();
+
+	// creates a human readable report of the slowest translation units and the totals per phase
+	static std::string createReport(
+		const std::map<FilePath, std::map<std::string, size_t>>& phaseDurations, size_t fileCount);
+
+	IndexingProfile();
+
+	void clear();
+
+	// returns the durations in milliseconds of all phases that took time since the last clear, or
+	// nothing if profiling is disabled
+	std::map<std::string, size_t> getPhaseDurations() const;
+
+private:
+	typedef std::chrono::steady_clock Clock;
+
+	static std::atomic<bool> s_enabled;
+
+	IndexingPhase switchPhase(IndexingPhase phase);
+
+	Clock::duration m_durations[INDEXING_PHASE_COUNT];
+	IndexingPhase m_currentPhase;
+	Clock::time_point m_lastSwitchTime;
+};
+
+#endif	  // INDEXING_PROFILE_H
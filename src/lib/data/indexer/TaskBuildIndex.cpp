@@ -4,6 +4,7 @@
 #include "Blackboard.h"
 #include "DialogView.h"
 #include "FileLogger.h"
+#include "IndexingProfile.h"
 #include "InterprocessIndexer.h"
 #include "MessageIndexingStatus.h"
 #include "MessageStatus.h"
@@ -35,8 +36,14 @@ TaskBuildIndex::TaskBuildIndex(
 void TaskBuildIndex::doEnter(std::shared_ptr<Blackboard> blackboard)
 {
 	m_interprocessIndexingStatusManager.setIndexingInterrupted(false);
+	m_interprocessIndexingStatusManager.setIndexerCommandQueueStopped(false);
+	m_interprocessIndexingStatusManager.setIndexingProfileEnabled(IndexingProfile::isEnabled());
+	// headers may have changed since they were registered by a previous indexing run
+	m_interprocessIndexingStatusManager.clearIndexedHeaderFilePaths();
 
 	m_indexingFileCount = 0;
+	m_indexingDurations.clear();
+	m_indexingPhaseDurations.clear();
 	updateIndexingDialog(blackboard, std::vector<FilePath>());
 
 	std::wstring logFilePath;
@@ -83,6 +90,10 @@ Task::TaskState TaskBuildIndex::doUpdate(std::shared_ptr<Blackboard> blackboard)
 	}
 
 	blackboard->get<bool>("indexer_command_queue_stopped", m_indexerCommandQueueStopped);
+	if (m_indexerCommandQueueStopped)
+	{
+		m_interprocessIndexingStatusManager.setIndexerCommandQueueStopped(true);
+	}
 
 	const std::vector<FilePath> indexingFiles =
 		m_interprocessIndexingStatusManager.getCurrentlyIndexedSourceFilePaths();
@@ -91,6 +102,15 @@ Task::TaskState TaskBuildIndex::doUpdate(std::shared_ptr<Blackboard> blackboard)
 		updateIndexingDialog(blackboard, indexingFiles);
 	}
 
+	for (const auto& p: m_interprocessIndexingStatusManager.getIndexingDurations())
+	{
+		m_indexingDurations[p.first] = p.second;
+	}
+	for (auto& p: m_interprocessIndexingStatusManager.getIndexingPhaseDurations())
+	{
+		m_indexingPhaseDurations[p.first] = std::move(p.second);
+	}
+
 	if (m_indexerCommandQueueStopped && runningThreadCount == 0)
 	{
 		LOG_INFO_STREAM(<< "command queue stopped and no running threads. done.");
@@ -154,6 +174,17 @@ void TaskBuildIndex::doExit(std::shared_ptr<Blackboard> blackboard)
 		m_storageProvider->insert(storage);
 	}
 
+	for (const auto& p: m_interprocessIndexingStatusManager.getIndexingDurations())
+	{
+		m_indexingDurations[p.first] = p.second;
+	}
+	for (auto& p: m_interprocessIndexingStatusManager.getIndexingPhaseDurations())
+	{
+		m_indexingPhaseDurations[p.first] = std::move(p.second);
+	}
+	blackboard->set("indexing_durations", m_indexingDurations);
+	blackboard->set("indexing_phase_durations", m_indexingPhaseDurations);
+
 	blackboard->set<bool>("indexer_threads_stopped", true);
 }
 
@@ -162,6 +193,7 @@ void TaskBuildIndex::doReset(std::shared_ptr<Blackboard> blackboard) {}
 void TaskBuildIndex::terminate()
 {
 	m_interrupted = true;
+	m_interprocessIndexingStatusManager.setIndexerCommandQueueStopped(true);
 	utility::killRunningProcesses();
 }
 
@@ -238,8 +270,11 @@ bool TaskBuildIndex::fetchIntermediateStorages(std::shared_ptr<Blackboard> black
 {
 	int poppedStorageCount = 0;
 
+	// storages are merged in parallel, so the queue may grow with the number of indexers before
+	// fetching needs to wait for merging and injection to catch up
+	const int maxQueuedStorageCount = std::max<int>(10, 2 * static_cast<int>(m_processCount));
 	int providerStorageCount = m_storageProvider->getStorageCount();
-	if (providerStorageCount > 10)
+	if (providerStorageCount > maxQueuedStorageCount)
 	{
 		LOG_INFO_STREAM(<< "waiting, too many storages queued: " << providerStorageCount);
 
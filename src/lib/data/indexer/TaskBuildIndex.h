@@ -1,6 +1,7 @@
 #ifndef TASK_BUILD_INDEX_H
 #define TASK_BUILD_INDEX_H
 
+#include <map>
 #include <thread>
 
 #include "MessageIndexingInterrupted.h"
@@ -55,6 +56,8 @@ protected:
 	size_t m_processCount;
 	bool m_interrupted;
 	size_t m_indexingFileCount;
+	std::map<FilePath, size_t> m_indexingDurations;
+	std::map<FilePath, std::map<std::string, size_t>> m_indexingPhaseDurations;
 
 	// store as plain pointers to avoid deallocation issues when closing app during indexing
 	std::vector<std::thread*> m_processThreads;
@@ -9,10 +9,12 @@
 TaskFillIndexerCommandsQueue::TaskFillIndexerCommandsQueue(
 	const std::string& appUUID,
 	std::unique_ptr<IndexerCommandProvider> indexerCommandProvider,
-	size_t maximumQueueSize)
+	size_t maximumQueueSize,
+	std::map<FilePath, size_t> indexingDurations)
 	: m_indexerCommandProvider(std::move(indexerCommandProvider))
 	, m_indexerCommandManager(appUUID, 0, true)
 	, m_maximumQueueSize(maximumQueueSize)
+	, m_indexingDurations(std::move(indexingDurations))
 {
 }
 
@@ -20,8 +22,10 @@ void TaskFillIndexerCommandsQueue::doEnter(std::shared_ptr<Blackboard> blackboar
 {
 	{
 		std::lock_guard<std::mutex> lock(m_commandsMutex);
-		for (const FilePath& filePath:
-			 utility::partitionFilePathsBySize(m_indexerCommandProvider->getAllSourceFilePaths(), 2))
+		// all indexers pull from the same shared command queue, so dispatching the most expensive
+		// files first keeps a single large translation unit from running long after the others
+		for (const FilePath& filePath: utility::orderFilePathsByPredictedCost(
+				 m_indexerCommandProvider->getAllSourceFilePaths(), m_indexingDurations))
 		{
 			m_filePathQueue.emplace(filePath);
 		}
@@ -1,6 +1,7 @@
 #ifndef TASK_FILL_INDEXER_COMMAND_QUEUE_H
 #define TASK_FILL_INDEXER_COMMAND_QUEUE_H
 
+#include <map>
 #include <queue>
 
 #include "MessageIndexingInterrupted.h"
@@ -19,7 +20,8 @@ public:
 	TaskFillIndexerCommandsQueue(
 		const std::string& appUUID,
 		std::unique_ptr<IndexerCommandProvider> indexerCommandProvider,
-		size_t maximumQueueSize);
+		size_t maximumQueueSize,
+		std::map<FilePath, size_t> indexingDurations = std::map<FilePath, size_t>());
 
 protected:
 	void doEnter(std::shared_ptr<Blackboard> blackboard) override;
@@ -38,6 +40,9 @@ private:
 
 	const size_t m_maximumQueueSize;
 
+	// indexing durations in milliseconds from previous runs, used to dispatch expensive files first
+	const std::map<FilePath, size_t> m_indexingDurations;
+
 	std::queue<FilePath> m_filePathQueue;
 	std::mutex m_commandsMutex;
 
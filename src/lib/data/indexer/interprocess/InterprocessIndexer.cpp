@@ -1,8 +1,11 @@
 #include "InterprocessIndexer.h"
 
+#include "ApplicationSettings.h"
 #include "FileRegister.h"
 #include "IndexerCommand.h"
 #include "IndexerComposite.h"
+#include "IndexingProfile.h"
+#include "IntermediateStorage.h"
 #include "LanguagePackageManager.h"
 #include "ScopedFunctor.h"
 #include "logging.h"
@@ -27,6 +30,12 @@ void InterprocessIndexer::work()
 		LOG_INFO_STREAM(<< m_processId << " starting up indexer");
 		indexer = LanguagePackageManager::getInstance()->instantiateSupportedIndexers();
 
+		const bool skipIndexedHeaders =
+			ApplicationSettings::getInstance()->getSkipIndexedHeadersEnabled();
+
+		IndexingProfile::setEnabled(
+			m_interprocessIndexingStatusManager.getIndexingProfileEnabled());
+
 		updaterThread = std::make_shared<std::thread>([&]() {
 			while (updaterThreadRunning)
 			{
@@ -53,8 +62,30 @@ void InterprocessIndexer::work()
 			}
 		});
 
-		while (std::shared_ptr<IndexerCommand> indexerCommand =
-				   m_interprocessIndexerCommandManager.popIndexerCommand())
+		// keep waiting while the command queue gets refilled instead of returning, so the parser
+		// setup and the caches of this indexer are reused for all of its translation units
+		auto fetchIndexerCommand = [&]() -> std::shared_ptr<IndexerCommand> {
+			while (updaterThreadRunning)
+			{
+				const bool commandQueueStopped =
+					m_interprocessIndexingStatusManager.getIndexerCommandQueueStopped();
+
+				if (std::shared_ptr<IndexerCommand> indexerCommand =
+						m_interprocessIndexerCommandManager.popIndexerCommand())
+				{
+					return indexerCommand;
+				}
+				else if (commandQueueStopped)
+				{
+					break;
+				}
+
+				std::this_thread::sleep_for(std::chrono::milliseconds(50));
+			}
+			return nullptr;
+		};
+
+		while (std::shared_ptr<IndexerCommand> indexerCommand = fetchIndexerCommand())
 		{
 			LOG_INFO_STREAM(
 				<< m_processId << " fetched indexer command for \""
@@ -86,17 +117,47 @@ void InterprocessIndexer::work()
 			m_interprocessIndexingStatusManager.startIndexingSourceFile(
 				indexerCommand->getSourceFilePath());
 
+			const std::wstring preprocessorContext = skipIndexedHeaders
+				? indexerCommand->getPreprocessorContext()
+				: L"";
+			indexer->setSkippedHeaderFilePaths(
+				preprocessorContext.empty()
+					? std::set<FilePath>()
+					: m_interprocessIndexingStatusManager.getIndexedHeaderFilePaths(
+						  preprocessorContext));
+
 			LOG_INFO_STREAM(<< m_processId << " starting to index current file");
+			IndexingProfile& profile = IndexingProfile::getCurrent();
+			profile.clear();
 			std::shared_ptr<IntermediateStorage> result = indexer->index(indexerCommand);
 
 			if (result)
 			{
 				LOG_INFO_STREAM(<< m_processId << " pushing index to shared memory");
+				IndexingProfile::ScopedPhase profilePhase(INDEXING_PHASE_IPC);
 				m_interprocessIntermediateStorageManager.pushIntermediateStorage(result);
+
+				if (!preprocessorContext.empty())
+				{
+					// only headers without errors are shared, other translation units may still
+					// succeed in indexing them completely
+					std::set<FilePath> indexedHeaderFilePaths =
+						indexer->getGuardedHeaderFilePaths();
+					for (const StorageFile& file: result->getStorageFiles())
+					{
+						if (!file.complete)
+						{
+							indexedHeaderFilePaths.erase(FilePath(file.filePath));
+						}
+					}
+					m_interprocessIndexingStatusManager.addIndexedHeaderFilePaths(
+						preprocessorContext, indexedHeaderFilePaths);
+				}
 			}
 
 			LOG_INFO_STREAM(<< m_processId << " finalizing indexer status for current file");
-			m_interprocessIndexingStatusManager.finishIndexingSourceFile();
+			m_interprocessIndexingStatusManager.finishIndexingSourceFile(
+				profile.getPhaseDurations());
 
 			LOG_INFO_STREAM(<< m_processId << " all done");
 		}
@@ -11,6 +11,14 @@ const char* InterprocessIndexingStatusManager::s_crashedFilesKeyName = "crashed_
 const char* InterprocessIndexingStatusManager::s_finishedProcessIdsKeyName = "finished_process_ids";
 const char* InterprocessIndexingStatusManager::s_indexingInterruptedKeyName =
 	"indexing_interrupted_flag";
+const char* InterprocessIndexingStatusManager::s_indexerCommandQueueStoppedKeyName =
+	"indexer_command_queue_stopped_flag";
+const char* InterprocessIndexingStatusManager::s_indexingProfileEnabledKeyName =
+	"indexing_profile_enabled_flag";
+const char* InterprocessIndexingStatusManager::s_indexingDurationsKeyName = "indexing_durations";
+const char* InterprocessIndexingStatusManager::s_indexingPhaseDurationsKeyName =
+	"indexing_phase_durations";
+const char* InterprocessIndexingStatusManager::s_indexedHeadersKeyName = "indexed_headers";
 
 InterprocessIndexingStatusManager::InterprocessIndexingStatusManager(
 	const std::string& instanceUuid, Id processId, bool isOwner)
@@ -23,6 +31,8 @@ InterprocessIndexingStatusManager::~InterprocessIndexingStatusManager() {}
 
 void InterprocessIndexingStatusManager::startIndexingSourceFile(const FilePath& filePath)
 {
+	m_indexingStartTime = TimeStamp::now();
+
 	SharedMemory::ScopedAccess access(&m_sharedMemory);
 
 	SharedMemory::Queue<SharedMemory::String>* indexingFilesPtr =
@@ -87,16 +97,65 @@ void InterprocessIndexingStatusManager::startIndexingSourceFile(const FilePath&
 	}
 }
 
-void InterprocessIndexingStatusManager::finishIndexingSourceFile()
+void InterprocessIndexingStatusManager::finishIndexingSourceFile(
+	const std::map<std::string, size_t>& phaseDurations)
 {
 	SharedMemory::ScopedAccess access(&m_sharedMemory);
 
+	if (!phaseDurations.empty())
+	{
+		const size_t overestimationMultiplier = 3;
+		size_t estimatedSize = 0;
+		for (const auto& p: phaseDurations)
+		{
+			estimatedSize += 1024 + sizeof(SharedMemory::String) + p.first.size();
+		}
+		estimatedSize *= overestimationMultiplier;
+
+		while (access.getFreeMemorySize() < estimatedSize)
+		{
+			LOG_INFO_STREAM(
+				<< "grow memory - est: " << estimatedSize << " size: " << access.getMemorySize()
+				<< " free: " << access.getFreeMemorySize());
+			access.growMemory(access.getMemorySize());
+		}
+	}
+
 	SharedMemory::Map<Id, SharedMemory::String>* currentFilesPtr =
 		access.accessValueWithAllocator<SharedMemory::Map<Id, SharedMemory::String>>(
 			s_currentFilesKeyName);
 	if (currentFilesPtr)
 	{
-		currentFilesPtr->erase(currentFilesPtr->find(getProcessId()), currentFilesPtr->end());
+		SharedMemory::Map<Id, SharedMemory::String>::iterator it = currentFilesPtr->find(
+			getProcessId());
+
+		SharedMemory::Map<SharedMemory::String, size_t>* durationsPtr =
+			access.accessValueWithAllocator<SharedMemory::Map<SharedMemory::String, size_t>>(
+				s_indexingDurationsKeyName);
+		if (durationsPtr && it != currentFilesPtr->end())
+		{
+			const size_t duration = TimeStamp::now().deltaMS(m_indexingStartTime);
+			durationsPtr->insert(std::pair<const SharedMemory::String, size_t>(it->second, 0))
+				.first->second = duration;
+		}
+
+		// entries are stored as "<path>\n<phase>"
+		SharedMemory::Map<SharedMemory::String, size_t>* phaseDurationsPtr =
+			access.accessValueWithAllocator<SharedMemory::Map<SharedMemory::String, size_t>>(
+				s_indexingPhaseDurationsKeyName);
+		if (phaseDurationsPtr && it != currentFilesPtr->end())
+		{
+			const std::string prefix = std::string(it->second.c_str()) + '\n';
+			for (const auto& p: phaseDurations)
+			{
+				SharedMemory::String str(access.getAllocator());
+				str = (prefix + p.first).c_str();
+				phaseDurationsPtr->insert(std::pair<const SharedMemory::String, size_t>(str, 0))
+					.first->second = p.second;
+			}
+		}
+
+		currentFilesPtr->erase(it, currentFilesPtr->end());
 	}
 
 	SharedMemory::Queue<Id>* finishedProcessIdsPtr =
@@ -131,6 +190,54 @@ bool InterprocessIndexingStatusManager::getIndexingInterrupted()
 	return false;
 }
 
+void InterprocessIndexingStatusManager::setIndexingProfileEnabled(bool enabled)
+{
+	SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+	bool* profileEnabledPtr = access.accessValue<bool>(s_indexingProfileEnabledKeyName);
+	if (profileEnabledPtr)
+	{
+		*profileEnabledPtr = enabled;
+	}
+}
+
+bool InterprocessIndexingStatusManager::getIndexingProfileEnabled()
+{
+	SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+	bool* profileEnabledPtr = access.accessValue<bool>(s_indexingProfileEnabledKeyName);
+	if (profileEnabledPtr)
+	{
+		return *profileEnabledPtr;
+	}
+
+	return false;
+}
+
+void InterprocessIndexingStatusManager::setIndexerCommandQueueStopped(bool stopped)
+{
+	SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+	bool* commandQueueStoppedPtr = access.accessValue<bool>(s_indexerCommandQueueStoppedKeyName);
+	if (commandQueueStoppedPtr)
+	{
+		*commandQueueStoppedPtr = stopped;
+	}
+}
+
+bool InterprocessIndexingStatusManager::getIndexerCommandQueueStopped()
+{
+	SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+	bool* commandQueueStoppedPtr = access.accessValue<bool>(s_indexerCommandQueueStoppedKeyName);
+	if (commandQueueStoppedPtr)
+	{
+		return *commandQueueStoppedPtr;
+	}
+
+	return true;
+}
+
 Id InterprocessIndexingStatusManager::getNextFinishedProcessId()
 {
 	SharedMemory::ScopedAccess access(&m_sharedMemory);
@@ -202,3 +309,140 @@ std::vector<FilePath> InterprocessIndexingStatusManager::getCrashedSourceFilePat
 
 	return crashedFiles;
 }
+
+std::map<FilePath, size_t> InterprocessIndexingStatusManager::getIndexingDurations()
+{
+	std::map<FilePath, size_t> durations;
+
+	SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+	SharedMemory::Map<SharedMemory::String, size_t>* durationsPtr =
+		access.accessValueWithAllocator<SharedMemory::Map<SharedMemory::String, size_t>>(
+			s_indexingDurationsKeyName);
+	if (durationsPtr)
+	{
+		for (const auto& p: *durationsPtr)
+		{
+			durations.emplace(FilePath(utility::decodeFromUtf8(p.first.c_str())), p.second);
+		}
+		durationsPtr->clear();
+	}
+
+	return durations;
+}
+
+std::map<FilePath, std::map<std::string, size_t>> InterprocessIndexingStatusManager::
+	getIndexingPhaseDurations()
+{
+	std::map<FilePath, std::map<std::string, size_t>> phaseDurations;
+
+	SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+	SharedMemory::Map<SharedMemory::String, size_t>* phaseDurationsPtr =
+		access.accessValueWithAllocator<SharedMemory::Map<SharedMemory::String, size_t>>(
+			s_indexingPhaseDurationsKeyName);
+	if (phaseDurationsPtr)
+	{
+		for (const auto& p: *phaseDurationsPtr)
+		{
+			const std::string entry = p.first.c_str();
+			const size_t pos = entry.rfind('\n');
+			if (pos != std::string::npos)
+			{
+				const FilePath filePath(utility::decodeFromUtf8(entry.substr(0, pos)));
+				phaseDurations[filePath][entry.substr(pos + 1)] = p.second;
+			}
+		}
+		phaseDurationsPtr->clear();
+	}
+
+	return phaseDurations;
+}
+
+void InterprocessIndexingStatusManager::addIndexedHeaderFilePaths(
+	const std::wstring& context, const std::set<FilePath>& filePaths)
+{
+	if (filePaths.empty())
+	{
+		return;
+	}
+
+	// entries are stored as "<context>\n<path>" to allow looking up all headers of a context
+	const std::string prefix = utility::encodeToUtf8(context) + '\n';
+
+	SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+	const size_t overestimationMultiplier = 3;
+	size_t estimatedSize = 0;
+	for (const FilePath& filePath: filePaths)
+	{
+		estimatedSize += 64 + sizeof(SharedMemory::String) + prefix.size() + filePath.wstr().size();
+	}
+	estimatedSize *= overestimationMultiplier;
+
+	while (access.getFreeMemorySize() < estimatedSize)
+	{
+		LOG_INFO_STREAM(
+			<< "grow memory - est: " << estimatedSize << " size: " << access.getMemorySize()
+			<< " free: " << access.getFreeMemorySize());
+		access.growMemory(access.getMemorySize());
+	}
+
+	SharedMemory::Set<SharedMemory::String>* indexedHeadersPtr =
+		access.accessValueWithAllocator<SharedMemory::Set<SharedMemory::String>>(
+			s_indexedHeadersKeyName);
+	if (indexedHeadersPtr)
+	{
+		for (const FilePath& filePath: filePaths)
+		{
+			SharedMemory::String str(access.getAllocator());
+			str = (prefix + utility::encodeToUtf8(filePath.wstr())).c_str();
+			indexedHeadersPtr->insert(str);
+		}
+	}
+}
+
+std::set<FilePath> InterprocessIndexingStatusManager::getIndexedHeaderFilePaths(
+	const std::wstring& context)
+{
+	std::set<FilePath> filePaths;
+
+	const std::string prefix = utility::encodeToUtf8(context) + '\n';
+
+	SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+	SharedMemory::Set<SharedMemory::String>* indexedHeadersPtr =
+		access.accessValueWithAllocator<SharedMemory::Set<SharedMemory::String>>(
+			s_indexedHeadersKeyName);
+	if (indexedHeadersPtr)
+	{
+		SharedMemory::String prefixStr(access.getAllocator());
+		prefixStr = prefix.c_str();
+
+		for (auto it = indexedHeadersPtr->lower_bound(prefixStr); it != indexedHeadersPtr->end();
+			 it++)
+		{
+			const std::string entry = it->c_str();
+			if (entry.compare(0, prefix.size(), prefix) != 0)
+			{
+				break;
+			}
+			filePaths.insert(FilePath(utility::decodeFromUtf8(entry.substr(prefix.size()))));
+		}
+	}
+
+	return filePaths;
+}
+
+void InterprocessIndexingStatusManager::clearIndexedHeaderFilePaths()
+{
+	SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+	SharedMemory::Set<SharedMemory::String>* indexedHeadersPtr =
+		access.accessValueWithAllocator<SharedMemory::Set<SharedMemory::String>>(
+			s_indexedHeadersKeyName);
+	if (indexedHeadersPtr)
+	{
+		indexedHeadersPtr->clear();
+	}
+}
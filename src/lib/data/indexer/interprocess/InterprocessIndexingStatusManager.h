@@ -1,10 +1,12 @@
 #ifndef INTERPROCESS_INDEXING_STATUS_MANAGER_H
 #define INTERPROCESS_INDEXING_STATUS_MANAGER_H
 
+#include <map>
 #include <set>
 
 #include "BaseInterprocessDataManager.h"
 #include "FilePath.h"
+#include "TimeStamp.h"
 
 class InterprocessIndexingStatusManager: public BaseInterprocessDataManager
 {
@@ -13,16 +15,38 @@ public:
 	virtual ~InterprocessIndexingStatusManager();
 
 	void startIndexingSourceFile(const FilePath& filePath);
-	void finishIndexingSourceFile();
+	// phase durations are the profile of the finished source file in milliseconds per phase
+	void finishIndexingSourceFile(
+		const std::map<std::string, size_t>& phaseDurations = std::map<std::string, size_t>());
 
 	void setIndexingInterrupted(bool interrupted);
 	bool getIndexingInterrupted();
 
+	// indexer processes only record their indexing profile if the main process enabled profiling
+	void setIndexingProfileEnabled(bool enabled);
+	bool getIndexingProfileEnabled();
+
+	// indexer processes keep waiting for new commands until the command queue is stopped
+	void setIndexerCommandQueueStopped(bool stopped);
+	bool getIndexerCommandQueueStopped();
+
 	Id getNextFinishedProcessId();
 
 	std::vector<FilePath> getCurrentlyIndexedSourceFilePaths();
 	std::vector<FilePath> getCrashedSourceFilePaths();
 
+	// returns the indexing durations in milliseconds of all source files finished since last call
+	std::map<FilePath, size_t> getIndexingDurations();
+
+	// returns the indexing phase durations of all source files finished since last call
+	std::map<FilePath, std::map<std::string, size_t>> getIndexingPhaseDurations();
+
+	// registry of headers that were completely indexed for a preprocessor context
+	void addIndexedHeaderFilePaths(
+		const std::wstring& context, const std::set<FilePath>& filePaths);
+	std::set<FilePath> getIndexedHeaderFilePaths(const std::wstring& context);
+	void clearIndexedHeaderFilePaths();
+
 private:
 	static const char* s_sharedMemoryNamePrefix;
 
@@ -31,6 +55,13 @@ private:
 	static const char* s_crashedFilesKeyName;
 	static const char* s_finishedProcessIdsKeyName;
 	static const char* s_indexingInterruptedKeyName;
+	static const char* s_indexerCommandQueueStoppedKeyName;
+	static const char* s_indexingProfileEnabledKeyName;
+	static const char* s_indexingDurationsKeyName;
+	static const char* s_indexingPhaseDurationsKeyName;
+	static const char* s_indexedHeadersKeyName;
+
+	TimeStamp m_indexingStartTime;
 };
 
 #endif	  // INTERPROCESS_INDEXING_STATUS_MANAGER_H
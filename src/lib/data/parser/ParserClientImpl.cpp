@@ -1,6 +1,7 @@
 #include "ParserClientImpl.h"
 
 #include "Edge.h"
+#include "IndexingProfile.h"
 #include "Node.h"
 #include "ParseLocation.h"
 
@@ -20,6 +21,8 @@ void ParserClientImpl::recordFileLanguage(Id fileId, const std::wstring& languag
 
 Id ParserClientImpl::recordSymbol(const NameHierarchy& symbolName)
 {
+	IndexingProfile::ScopedPhase profilePhase(INDEXING_PHASE_STORAGE);
+
 	return addNodeHierarchy(symbolName);
 }
 
@@ -47,6 +50,8 @@ void ParserClientImpl::recordDefinitionKind(Id symbolId, DefinitionKind definiti
 Id ParserClientImpl::recordReference(
 	ReferenceKind referenceKind, Id referencedSymbolId, Id contextSymbolId, const ParseLocation& location)
 {
+	IndexingProfile::ScopedPhase profilePhase(INDEXING_PHASE_STORAGE);
+
 	Id edgeId = addEdge(referenceKindToEdgeType(referenceKind), contextSymbolId, referencedSymbolId);
 	if (edgeId)
 	{
@@ -57,17 +62,23 @@ Id ParserClientImpl::recordReference(
 
 void ParserClientImpl::recordLocalSymbol(const std::wstring& name, const ParseLocation& location)
 {
+	IndexingProfile::ScopedPhase profilePhase(INDEXING_PHASE_STORAGE);
+
 	const Id localSymbolId = m_storage->addLocalSymbol(name);
 	addSourceLocation(localSymbolId, location, LOCATION_LOCAL_SYMBOL);
 }
 
 void ParserClientImpl::recordLocation(Id elementId, const ParseLocation& location, ParseLocationType type)
 {
+	IndexingProfile::ScopedPhase profilePhase(INDEXING_PHASE_STORAGE);
+
 	addSourceLocation(elementId, location, parseLocationTypeToLocationType(type));
 }
 
 void ParserClientImpl::recordComment(const ParseLocation& location)
 {
+	IndexingProfile::ScopedPhase profilePhase(INDEXING_PHASE_STORAGE);
+
 	if (!location.isValid())
 	{
 		return;
@@ -89,6 +100,8 @@ void ParserClientImpl::recordError(
 	const FilePath& translationUnit,
 	const ParseLocation& location)
 {
+	IndexingProfile::ScopedPhase profilePhase(INDEXING_PHASE_STORAGE);
+
 	if (location.fileId != 0)
 	{
 		Id errorId = m_storage->addError(
@@ -201,31 +214,40 @@ LocationType ParserClientImpl::parseLocationTypeToLocationType(ParseLocationType
 
 Id ParserClientImpl::addNodeHierarchy(const NameHierarchy& nameHierarchy)
 {
-	Id childNodeId = 0;
-	Id firstNodeId = 0;
-	for (size_t i = nameHierarchy.size(); i > 0; i--)
-	{
-		std::pair<Id, bool> ret = m_storage->addNode(StorageNodeData(
-			nodeKindToInt(NODE_SYMBOL), NameHierarchy::serializeRange(nameHierarchy, 0, i)));
+	// each distinct name prefix is only serialized once, when its node is recorded for the first
+	// time, all later lookups walk down the hierarchy element by element
+	static const std::wstring noDelimiter;
 
-		if (!firstNodeId)
+	Id parentNodeId = 0;
+	for (size_t i = 0; i < nameHierarchy.size(); i++)
+	{
+		const NameElement& element = nameHierarchy[i];
+		const auto key = std::forward_as_tuple(
+			parentNodeId,
+			element.getName(),
+			element.getSignature().getPrefix(),
+			element.getSignature().getPostfix(),
+			i == 0 ? nameHierarchy.getDelimiter() : noDelimiter);
+
+		auto it = m_nameElementIdMap.find(key);
+		if (it != m_nameElementIdMap.end())
 		{
-			firstNodeId = ret.first;
+			parentNodeId = it->second;
+			continue;
 		}
 
-		if (childNodeId != 0)
-		{
-			addEdge(Edge::EDGE_MEMBER, ret.first, childNodeId);
-		}
+		std::pair<Id, bool> ret = m_storage->addNode(StorageNodeData(
+			nodeKindToInt(NODE_SYMBOL), NameHierarchy::serializeRange(nameHierarchy, 0, i + 1)));
 
-		if (!ret.second)
+		if (ret.second && parentNodeId != 0)
 		{
-			return firstNodeId;
+			addEdge(Edge::EDGE_MEMBER, parentNodeId, ret.first);
 		}
 
-		childNodeId = ret.first;
+		m_nameElementIdMap.emplace(key, ret.first);
+		parentNodeId = ret.first;
 	}
-	return firstNodeId;
+	return parentNodeId;
 }
 
 Id ParserClientImpl::addFileName(const FilePath& filePath)
@@ -1,7 +1,9 @@
 #ifndef PARSER_CLIENT_IMPL_H
 #define PARSER_CLIENT_IMPL_H
 
+#include <map>
 #include <set>
+#include <tuple>
 
 #include "DefinitionKind.h"
 #include "IntermediateStorage.h"
@@ -56,6 +58,11 @@ private:
 
 	IntermediateStorage* const m_storage;
 	std::map<std::wstring, Id> m_fileIdMap;
+
+	// node ids of recorded name elements keyed by parent node id, name, signature prefix,
+	// signature postfix and delimiter, the delimiter is only set for elements without parent
+	typedef std::tuple<Id, std::wstring, std::wstring, std::wstring, std::wstring> NameElementKey;
+	std::map<NameElementKey, Id, std::less<>> m_nameElementIdMap;
 };
 
 #endif	  // PARSER_CLIENT_IMPL_H
@@ -4,6 +4,7 @@
 #include <sstream>
 
 #include "AccessKind.h"
+#include "AdjacencyPathFinder.h"
 #include "ApplicationSettings.h"
 #include "ElementComponentKind.h"
 #include "FileInfo.h"
@@ -324,6 +325,32 @@ void PersistentStorage::setProjectSettingsText(std::string text)
 	m_sqliteIndexStorage.setProjectSettingsText(text);
 }
 
+std::map<FilePath, size_t> PersistentStorage::getIndexingDurations() const
+{
+	return m_sqliteIndexStorage.getIndexingDurations();
+}
+
+void PersistentStorage::setIndexingDurations(const std::map<FilePath, size_t>& durations)
+{
+	m_sqliteIndexStorage.beginTransaction();
+	m_sqliteIndexStorage.setIndexingDurations(durations);
+	m_sqliteIndexStorage.commitTransaction();
+}
+
+std::map<FilePath, std::map<std::string, size_t>> PersistentStorage::getIndexingPhaseDurations()
+	const
+{
+	return m_sqliteIndexStorage.getIndexingPhaseDurations();
+}
+
+void PersistentStorage::setIndexingPhaseDurations(
+	const std::map<FilePath, std::map<std::string, size_t>>& phaseDurations)
+{
+	m_sqliteIndexStorage.beginTransaction();
+	m_sqliteIndexStorage.setIndexingPhaseDurations(phaseDurations);
+	m_sqliteIndexStorage.commitTransaction();
+}
+
 void PersistentStorage::setup()
 {
 	m_sqliteIndexStorage.setup();
@@ -362,6 +389,8 @@ void PersistentStorage::clearCaches()
 	m_symbolDefinitionKinds.clear();
 
 	m_hierarchyCache.clear();
+	m_adjacencyCache.clear();
+	m_bundledEdgeCache.clear();
 	m_fullTextSearchIndex.clear();
 	m_fullTextSearchCodec = "";
 }
@@ -411,6 +440,7 @@ void PersistentStorage::clearFileElements(
 		m_sqliteIndexStorage.beginTransaction();
 		m_sqliteIndexStorage.removeElementsWithLocationInFiles(fileNodeIds, updateStatusCallback);
 		m_sqliteIndexStorage.removeElements(fileNodeIds);
+		m_sqliteIndexStorage.removeIndexingPhaseDurations(filePaths);
 		m_sqliteIndexStorage.commitTransaction();
 		updateStatusCallback(100);
 	}
@@ -435,6 +465,13 @@ std::vector<FileInfo> PersistentStorage::getFileInfoForAllFiles() const
 	return fileInfos;
 }
 
+std::map<FilePath, std::string> PersistentStorage::getFileContentHashes() const
+{
+	TRACE();
+
+	return m_sqliteIndexStorage.getFileContentHashes();
+}
+
 std::set<FilePath> PersistentStorage::getIncompleteFiles() const
 {
 	TRACE();
@@ -472,6 +509,13 @@ void PersistentStorage::buildCaches()
 	buildSearchIndex();
 	buildMemberEdgeIdOrderMap();
 	buildHierarchyCache();
+	buildAdjacencyCache();
+	buildBundledEdgeCache();
+}
+
+const AdjacencyCache& PersistentStorage::getAdjacencyCache() const
+{
+	return m_adjacencyCache;
 }
 
 void PersistentStorage::optimizeMemory()
@@ -1092,10 +1136,17 @@ std::shared_ptr<Graph> PersistentStorage::getGraphForNodeTypes(NodeTypeSet nodeT
 }
 
 std::shared_ptr<Graph> PersistentStorage::getGraphForActiveTokenIds(
-	const std::vector<Id>& tokenIds, const std::vector<Id>& expandedNodeIds, bool* isActiveNamespace) const
+	const std::vector<Id>& tokenIds,
+	const std::vector<Id>& expandedNodeIds,
+	bool* isActiveNamespace,
+	const std::function<bool()>& isCancelled) const
 {
 	TRACE();
 
+	// the query is checked for cancellation between its steps, a cancelled query returns an
+	// incomplete graph that the caller is expected to drop
+	auto cancelled = [&isCancelled]() { return isCancelled && isCancelled(); };
+
 	std::vector<Id> ids(tokenIds);
 	bool isPackage = false;
 
@@ -1212,6 +1263,11 @@ std::shared_ptr<Graph> PersistentStorage::getGraphForActiveTokenIds(
 	std::shared_ptr<Graph> g = std::make_shared<Graph>();
 	Graph* graph = g.get();
 
+	if (cancelled())
+	{
+		return g;
+	}
+
 	if (isPackage)
 	{
 		addNodesToGraph(nodeIds, graph, false);
@@ -1221,6 +1277,11 @@ std::shared_ptr<Graph> PersistentStorage::getGraphForActiveTokenIds(
 		addNodesWithParentsAndEdgesToGraph(nodeIds, edgeIds, graph, true);
 	}
 
+	if (cancelled())
+	{
+		return g;
+	}
+
 	if (addBundledEdges)
 	{
 		addBundledEdgesToGraph(tokenIds[0], edgesToBundle, graph);
@@ -1250,6 +1311,11 @@ std::shared_ptr<Graph> PersistentStorage::getGraphForActiveTokenIds(
 			addEdgesToGraph(expandedChildEdgeIds, graph);
 		}
 
+		if (cancelled())
+		{
+			return g;
+		}
+
 		addInheritanceChainsToGraph(nodeIds, graph);
 	}
 
@@ -1289,214 +1355,49 @@ std::shared_ptr<Graph> PersistentStorage::getGraphForTrail(
 	Edge::TypeMask edgeTypes,
 	bool nodeNonIndexed,
 	size_t depth,
-	bool directed) const
+	bool directed,
+	size_t maxPathCount) const
 {
 	TRACE();
 
-	std::set<Id> nodeIds;
-	std::set<Id> edgeIds;
-
-	nodeIds.insert(originId ? originId : targetId);
-	bool forward = originId;
-	size_t currentDepth = 0;
-
-	std::vector<Id> nodeIdsToProcess = {*nodeIds.begin()};
-
-	struct TrailNode
-	{
-		Id id = 0;
-		std::set<TrailNode*> parents;
-		std::set<Id> edgeIds;
-	};
-
-	bool isTerminatedTrail = originId && targetId;
-	std::map<Id, TrailNode> trailNodes;
+	std::vector<Id> nodeIds;
+	std::vector<Id> edgeIds;
 
-	if (isTerminatedTrail)
+	if (originId && targetId)
 	{
-		TrailNode root;
-		root.id = originId;
-		trailNodes.emplace(originId, root);
+		addTrailPathIds(
+			originId,
+			targetId,
+			nodeTypes,
+			edgeTypes,
+			nodeNonIndexed,
+			depth,
+			directed,
+			maxPathCount,
+			&nodeIds,
+			&edgeIds);
 	}
-
-	while (nodeIdsToProcess.size() && (!depth || currentDepth < depth))
+	else
 	{
-		std::vector<StorageEdge> edges = forward
-			? m_sqliteIndexStorage.getEdgesBySourceIds(nodeIdsToProcess)
-			: m_sqliteIndexStorage.getEdgesByTargetIds(nodeIdsToProcess);
-
-		if (!directed || edgeTypes & Edge::LAYOUT_VERTICAL)
-		{
-			utility::append(
-				edges,
-				forward ? m_sqliteIndexStorage.getEdgesByTargetIds(nodeIdsToProcess)
-						: m_sqliteIndexStorage.getEdgesBySourceIds(nodeIdsToProcess));
-		}
-
-		std::vector<Id> nodeIdsToCheck;
-		std::map<Id, std::vector<StorageEdge>> edgesToInsert;
-
-		for (const StorageEdge& edge: edges)
-		{
-			if (Edge::intToType(edge.type) & edgeTypes && edgeIds.find(edge.id) == edgeIds.end())
-			{
-				bool isForward = forward == !(Edge::intToType(edge.type) & Edge::LAYOUT_VERTICAL);
-
-				const Id targetNodeId = isForward ? edge.targetNodeId : edge.sourceNodeId;
-				const Id sourceNodeId = isForward ? edge.sourceNodeId : edge.targetNodeId;
-
-				if (nodeIds.find(targetNodeId) == nodeIds.end())
-				{
-					nodeIdsToCheck.push_back(targetNodeId);
-					edgesToInsert[targetNodeId].push_back(edge);
-				}
-				else if (nodeIds.find(sourceNodeId) == nodeIds.end())
-				{
-					if (!directed)
-					{
-						nodeIdsToCheck.push_back(sourceNodeId);
-						edgesToInsert[sourceNodeId].push_back(edge);
-					}
-				}
-				else
-				{
-					edgeIds.insert(edge.id);
-
-					if (isTerminatedTrail)
-					{
-						TrailNode& target = trailNodes[targetNodeId];
-						TrailNode& origin = trailNodes[sourceNodeId];
-						target.id = targetNodeId;
-						origin.id = sourceNodeId;
-						target.parents.insert(&origin);
-						target.edgeIds.insert(edge.id);
-					}
-				}
-			}
-		}
-
-		nodeIdsToProcess.clear();
-
-		if (nodeTypes != 0)
-		{
-			for (const StorageNode& node:
-				 m_sqliteIndexStorage.getAllByIds<StorageNode>(nodeIdsToCheck))
-			{
-				NodeKind kind = intToNodeKind(node.type);
-				if (kind & nodeTypes || (kind == NODE_SYMBOL && nodeNonIndexed))
-				{
-					if (!nodeNonIndexed)
-					{
-						if (kind == NODE_FILE)
-						{
-							auto it = m_fileNodeIndexed.find(node.id);
-							if (it == m_fileNodeIndexed.end() || !it->second)
-							{
-								continue;
-							}
-						}
-						else
-						{
-							auto it = m_symbolDefinitionKinds.find(node.id);
-							if (it == m_symbolDefinitionKinds.end() || it->second == DEFINITION_NONE)
-							{
-								continue;
-							}
-						}
-					}
-
-					// FIXME: don't add namespace nodes to the graph, because it destroys trail
-					// layouting Remove when namespaces are proper nodes with children
-					if ((kind & (NODE_MODULE | NODE_NAMESPACE | NODE_PACKAGE)) == 0)
-					{
-						nodeIds.insert(node.id);
-						for (const StorageEdge& edge: edgesToInsert[node.id])
-						{
-							if ((Edge::intToType(edge.type) & Edge::EDGE_MEMBER) == 0)
-							{
-								edgeIds.insert(edge.id);
-							}
-						}
-					}
-					nodeIdsToProcess.push_back(node.id);
-
-					if (isTerminatedTrail)
-					{
-						TrailNode& targetNode = trailNodes[node.id];
-						targetNode.id = node.id;
-
-						for (const StorageEdge& edge: edgesToInsert[node.id])
-						{
-							targetNode.edgeIds.insert(edge.id);
-
-							Id sourceNodeId =
-								(edge.targetNodeId == node.id ? edge.sourceNodeId
-															  : edge.targetNodeId);
-							TrailNode& oldNode = trailNodes[sourceNodeId];
-							targetNode.parents.insert(&oldNode);
-						}
-					}
-				}
-			}
-		}
-		else
-		{
-			for (const Id nodeId: nodeIdsToCheck)
-			{
-				nodeIds.insert(nodeId);
-				nodeIdsToProcess.push_back(nodeId);
-
-				for (const StorageEdge& edge: edgesToInsert[nodeId])
-				{
-					edgeIds.insert(edge.id);
-				}
-			}
-		}
-
-		edgesToInsert.clear();
-
-		currentDepth++;
+		addTrailIds(
+			originId ? originId : targetId,
+			originId,
+			nodeTypes,
+			edgeTypes,
+			nodeNonIndexed,
+			depth,
+			directed,
+			&nodeIds,
+			&edgeIds);
 	}
 
-	if (isTerminatedTrail)
-	{
-		nodeIds.clear();
-		edgeIds.clear();
-
-		if (trailNodes.find(targetId) != trailNodes.end())
-		{
-			std::queue<TrailNode*> nodesToProcess;
-			nodesToProcess.push(&trailNodes[targetId]);
-
-			while (nodesToProcess.size())
-			{
-				TrailNode* currentNode = nodesToProcess.front();
-				nodesToProcess.pop();
-
-				if (nodeIds.find(currentNode->id) != nodeIds.end())
-				{
-					continue;
-				}
-
-				nodeIds.insert(currentNode->id);
-				edgeIds.insert(currentNode->edgeIds.begin(), currentNode->edgeIds.end());
-
-				for (TrailNode* parent: currentNode->parents)
-				{
-					nodesToProcess.push(parent);
-				}
-			}
-		}
-		else
-		{
-			nodeIds.insert(originId);
-		}
-	}
+	std::sort(nodeIds.begin(), nodeIds.end());
+	std::sort(edgeIds.begin(), edgeIds.end());
+	edgeIds.erase(std::unique(edgeIds.begin(), edgeIds.end()), edgeIds.end());
 
 	std::shared_ptr<Graph> graph = std::make_shared<Graph>();
 
-	addNodesWithParentsAndEdgesToGraph(
-		utility::toVector(nodeIds), utility::toVector(edgeIds), graph.get(), false);
+	addNodesWithParentsAndEdgesToGraph(nodeIds, edgeIds, graph.get(), false);
 	addComponentAccessToGraph(graph.get());
 	addComponentIsAmbiguousToGraph(graph.get());
 
@@ -2979,61 +2880,76 @@ void PersistentStorage::addBundledEdgesToGraph(
 		bool forward;
 	};
 
-	// build bundled edges:
-	// get all children of the active node
-	std::set<Id> childNodeIdsSet, edgeIdsSet;
-	m_hierarchyCache.addAllChildIdsForNodeId(nodeId, &childNodeIdsSet, &edgeIdsSet);
-	const std::vector<Id> childNodeIds = utility::toVector(childNodeIdsSet);
-	if (childNodeIds.size() == 0 && edgesToBundle.size() == 0)
-	{
-		return;
-	}
+	// group the edges by the last visible parent of their other end (up to last level except
+	// namespace/undefined)
+	const Id nodeParentNodeId = m_hierarchyCache.getLastVisibleParentNodeId(nodeId);
+
+	std::map<Id, std::vector<EdgeInfo>> connectedParentNodeIds;
+	auto addEdgeInfo = [&](Id connectedNodeId, Id edgeId, bool forward) {
+		const Id parentNodeId = m_hierarchyCache.getLastVisibleParentNodeId(connectedNodeId);
+		if (parentNodeId != nodeParentNodeId)
+		{
+			connectedParentNodeIds[parentNodeId].push_back({edgeId, forward});
+		}
+	};
 
-	// get all edges of the children
-	std::map<Id, std::vector<EdgeInfo>> connectedNodeIds;
 	for (const StorageEdge& edge: edgesToBundle)
 	{
-		bool isSource = nodeId == edge.sourceNodeId;
-		EdgeInfo edgeInfo;
-		edgeInfo.edgeId = edge.id;
-		edgeInfo.forward = isSource;
-		connectedNodeIds[isSource ? edge.targetNodeId : edge.sourceNodeId].push_back(edgeInfo);
+		const bool isSource = nodeId == edge.sourceNodeId;
+		addEdgeInfo(isSource ? edge.targetNodeId : edge.sourceNodeId, edge.id, isSource);
 	}
 
-	const std::vector<StorageEdge> outgoingEdges = m_sqliteIndexStorage.getEdgesBySourceIds(
-		childNodeIds);
-	for (const StorageEdge& outEdge: outgoingEdges)
+	// the edges of all children of a last visible parent are bundled while building the caches,
+	// children of other nodes are collected from the adjacency cache
+	const uint32_t nodeIndex = m_adjacencyCache.getNodeIndex(nodeId);
+	if (nodeParentNodeId == nodeId && nodeIndex != AdjacencyCache::INVALID_INDEX)
 	{
-		EdgeInfo edgeInfo;
-		edgeInfo.edgeId = outEdge.id;
-		edgeInfo.forward = true;
-		connectedNodeIds[outEdge.targetNodeId].push_back(edgeInfo);
+		for (const BundledEdgeCache::Bundle& bundle: m_bundledEdgeCache.getBundles(nodeIndex))
+		{
+			std::vector<EdgeInfo>& edgeInfos =
+				connectedParentNodeIds[m_adjacencyCache.getNodeId(bundle.targetIndex)];
+			for (const BundledEdgeCache::BundledEdge& edge:
+				 m_bundledEdgeCache.getBundledEdges(bundle))
+			{
+				edgeInfos.push_back({m_adjacencyCache.getEdgeId(edge.edgeIndex), edge.forward});
+			}
+		}
 	}
-
-	const std::vector<StorageEdge> incomingEdges = m_sqliteIndexStorage.getEdgesByTargetIds(
-		childNodeIds);
-	for (const StorageEdge& inEdge: incomingEdges)
+	else
 	{
-		EdgeInfo edgeInfo;
-		edgeInfo.edgeId = inEdge.id;
-		edgeInfo.forward = false;
-		connectedNodeIds[inEdge.sourceNodeId].push_back(edgeInfo);
-	}
-
-	// get all parent nodes of all connected nodes (up to last level except namespace/undefined)
-	const Id nodeParentNodeId = m_hierarchyCache.getLastVisibleParentNodeId(nodeId);
+		std::set<Id> childNodeIds, edgeIds;
+		m_hierarchyCache.addAllChildIdsForNodeId(nodeId, &childNodeIds, &edgeIds);
+		for (const Id childNodeId: childNodeIds)
+		{
+			const uint32_t childIndex = m_adjacencyCache.getNodeIndex(childNodeId);
+			if (childIndex == AdjacencyCache::INVALID_INDEX)
+			{
+				continue;
+			}
 
-	std::map<Id, std::vector<EdgeInfo>> connectedParentNodeIds;
-	for (const std::pair<Id, std::vector<EdgeInfo>>& p: connectedNodeIds)
-	{
-		const Id parentNodeId = m_hierarchyCache.getLastVisibleParentNodeId(p.first);
+			for (const AdjacencyCache::Neighbor& neighbor: m_adjacencyCache.getOutgoing(childIndex))
+			{
+				addEdgeInfo(
+					m_adjacencyCache.getNodeId(neighbor.nodeIndex),
+					m_adjacencyCache.getEdgeId(neighbor.edgeIndex),
+					true);
+			}
 
-		if (parentNodeId != nodeParentNodeId)
-		{
-			utility::append(connectedParentNodeIds[parentNodeId], p.second);
+			for (const AdjacencyCache::Neighbor& neighbor: m_adjacencyCache.getIncoming(childIndex))
+			{
+				addEdgeInfo(
+					m_adjacencyCache.getNodeId(neighbor.nodeIndex),
+					m_adjacencyCache.getEdgeId(neighbor.edgeIndex),
+					false);
+			}
 		}
 	}
 
+	if (connectedParentNodeIds.empty())
+	{
+		return;
+	}
+
 	// add hierarchies of these parents
 	std::vector<Id> nodeIdsToAdd;
 	for (const std::pair<Id, std::vector<EdgeInfo>>& p: connectedParentNodeIds)
@@ -3060,13 +2976,15 @@ void PersistentStorage::addBundledEdgesToGraph(
 
 		std::shared_ptr<TokenComponentBundledEdges> componentBundledEdges =
 			std::make_shared<TokenComponentBundledEdges>();
+		Id firstEdgeId = p.second.front().edgeId;
 		for (const EdgeInfo& edgeInfo: p.second)
 		{
 			componentBundledEdges->addBundledEdgesId(edgeInfo.edgeId, edgeInfo.forward);
+			firstEdgeId = std::min(firstEdgeId, edgeInfo.edgeId);
 		}
 
 		// Set first bit to 1 to avoid collisions
-		const Id bundledEdgesId = ~(~Id(0) >> 1) + *componentBundledEdges->getBundledEdgesIds().begin();
+		const Id bundledEdgesId = ~(~Id(0) >> 1) + firstEdgeId;
 
 		Edge* edge = graph->createEdge(bundledEdgesId, Edge::EDGE_BUNDLED_EDGES, sourceNode, targetNode);
 		edge->addComponent(componentBundledEdges);
@@ -3242,6 +3160,297 @@ void PersistentStorage::addInheritanceChainsToGraph(const std::vector<Id>& activ
 	}
 }
 
+bool PersistentStorage::isTrailNodeAccepted(
+	uint32_t nodeIndex, NodeKindMask nodeTypes, bool nodeNonIndexed) const
+{
+	if (nodeTypes == 0)
+	{
+		return true;
+	}
+
+	const NodeKind kind = m_adjacencyCache.getNodeKind(nodeIndex);
+	if (!(kind & nodeTypes || (kind == NODE_SYMBOL && nodeNonIndexed)))
+	{
+		return false;
+	}
+
+	if (!nodeNonIndexed)
+	{
+		const Id nodeId = m_adjacencyCache.getNodeId(nodeIndex);
+		if (kind == NODE_FILE)
+		{
+			auto it = m_fileNodeIndexed.find(nodeId);
+			return it != m_fileNodeIndexed.end() && it->second;
+		}
+
+		auto it = m_symbolDefinitionKinds.find(nodeId);
+		return it != m_symbolDefinitionKinds.end() && it->second != DEFINITION_NONE;
+	}
+
+	return true;
+}
+
+void PersistentStorage::addTrailIds(
+	Id startId,
+	bool forward,
+	NodeKindMask nodeTypes,
+	Edge::TypeMask edgeTypes,
+	bool nodeNonIndexed,
+	size_t depth,
+	bool directed,
+	std::vector<Id>* nodeIds,
+	std::vector<Id>* edgeIds) const
+{
+	TRACE();
+
+	const bool followBothDirections = !directed || edgeTypes & Edge::LAYOUT_VERTICAL;
+
+	nodeIds->push_back(startId);
+
+	// A link is an edge leading to a node from its parent node in the trail.
+	struct TrailLink
+	{
+		uint32_t nodeIndex;
+		uint32_t edgeIndex;
+		uint32_t parentIndex;
+
+		bool operator<(const TrailLink& other) const
+		{
+			return nodeIndex != other.nodeIndex ? nodeIndex < other.nodeIndex
+												: edgeIndex < other.edgeIndex;
+		}
+
+		bool operator==(const TrailLink& other) const
+		{
+			return nodeIndex == other.nodeIndex && edgeIndex == other.edgeIndex;
+		}
+	};
+
+	// nodes are added once they are part of the trail, seen nodes were either added or rejected
+	// and pending nodes are the candidates of the current depth level
+	const size_t nodeCount = m_adjacencyCache.getNodeCount();
+	std::vector<bool> addedNodes(nodeCount, false);
+	std::vector<bool> seenNodes(nodeCount, false);
+	std::vector<bool> pendingNodes(nodeCount, false);
+	std::vector<bool> addedEdges(m_adjacencyCache.getEdgeCount(), false);
+
+	std::vector<uint32_t> nodeIndicesToProcess;
+	std::vector<uint32_t> nodeIndicesToCheck;
+	std::vector<TrailLink> edgesToInsert;
+
+	const uint32_t startIndex = m_adjacencyCache.getNodeIndex(startId);
+	if (startIndex != AdjacencyCache::INVALID_INDEX)
+	{
+		addedNodes[startIndex] = true;
+		seenNodes[startIndex] = true;
+		nodeIndicesToProcess.push_back(startIndex);
+	}
+
+	auto addEdge = [&](uint32_t edgeIndex) {
+		if (!addedEdges[edgeIndex])
+		{
+			addedEdges[edgeIndex] = true;
+			edgeIds->push_back(m_adjacencyCache.getEdgeId(edgeIndex));
+		}
+	};
+
+	auto visitEdge = [&](uint32_t sourceIndex, uint32_t targetIndex, uint32_t edgeIndex) {
+		const Edge::EdgeType type = m_adjacencyCache.getEdgeType(edgeIndex);
+		if (!(type & edgeTypes) || addedEdges[edgeIndex])
+		{
+			return;
+		}
+
+		const bool isForward = forward == !(type & Edge::LAYOUT_VERTICAL);
+		const uint32_t toIndex = isForward ? targetIndex : sourceIndex;
+		const uint32_t fromIndex = isForward ? sourceIndex : targetIndex;
+
+		TrailLink link;
+		if (!addedNodes[toIndex])
+		{
+			link = {toIndex, edgeIndex, fromIndex};
+		}
+		else if (!addedNodes[fromIndex])
+		{
+			if (directed)
+			{
+				return;
+			}
+			link = {fromIndex, edgeIndex, toIndex};
+		}
+		else
+		{
+			addEdge(edgeIndex);
+			return;
+		}
+
+		if (!seenNodes[link.nodeIndex])
+		{
+			seenNodes[link.nodeIndex] = true;
+			pendingNodes[link.nodeIndex] = true;
+			nodeIndicesToCheck.push_back(link.nodeIndex);
+		}
+
+		if (pendingNodes[link.nodeIndex])
+		{
+			edgesToInsert.push_back(link);
+		}
+	};
+
+	size_t currentDepth = 0;
+	while (nodeIndicesToProcess.size() && (!depth || currentDepth < depth))
+	{
+		for (const uint32_t nodeIndex: nodeIndicesToProcess)
+		{
+			if (forward || followBothDirections)
+			{
+				for (const AdjacencyCache::Neighbor& neighbor:
+					 m_adjacencyCache.getOutgoing(nodeIndex))
+				{
+					visitEdge(nodeIndex, neighbor.nodeIndex, neighbor.edgeIndex);
+				}
+			}
+
+			if (!forward || followBothDirections)
+			{
+				for (const AdjacencyCache::Neighbor& neighbor:
+					 m_adjacencyCache.getIncoming(nodeIndex))
+				{
+					visitEdge(neighbor.nodeIndex, nodeIndex, neighbor.edgeIndex);
+				}
+			}
+		}
+
+		nodeIndicesToProcess.clear();
+
+		std::sort(nodeIndicesToCheck.begin(), nodeIndicesToCheck.end());
+		std::sort(edgesToInsert.begin(), edgesToInsert.end());
+		edgesToInsert.erase(
+			std::unique(edgesToInsert.begin(), edgesToInsert.end()), edgesToInsert.end());
+
+		auto linkIt = edgesToInsert.begin();
+		for (const uint32_t nodeIndex: nodeIndicesToCheck)
+		{
+			pendingNodes[nodeIndex] = false;
+
+			const auto linksBegin = linkIt;
+			while (linkIt != edgesToInsert.end() && linkIt->nodeIndex == nodeIndex)
+			{
+				++linkIt;
+			}
+
+			if (nodeTypes != 0)
+			{
+				if (!isTrailNodeAccepted(nodeIndex, nodeTypes, nodeNonIndexed))
+				{
+					continue;
+				}
+
+				// FIXME: don't add namespace nodes to the graph, because it destroys trail
+				// layouting Remove when namespaces are proper nodes with children
+				if ((m_adjacencyCache.getNodeKind(nodeIndex) &
+					 (NODE_MODULE | NODE_NAMESPACE | NODE_PACKAGE)) == 0)
+				{
+					addedNodes[nodeIndex] = true;
+					nodeIds->push_back(m_adjacencyCache.getNodeId(nodeIndex));
+
+					for (auto it = linksBegin; it != linkIt; it++)
+					{
+						if ((m_adjacencyCache.getEdgeType(it->edgeIndex) & Edge::EDGE_MEMBER) == 0)
+						{
+							addEdge(it->edgeIndex);
+						}
+					}
+				}
+			}
+			else
+			{
+				addedNodes[nodeIndex] = true;
+				nodeIds->push_back(m_adjacencyCache.getNodeId(nodeIndex));
+
+				for (auto it = linksBegin; it != linkIt; it++)
+				{
+					addEdge(it->edgeIndex);
+				}
+			}
+
+			nodeIndicesToProcess.push_back(nodeIndex);
+		}
+
+		nodeIndicesToCheck.clear();
+		edgesToInsert.clear();
+
+		currentDepth++;
+	}
+}
+
+void PersistentStorage::addTrailPathIds(
+	Id originId,
+	Id targetId,
+	NodeKindMask nodeTypes,
+	Edge::TypeMask edgeTypes,
+	bool nodeNonIndexed,
+	size_t depth,
+	bool directed,
+	size_t maxPathCount,
+	std::vector<Id>* nodeIds,
+	std::vector<Id>* edgeIds) const
+{
+	TRACE();
+
+	const uint32_t originIndex = m_adjacencyCache.getNodeIndex(originId);
+	const uint32_t targetIndex = m_adjacencyCache.getNodeIndex(targetId);
+
+	std::vector<uint32_t> nodeIndices;
+	std::vector<uint32_t> edgeIndices;
+
+	if (originIndex != AdjacencyCache::INVALID_INDEX &&
+		targetIndex != AdjacencyCache::INVALID_INDEX)
+	{
+		const AdjacencyPathFinder pathFinder(
+			m_adjacencyCache, edgeTypes, directed, [&](uint32_t nodeIndex) {
+				return isTrailNodeAccepted(nodeIndex, nodeTypes, nodeNonIndexed);
+			});
+
+		if (maxPathCount)
+		{
+			for (const AdjacencyPathFinder::Path& path:
+				 pathFinder.findShortestPaths(originIndex, targetIndex, depth, maxPathCount))
+			{
+				nodeIndices.insert(
+					nodeIndices.end(), path.nodeIndices.begin(), path.nodeIndices.end());
+				edgeIndices.insert(
+					edgeIndices.end(), path.edgeIndices.begin(), path.edgeIndices.end());
+			}
+
+			std::sort(nodeIndices.begin(), nodeIndices.end());
+			nodeIndices.erase(
+				std::unique(nodeIndices.begin(), nodeIndices.end()), nodeIndices.end());
+		}
+		else
+		{
+			pathFinder.findAllShortestPaths(
+				originIndex, targetIndex, depth, &nodeIndices, &edgeIndices);
+		}
+	}
+
+	if (nodeIndices.empty())
+	{
+		nodeIds->push_back(originId);
+		return;
+	}
+
+	for (const uint32_t nodeIndex: nodeIndices)
+	{
+		nodeIds->push_back(m_adjacencyCache.getNodeId(nodeIndex));
+	}
+
+	for (const uint32_t edgeIndex: edgeIndices)
+	{
+		edgeIds->push_back(m_adjacencyCache.getEdgeId(edgeIndex));
+	}
+}
+
 void PersistentStorage::buildFilePathMaps()
 {
 	TRACE();
@@ -3274,6 +3483,9 @@ void PersistentStorage::buildSearchIndex()
 	const FilePath dbPath = getIndexDbFilePath();
 
 	m_sqliteIndexStorage.forEach<StorageNode>([&](StorageNode&& node) {
+		// all nodes are visited here anyway, so they are registered for buildAdjacencyCache()
+		m_adjacencyCache.addNode(node.id, intToNodeKind(node.type));
+
 		const NodeType type(intToNodeKind(node.type));
 		if (type.isFile())
 		{
@@ -3498,4 +3710,25 @@ void PersistentStorage::buildHierarchyCache()
 		Edge::typeToInt(Edge::EDGE_INHERITANCE), [this](StorageEdge&& edge) {
 			m_hierarchyCache.createInheritance(edge.id, edge.sourceNodeId, edge.targetNodeId);
 		});
+
+	m_hierarchyCache.finishSetup();
+}
+
+void PersistentStorage::buildAdjacencyCache()
+{
+	TRACE();
+
+	m_sqliteIndexStorage.forEach<StorageEdge>([this](StorageEdge&& edge) {
+		m_adjacencyCache.addEdge(
+			edge.id, Edge::intToType(edge.type), edge.sourceNodeId, edge.targetNodeId);
+	});
+
+	m_adjacencyCache.finishSetup();
+}
+
+void PersistentStorage::buildBundledEdgeCache()
+{
+	TRACE();
+
+	m_bundledEdgeCache.build(m_adjacencyCache, m_hierarchyCache);
 }
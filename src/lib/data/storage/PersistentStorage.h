@@ -4,6 +4,8 @@
 #include <memory>
 #include <vector>
 
+#include "AdjacencyCache.h"
+#include "BundledEdgeCache.h"
 #include "FullTextSearchIndex.h"
 #include "HierarchyCache.h"
 #include "SearchIndex.h"
@@ -74,6 +76,13 @@ public:
 	std::string getProjectSettingsText() const;
 	void setProjectSettingsText(std::string text);
 
+	std::map<FilePath, size_t> getIndexingDurations() const;
+	void setIndexingDurations(const std::map<FilePath, size_t>& durations);
+
+	std::map<FilePath, std::map<std::string, size_t>> getIndexingPhaseDurations() const;
+	void setIndexingPhaseDurations(
+		const std::map<FilePath, std::map<std::string, size_t>>& phaseDurations);
+
 	void setup();
 	void updateVersion();
 	void clear();
@@ -87,10 +96,12 @@ public:
 		const std::vector<FilePath>& filePaths, std::function<void(int)> updateStatusCallback);
 
 	std::vector<FileInfo> getFileInfoForAllFiles() const;
+	std::map<FilePath, std::string> getFileContentHashes() const;
 	std::set<FilePath> getIncompleteFiles() const;
 	bool getFilePathIndexed(const FilePath& path) const;
 
 	void buildCaches();
+	const AdjacencyCache& getAdjacencyCache() const;
 
 	void optimizeMemory();
 
@@ -130,7 +141,8 @@ public:
 	std::shared_ptr<Graph> getGraphForActiveTokenIds(
 		const std::vector<Id>& tokenIds,
 		const std::vector<Id>& expandedNodeIds,
-		bool* isActiveNamespace = nullptr) const override;
+		bool* isActiveNamespace = nullptr,
+		const std::function<bool()>& isCancelled = nullptr) const override;
 	std::shared_ptr<Graph> getGraphForChildrenOfNodeId(Id nodeId) const override;
 	std::shared_ptr<Graph> getGraphForTrail(
 		Id originId,
@@ -139,7 +151,8 @@ public:
 		Edge::TypeMask trailType,
 		bool nodeNonIndexed,
 		size_t depth,
-		bool directed) const override;
+		bool directed,
+		size_t maxPathCount) const override;
 
 	NodeKindMask getAvailableNodeTypes() const override;
 	Edge::TypeMask getAvailableEdgeTypes() const override;
@@ -255,11 +268,36 @@ private:
 	void addCompleteFlagsToSourceLocationCollection(SourceLocationCollection* collection) const;
 	void addInheritanceChainsToGraph(const std::vector<Id>& nodeIds, Graph* graph) const;
 
+	bool isTrailNodeAccepted(uint32_t nodeIndex, NodeKindMask nodeTypes, bool nodeNonIndexed) const;
+	void addTrailIds(
+		Id startId,
+		bool forward,
+		NodeKindMask nodeTypes,
+		Edge::TypeMask edgeTypes,
+		bool nodeNonIndexed,
+		size_t depth,
+		bool directed,
+		std::vector<Id>* nodeIds,
+		std::vector<Id>* edgeIds) const;
+	void addTrailPathIds(
+		Id originId,
+		Id targetId,
+		NodeKindMask nodeTypes,
+		Edge::TypeMask edgeTypes,
+		bool nodeNonIndexed,
+		size_t depth,
+		bool directed,
+		size_t maxPathCount,
+		std::vector<Id>* nodeIds,
+		std::vector<Id>* edgeIds) const;
+
 	void buildFilePathMaps();
 	void buildSearchIndex();
 	void buildFullTextSearchIndex() const;
 	void buildMemberEdgeIdOrderMap();
 	void buildHierarchyCache();
+	void buildAdjacencyCache();
+	void buildBundledEdgeCache();
 
 	bool m_preIndexingErrorCountSet = false;
 	size_t m_preIndexingErrorCount = 0;
@@ -287,6 +325,8 @@ private:
 	std::map<Id, Id> m_memberEdgeIdOrderMap;
 
 	HierarchyCache m_hierarchyCache;
+	AdjacencyCache m_adjacencyCache;
+	BundledEdgeCache m_bundledEdgeCache;
 
 	bool m_hasJavaFiles = false;
 };
@@ -1,56 +1,293 @@
 #include "Storage.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "logging.h"
 #include "tracing.h"
 
 Storage::Storage() {}
 
-void Storage::inject(Storage* injected)
+std::shared_ptr<Storage::InjectionBatch> Storage::prepareInjection(const Storage* injected)
 {
-	std::lock_guard<std::mutex> lock(m_dataMutex);
+	TRACE();
 
-	std::map<Id, Id> injectedIdToOwnElementId;
-	std::map<Id, Id> injectedIdToOwnSourceLocationId;
+	std::shared_ptr<InjectionBatch> batch = std::make_shared<InjectionBatch>();
+	batch->source = injected;
 
-	TRACE();
-	startInjection();
+	const std::vector<StorageError>& errors = injected->getErrors();
+	const std::vector<StorageNode>& nodes = injected->getStorageNodes();
+	const std::vector<StorageEdge>& edges = injected->getStorageEdges();
+	const std::set<StorageLocalSymbol>& localSymbols = injected->getStorageLocalSymbols();
 
+	batch->errorSlotOffset = 0;
+	batch->nodeSlotOffset = batch->errorSlotOffset + errors.size();
+	batch->edgeSlotOffset = batch->nodeSlotOffset + nodes.size();
+	batch->localSymbolSlotOffset = batch->edgeSlotOffset + edges.size();
+	batch->elementSlotCount = batch->localSymbolSlotOffset + localSymbols.size();
+
+	// ids of an injected storage are dense (see IntermediateStorage), so slots can be looked up in
+	// plain vectors indexed by id
+	const size_t noSlot = std::numeric_limits<size_t>::max();
+
+	Id maxElementId = 0;
+	for (const StorageError& error: errors)
 	{
-		// TRACE("inject errors");
+		maxElementId = std::max(maxElementId, error.id);
+	}
+	for (const StorageNode& node: nodes)
+	{
+		maxElementId = std::max(maxElementId, node.id);
+	}
+	for (const StorageEdge& edge: edges)
+	{
+		maxElementId = std::max(maxElementId, edge.id);
+	}
+	for (const StorageLocalSymbol& symbol: localSymbols)
+	{
+		maxElementId = std::max(maxElementId, symbol.id);
+	}
+
+	std::vector<size_t> injectedIdToElementSlot(maxElementId + 1, noSlot);
+	auto getElementSlot = [&injectedIdToElementSlot, noSlot](Id id) {
+		return id < injectedIdToElementSlot.size() ? injectedIdToElementSlot[id] : noSlot;
+	};
+
+	for (size_t i = 0; i < errors.size(); i++)
+	{
+		injectedIdToElementSlot[errors[i].id] = batch->errorSlotOffset + i;
+	}
+
+	for (size_t i = 0; i < nodes.size(); i++)
+	{
+		injectedIdToElementSlot[nodes[i].id] = batch->nodeSlotOffset + i;
+	}
+
+	{
+		// TRACE("prepare files");
+
+		const std::vector<StorageFile>& files = injected->getStorageFiles();
+		batch->files.reserve(files.size());
 
-		for (const StorageError& error: injected->getErrors())
+		for (const StorageFile& file: files)
 		{
-			Id errorId = addError(error);
-			injectedIdToOwnElementId.emplace(error.id, errorId);
+			const size_t slot = getElementSlot(file.id);
+			if (slot != noSlot)
+			{
+				batch->files.emplace_back(
+					slot,
+					file.filePath,
+					file.languageIdentifier,
+					file.modificationTime,
+					file.indexed,
+					file.complete);
+			}
 		}
 	}
 
 	{
-		// TRACE("inject nodes");
+		// TRACE("prepare symbols");
+
+		std::vector<StorageSymbol>& symbols = batch->symbols;
+		symbols = injected->getStorageSymbols();
+		for (StorageSymbol& symbol: symbols)
+		{
+			symbol.id = getElementSlot(symbol.id);
+		}
+
+		auto end = std::stable_partition(
+			symbols.begin(), symbols.end(), [noSlot](const StorageSymbol& symbol) {
+				return symbol.id != noSlot;
+			});
+		if (end != symbols.end())
+		{
+			LOG_WARNING(
+				std::to_string(std::distance(end, symbols.end())) +
+				" new symbol ids could not be found.");
+			symbols.erase(end, symbols.end());
+		}
+	}
+
+	{
+		// TRACE("prepare edges");
 
-		const std::vector<StorageNode>& nodes = injected->getStorageNodes();
+		std::vector<StorageEdge>& batchEdges = batch->edges;
+		batchEdges = edges;
+		for (size_t i = 0; i < batchEdges.size(); i++)
+		{
+			StorageEdge& edge = batchEdges[i];
+			edge.id = batch->edgeSlotOffset + i;
+			edge.sourceNodeId = getElementSlot(edge.sourceNodeId);
+			edge.targetNodeId = getElementSlot(edge.targetNodeId);
+		}
+
+		auto end = std::stable_partition(
+			batchEdges.begin(), batchEdges.end(), [noSlot](const StorageEdge& edge) {
+				return edge.sourceNodeId != noSlot && edge.targetNodeId != noSlot;
+			});
+		if (end != batchEdges.end())
+		{
+			LOG_WARNING(
+				std::to_string(std::distance(end, batchEdges.end())) +
+				" new edge source or target ids could not be found.");
+			batchEdges.erase(end, batchEdges.end());
+		}
+
+		for (size_t i = 0; i < edges.size(); i++)
+		{
+			injectedIdToElementSlot[edges[i].id] = batch->edgeSlotOffset + i;
+		}
+	}
+
+	{
+		size_t i = batch->localSymbolSlotOffset;
+		for (const StorageLocalSymbol& symbol: localSymbols)
+		{
+			injectedIdToElementSlot[symbol.id] = i++;
+		}
+	}
+
+	const std::set<StorageSourceLocation>& oldLocations = injected->getStorageSourceLocations();
+
+	Id maxSourceLocationId = 0;
+	for (const StorageSourceLocation& location: oldLocations)
+	{
+		maxSourceLocationId = std::max(maxSourceLocationId, location.id);
+	}
+
+	std::vector<size_t> injectedIdToSourceLocationSlot(maxSourceLocationId + 1, noSlot);
+	auto getSourceLocationSlot = [&injectedIdToSourceLocationSlot, noSlot](Id id) {
+		return id < injectedIdToSourceLocationSlot.size() ? injectedIdToSourceLocationSlot[id]
+														  : noSlot;
+	};
+
+	{
+		// TRACE("prepare locations");
 
-		std::vector<Id> nodeIds = addNodes(nodes);
+		std::vector<StorageSourceLocation>& locations = batch->sourceLocations;
+		locations.reserve(oldLocations.size());
 
-		for (size_t i = 0; i < nodes.size(); i++)
+		for (const StorageSourceLocation& location: oldLocations)
 		{
-			if (nodeIds[i])
+			const size_t fileSlot = getElementSlot(location.fileNodeId);
+			if (fileSlot != noSlot)
 			{
-				injectedIdToOwnElementId.emplace(nodes[i].id, nodeIds[i]);
+				injectedIdToSourceLocationSlot[location.id] = locations.size();
+				locations.emplace_back(
+					locations.size(),
+					fileSlot,
+					location.startLine,
+					location.startCol,
+					location.endLine,
+					location.endCol,
+					location.type);
 			}
 		}
 	}
 
+	{
+		// TRACE("prepare occurrences");
+
+		const std::set<StorageOccurrence>& oldOccurences = injected->getStorageOccurrences();
+		batch->occurrences.reserve(oldOccurences.size());
+
+		for (const StorageOccurrence& occurrence: oldOccurences)
+		{
+			const size_t elementSlot = getElementSlot(occurrence.elementId);
+			const size_t locationSlot = getSourceLocationSlot(occurrence.sourceLocationId);
+
+			if (elementSlot == noSlot)
+			{
+				LOG_WARNING("New occurrence element id could not be found.");
+			}
+			else if (locationSlot == noSlot)
+			{
+				LOG_WARNING("New occurrence location id could not be found.");
+			}
+			else
+			{
+				batch->occurrences.emplace_back(elementSlot, locationSlot);
+			}
+		}
+	}
+
+	{
+		// TRACE("prepare element components");
+
+		const std::set<StorageElementComponent>& oldComponents = injected->getElementComponents();
+		batch->elementComponents.reserve(oldComponents.size());
+
+		for (const StorageElementComponent& component: oldComponents)
+		{
+			const size_t slot = getElementSlot(component.elementId);
+			if (slot != noSlot)
+			{
+				batch->elementComponents.emplace_back(slot, component.type, component.data);
+			}
+		}
+	}
+
+	{
+		// TRACE("prepare accesses");
+
+		const std::set<StorageComponentAccess>& oldAccesses = injected->getComponentAccesses();
+		batch->componentAccesses.reserve(oldAccesses.size());
+
+		for (const StorageComponentAccess& access: oldAccesses)
+		{
+			const size_t slot = getElementSlot(access.nodeId);
+			if (slot != noSlot)
+			{
+				batch->componentAccesses.emplace_back(slot, access.type);
+			}
+		}
+	}
+
+	return batch;
+}
+
+void Storage::inject(Storage* injected)
+{
+	inject(*prepareInjection(injected));
+}
+
+void Storage::inject(const InjectionBatch& batch)
+{
+	std::lock_guard<std::mutex> lock(m_dataMutex);
+
+	// ids assigned by this storage, indexed by the slots of the batch
+	std::vector<Id> ownElementIds(batch.elementSlotCount, 0);
+	std::vector<Id> ownSourceLocationIds(batch.sourceLocations.size(), 0);
+
+	TRACE();
+	startInjection();
+
+	{
+		// TRACE("inject errors");
+
+		const std::vector<StorageError>& errors = batch.source->getErrors();
+		for (size_t i = 0; i < errors.size(); i++)
+		{
+			ownElementIds[batch.errorSlotOffset + i] = addError(errors[i]);
+		}
+	}
+
+	{
+		// TRACE("inject nodes");
+
+		std::vector<Id> nodeIds = addNodes(batch.source->getStorageNodes());
+		std::copy(nodeIds.begin(), nodeIds.end(), ownElementIds.begin() + batch.nodeSlotOffset);
+	}
+
 	{
 		// TRACE("inject files");
 
-		for (const StorageFile& file: injected->getStorageFiles())
+		for (const StorageFile& file: batch.files)
 		{
-			auto it = injectedIdToOwnElementId.find(file.id);
-			if (it != injectedIdToOwnElementId.end())
+			if (const Id ownFileId = ownElementIds[file.id])
 			{
 				addFile(StorageFile(
-					it->second,
+					ownFileId,
 					file.filePath,
 					file.languageIdentifier,
 					file.modificationTime,
@@ -63,19 +300,18 @@ void Storage::inject(Storage* injected)
 	{
 		// TRACE("inject symbols");
 
-		std::vector<StorageSymbol> symbols = injected->getStorageSymbols();
-		for (size_t i = 0; i < symbols.size(); i++)
+		std::vector<StorageSymbol> symbols;
+		symbols.reserve(batch.symbols.size());
+
+		for (const StorageSymbol& symbol: batch.symbols)
 		{
-			auto it = injectedIdToOwnElementId.find(symbols[i].id);
-			if (it != injectedIdToOwnElementId.end())
+			if (const Id ownSymbolId = ownElementIds[symbol.id])
 			{
-				symbols[i].id = it->second;
+				symbols.emplace_back(ownSymbolId, symbol.definitionKind);
 			}
 			else
 			{
 				LOG_WARNING("New symbol id could not be found.");
-				symbols.erase(symbols.begin() + i);
-				i--;
 			}
 		}
 
@@ -85,31 +321,20 @@ void Storage::inject(Storage* injected)
 	{
 		// TRACE("inject edges");
 
-		std::vector<StorageEdge> edges = injected->getStorageEdges();
-		for (size_t i = 0; i < edges.size(); i++)
-		{
-			StorageEdge& edge = edges[i];
-			size_t updateCount = 0;
-
-			auto it = injectedIdToOwnElementId.find(edge.sourceNodeId);
-			if (it != injectedIdToOwnElementId.end())
-			{
-				edge.sourceNodeId = it->second;
-				updateCount++;
-			}
+		std::vector<StorageEdge> edges;
+		edges.reserve(batch.edges.size());
 
-			it = injectedIdToOwnElementId.find(edge.targetNodeId);
-			if (it != injectedIdToOwnElementId.end())
+		for (const StorageEdge& edge: batch.edges)
+		{
+			const Id ownSourceId = ownElementIds[edge.sourceNodeId];
+			const Id ownTargetId = ownElementIds[edge.targetNodeId];
+			if (ownSourceId && ownTargetId)
 			{
-				edge.targetNodeId = it->second;
-				updateCount++;
+				edges.emplace_back(edge.id, edge.type, ownSourceId, ownTargetId);
 			}
-
-			if (updateCount != 2)
+			else
 			{
 				LOG_WARNING("New edge source or target id could not be found.");
-				edges.erase(edges.begin() + i);
-				i--;
 			}
 		}
 
@@ -119,10 +344,7 @@ void Storage::inject(Storage* injected)
 		{
 			for (size_t i = 0; i < edgeIds.size(); i++)
 			{
-				if (edgeIds[i])
-				{
-					injectedIdToOwnElementId.emplace(edges[i].id, edgeIds[i]);
-				}
+				ownElementIds[edges[i].id] = edgeIds[i];
 			}
 		}
 		else
@@ -134,33 +356,23 @@ void Storage::inject(Storage* injected)
 	{
 		// TRACE("inject local symbols");
 
-		const std::set<StorageLocalSymbol>& symbols = injected->getStorageLocalSymbols();
-		std::vector<Id> symbolIds = addLocalSymbols(symbols);
-
-		auto it = symbols.begin();
-		for (size_t i = 0; i < symbols.size(); i++)
-		{
-			if (symbolIds[i])
-			{
-				injectedIdToOwnElementId.emplace(it->id, symbolIds[i]);
-			}
-			it++;
-		}
+		std::vector<Id> symbolIds = addLocalSymbols(batch.source->getStorageLocalSymbols());
+		std::copy(
+			symbolIds.begin(),
+			symbolIds.end(),
+			ownElementIds.begin() + batch.localSymbolSlotOffset);
 	}
 
 	{
 		// TRACE("inject locations");
 
-		const std::set<StorageSourceLocation>& oldLocations = injected->getStorageSourceLocations();
 		std::vector<StorageSourceLocation> locations;
-		locations.reserve(oldLocations.size());
+		locations.reserve(batch.sourceLocations.size());
 
-		for (const StorageSourceLocation& location: oldLocations)
+		for (const StorageSourceLocation& location: batch.sourceLocations)
 		{
-			auto it = injectedIdToOwnElementId.find(location.fileNodeId);
-			if (it != injectedIdToOwnElementId.end())
+			if (const Id ownFileNodeId = ownElementIds[location.fileNodeId])
 			{
-				const Id ownFileNodeId = it->second;
 				locations.emplace_back(
 					location.id,
 					ownFileNodeId,
@@ -178,10 +390,7 @@ void Storage::inject(Storage* injected)
 		{
 			for (size_t i = 0; i < locationIds.size(); i++)
 			{
-				if (locationIds[i])
-				{
-					injectedIdToOwnSourceLocationId.emplace(locations[i].id, locationIds[i]);
-				}
+				ownSourceLocationIds[locations[i].id] = locationIds[i];
 			}
 		}
 		else
@@ -193,27 +402,13 @@ void Storage::inject(Storage* injected)
 	{
 		// TRACE("inject occurrences");
 
-		const std::set<StorageOccurrence>& oldOccurences = injected->getStorageOccurrences();
-
 		std::vector<StorageOccurrence> occurrences;
-		occurrences.reserve(oldOccurences.size());
+		occurrences.reserve(batch.occurrences.size());
 
-		for (const StorageOccurrence& occurrence: oldOccurences)
+		for (const StorageOccurrence& occurrence: batch.occurrences)
 		{
-			Id elementId = 0;
-			Id sourceLocationId = 0;
-
-			auto it = injectedIdToOwnElementId.find(occurrence.elementId);
-			if (it != injectedIdToOwnElementId.end())
-			{
-				elementId = it->second;
-			}
-
-			it = injectedIdToOwnSourceLocationId.find(occurrence.sourceLocationId);
-			if (it != injectedIdToOwnSourceLocationId.end())
-			{
-				sourceLocationId = it->second;
-			}
+			const Id elementId = ownElementIds[occurrence.elementId];
+			const Id sourceLocationId = ownSourceLocationIds[occurrence.sourceLocationId];
 
 			if (!elementId)
 			{
@@ -235,16 +430,14 @@ void Storage::inject(Storage* injected)
 	{
 		// TRACE("inject element components");
 
-		const std::set<StorageElementComponent>& oldComponents = injected->getElementComponents();
 		std::vector<StorageElementComponent> components;
-		components.reserve(oldComponents.size());
+		components.reserve(batch.elementComponents.size());
 
-		for (const StorageElementComponent& component: oldComponents)
+		for (const StorageElementComponent& component: batch.elementComponents)
 		{
-			auto it = injectedIdToOwnElementId.find(component.elementId);
-			if (it != injectedIdToOwnElementId.end())
+			if (const Id ownElementId = ownElementIds[component.elementId])
 			{
-				components.emplace_back(it->second, component.type, component.data);
+				components.emplace_back(ownElementId, component.type, component.data);
 			}
 		}
 
@@ -254,16 +447,14 @@ void Storage::inject(Storage* injected)
 	{
 		// TRACE("inject accesses");
 
-		const std::set<StorageComponentAccess>& oldAccesses = injected->getComponentAccesses();
 		std::vector<StorageComponentAccess> accesses;
-		accesses.reserve(oldAccesses.size());
+		accesses.reserve(batch.componentAccesses.size());
 
-		for (const StorageComponentAccess& access: oldAccesses)
+		for (const StorageComponentAccess& access: batch.componentAccesses)
 		{
-			auto it = injectedIdToOwnElementId.find(access.nodeId);
-			if (it != injectedIdToOwnElementId.end())
+			if (const Id ownNodeId = ownElementIds[access.nodeId])
 			{
-				accesses.emplace_back(it->second, access.type);
+				accesses.emplace_back(ownNodeId, access.type);
 			}
 		}
 
@@ -2,9 +2,11 @@
 #define STORAGE_H
 
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "StorageComponentAccess.h"
 #include "StorageEdge.h"
@@ -21,6 +23,30 @@
 class Storage
 {
 public:
+	// Injected data with all element references already resolved to batch local slots. Preparing a
+	// batch is CPU-bound and does not touch the target storage, so it can overlap with writing the
+	// previous batch. Element ids of the contained data refer to slots, not to ids of any storage.
+	struct InjectionBatch
+	{
+		const Storage* source = nullptr;	// needs to outlive the batch
+
+		size_t errorSlotOffset = 0;
+		size_t nodeSlotOffset = 0;
+		size_t edgeSlotOffset = 0;
+		size_t localSymbolSlotOffset = 0;
+		size_t elementSlotCount = 0;
+
+		std::vector<StorageFile> files;
+		std::vector<StorageSymbol> symbols;
+		std::vector<StorageEdge> edges;
+		std::vector<StorageSourceLocation> sourceLocations;
+		std::vector<StorageOccurrence> occurrences;
+		std::vector<StorageElementComponent> elementComponents;
+		std::vector<StorageComponentAccess> componentAccesses;
+	};
+
+	static std::shared_ptr<InjectionBatch> prepareInjection(const Storage* injected);
+
 	Storage();
 	virtual ~Storage() = default;
 
@@ -55,6 +81,7 @@ public:
 	virtual const std::vector<StorageError>& getErrors() const = 0;
 
 	void inject(Storage* injected);
+	void inject(const InjectionBatch& batch);
 
 private:
 	virtual void startInjection();
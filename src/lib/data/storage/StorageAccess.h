@@ -1,6 +1,7 @@
 #ifndef STORAGE_ACCESS_H
 #define STORAGE_ACCESS_H
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -62,7 +63,8 @@ public:
 	virtual std::shared_ptr<Graph> getGraphForActiveTokenIds(
 		const std::vector<Id>& tokenIds,
 		const std::vector<Id>& expandedNodeIds,
-		bool* isActiveNamespace = nullptr) const = 0;
+		bool* isActiveNamespace = nullptr,
+		const std::function<bool()>& isCancelled = nullptr) const = 0;
 	virtual std::shared_ptr<Graph> getGraphForChildrenOfNodeId(Id nodeId) const = 0;
 	virtual std::shared_ptr<Graph> getGraphForTrail(
 		Id originId,
@@ -71,7 +73,8 @@ public:
 		Edge::TypeMask edgeTypes,
 		bool nodeNonIndexed,
 		size_t depth,
-		bool directed) const = 0;
+		bool directed,
+		size_t maxPathCount) const = 0;
 
 	virtual NodeKindMask getAvailableNodeTypes() const = 0;
 	virtual Edge::TypeMask getAvailableEdgeTypes() const = 0;
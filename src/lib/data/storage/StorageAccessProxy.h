@@ -10,7 +10,7 @@ class StorageAccessProxy: public StorageAccess
 public:
 	StorageAccessProxy() = default;
 
-	void setSubject(std::weak_ptr<StorageAccess> subject);
+	virtual void setSubject(std::weak_ptr<StorageAccess> subject);
 
 	// StorageAccess implementation
 	Id getNodeIdForFileNode(const FilePath& filePath) const override;
@@ -38,7 +38,8 @@ public:
 	std::shared_ptr<Graph> getGraphForActiveTokenIds(
 		const std::vector<Id>& tokenIds,
 		const std::vector<Id>& expandedNodeIds,
-		bool* isActiveNamespace = nullptr) const override;
+		bool* isActiveNamespace = nullptr,
+		const std::function<bool()>& isCancelled = nullptr) const override;
 	std::shared_ptr<Graph> getGraphForChildrenOfNodeId(Id nodeId) const override;
 	std::shared_ptr<Graph> getGraphForTrail(
 		Id originId,
@@ -47,7 +48,8 @@ public:
 		Edge::TypeMask edgeTypes,
 		bool nodeNonIndexed,
 		size_t depth,
-		bool directed) const override;
+		bool directed,
+		size_t maxPathCount) const override;
 
 	NodeKindMask getAvailableNodeTypes() const override;
 	Edge::TypeMask getAvailableEdgeTypes() const override;
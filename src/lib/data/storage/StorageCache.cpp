@@ -1,10 +1,40 @@
 #include "StorageCache.h"
 
+#include "Graph.h"
 #include "SourceLocationCollection.h"
 #include "SourceLocationFile.h"
 #include "TextAccess.h"
 #include "utility.h"
 
+namespace
+{
+const size_t s_maxCachedQueryResultCount = 20;
+
+std::shared_ptr<Graph> copyGraph(const Graph& graph)
+{
+	std::shared_ptr<Graph> copy = std::make_shared<Graph>();
+	graph.forEachNode([&copy](Node* node) { copy->addNodeAsPlainCopy(node); });
+	graph.forEachEdge([&copy](Edge* edge) { copy->addEdgeAsPlainCopy(edge); });
+	copy->setTrailMode(graph.getTrailMode());
+	copy->setHasTrailOrigin(graph.hasTrailOrigin());
+	return copy;
+}
+
+std::shared_ptr<SourceLocationCollection> copySourceLocations(
+	const SourceLocationCollection& collection)
+{
+	std::shared_ptr<SourceLocationCollection> copy = std::make_shared<SourceLocationCollection>();
+	copy->addSourceLocationCopies(&collection);
+	return copy;
+}
+}	 // namespace
+
+StorageCache::StorageCache()
+	: m_graphsForActiveTokenIds(s_maxCachedQueryResultCount)
+	, m_sourceLocationsForTokenIds(s_maxCachedQueryResultCount)
+{
+}
+
 void StorageCache::clear()
 {
 	m_graphForAll.reset();
@@ -12,6 +42,15 @@ void StorageCache::clear()
 	m_storageStats = StorageStats();
 
 	setUseErrorCache(false);
+
+	clearQueryResults();
+}
+
+void StorageCache::setSubject(std::weak_ptr<StorageAccess> subject)
+{
+	StorageAccessProxy::setSubject(subject);
+
+	clearQueryResults();
 }
 
 std::shared_ptr<Graph> StorageCache::getGraphForAll() const
@@ -24,6 +63,77 @@ std::shared_ptr<Graph> StorageCache::getGraphForAll() const
 	return m_graphForAll;
 }
 
+std::shared_ptr<Graph> StorageCache::getGraphForActiveTokenIds(
+	const std::vector<Id>& tokenIds,
+	const std::vector<Id>& expandedNodeIds,
+	bool* isActiveNamespace,
+	const std::function<bool()>& isCancelled) const
+{
+	const std::pair<std::vector<Id>, std::vector<Id>> key(tokenIds, expandedNodeIds);
+
+	GraphForActiveTokenIds result;
+	size_t version = 0;
+	{
+		std::lock_guard<std::mutex> lock(m_queryResultsMutex);
+		if (!m_graphsForActiveTokenIds.getValue(key, &result))
+		{
+			version = m_queryResultsVersion;
+		}
+	}
+
+	if (!result.graph)
+	{
+		result.graph = StorageAccessProxy::getGraphForActiveTokenIds(
+			tokenIds, expandedNodeIds, &result.isActiveNamespace, isCancelled);
+
+		// the graph of a cancelled query is incomplete
+		if (isCancelled && isCancelled())
+		{
+			return result.graph;
+		}
+
+		std::lock_guard<std::mutex> lock(m_queryResultsMutex);
+		if (version == m_queryResultsVersion)
+		{
+			m_graphsForActiveTokenIds.setValue(key, result);
+		}
+	}
+
+	if (isActiveNamespace)
+	{
+		*isActiveNamespace = result.isActiveNamespace;
+	}
+
+	return copyGraph(*result.graph);
+}
+
+std::shared_ptr<SourceLocationCollection> StorageCache::getSourceLocationsForTokenIds(
+	const std::vector<Id>& tokenIds) const
+{
+	std::shared_ptr<SourceLocationCollection> collection;
+	size_t version = 0;
+	{
+		std::lock_guard<std::mutex> lock(m_queryResultsMutex);
+		if (!m_sourceLocationsForTokenIds.getValue(tokenIds, &collection))
+		{
+			version = m_queryResultsVersion;
+		}
+	}
+
+	if (!collection)
+	{
+		collection = StorageAccessProxy::getSourceLocationsForTokenIds(tokenIds);
+
+		std::lock_guard<std::mutex> lock(m_queryResultsMutex);
+		if (version == m_queryResultsVersion)
+		{
+			m_sourceLocationsForTokenIds.setValue(tokenIds, collection);
+		}
+	}
+
+	return copySourceLocations(*collection);
+}
+
 StorageStats StorageCache::getStorageStats() const
 {
 	if (!m_storageStats.nodeCount)
@@ -121,3 +231,11 @@ void StorageCache::addErrorsToCache(
 	utility::append(m_cachedErrors, newErrors);
 	m_errorCount = errorCount;
 }
+
+void StorageCache::clearQueryResults()
+{
+	std::lock_guard<std::mutex> lock(m_queryResultsMutex);
+	m_graphsForActiveTokenIds.clear();
+	m_sourceLocationsForTokenIds.clear();
+	m_queryResultsVersion++;
+}
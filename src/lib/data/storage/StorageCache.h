@@ -2,15 +2,29 @@
 #define STORAGE_CACHE_H
 
 #include <map>
+#include <mutex>
 
+#include "LruCache.h"
 #include "StorageAccessProxy.h"
 
 class StorageCache: public StorageAccessProxy
 {
 public:
+	StorageCache();
+
 	void clear();
 
+	void setSubject(std::weak_ptr<StorageAccess> subject) override;
+
 	std::shared_ptr<Graph> getGraphForAll() const override;
+	std::shared_ptr<Graph> getGraphForActiveTokenIds(
+		const std::vector<Id>& tokenIds,
+		const std::vector<Id>& expandedNodeIds,
+		bool* isActiveNamespace = nullptr,
+		const std::function<bool()>& isCancelled = nullptr) const override;
+
+	std::shared_ptr<SourceLocationCollection> getSourceLocationsForTokenIds(
+		const std::vector<Id>& tokenIds) const override;
 
 	StorageStats getStorageStats() const override;
 
@@ -28,7 +42,26 @@ public:
 		const std::vector<ErrorInfo>& newErrors, const ErrorCountInfo& errorCount) override;
 
 private:
+	struct GraphForActiveTokenIds
+	{
+		std::shared_ptr<Graph> graph;
+		bool isActiveNamespace = false;
+	};
+
+	void clearQueryResults();
+
 	mutable std::shared_ptr<Graph> m_graphForAll;
+
+	// results of recent queries are kept to make navigating back and forth through the history
+	// cheap. Callers modify the returned objects, so only copies of the cached results leave the
+	// cache.
+	mutable LruCache<std::pair<std::vector<Id>, std::vector<Id>>, GraphForActiveTokenIds>
+		m_graphsForActiveTokenIds;
+	mutable LruCache<std::vector<Id>, std::shared_ptr<SourceLocationCollection>>
+		m_sourceLocationsForTokenIds;
+	mutable size_t m_queryResultsVersion = 0;
+	mutable std::mutex m_queryResultsMutex;
+
 	mutable StorageStats m_storageStats;
 
 	bool m_useErrorCache = false;
@@ -30,17 +30,20 @@ void StorageProvider::insert(std::shared_ptr<IntermediateStorage> storage)
 	m_storages.insert(it, storage);
 }
 
-std::shared_ptr<IntermediateStorage> StorageProvider::consumeSecondLargestStorage()
+std::pair<std::shared_ptr<IntermediateStorage>, std::shared_ptr<IntermediateStorage>>
+	StorageProvider::consumeStoragesToMerge()
 {
-	std::shared_ptr<IntermediateStorage> ret;
+	std::pair<std::shared_ptr<IntermediateStorage>, std::shared_ptr<IntermediateStorage>> ret;
 	{
 		std::lock_guard<std::mutex> lock(m_storagesMutex);
-		if (m_storages.size() > 1)
+		if (m_storages.size() > 2)
 		{
-			std::list<std::shared_ptr<IntermediateStorage>>::iterator it = m_storages.begin();
-			it++;
-			ret = *it;
-			m_storages.erase(it);
+			// merging the smallest storages first keeps the merge tree balanced, so concurrent
+			// merge tasks work on similarly sized inputs
+			ret.second = m_storages.back();
+			m_storages.pop_back();
+			ret.first = m_storages.back();
+			m_storages.pop_back();
 		}
 	}
 	return ret;
@@ -15,8 +15,10 @@ public:
 
 	void insert(std::shared_ptr<IntermediateStorage> storage);
 
-	// returns empty shared_ptr if no storages available
-	std::shared_ptr<IntermediateStorage> consumeSecondLargestStorage();
+	// returns the two smallest storages with the larger one first, the largest storage is left for
+	// injection. returns empty shared_ptrs if less than three storages are available
+	std::pair<std::shared_ptr<IntermediateStorage>, std::shared_ptr<IntermediateStorage>>
+		consumeStoragesToMerge();
 
 	// returns empty shared_ptr if no storages available
 	std::shared_ptr<IntermediateStorage> consumeLargestStorage();
@@ -9,9 +9,10 @@
 #include "SourceLocationFile.h"
 #include "TextAccess.h"
 #include "logging.h"
+#include "utilityHash.h"
 #include "utilityString.h"
 
-const size_t SqliteIndexStorage::s_storageVersion = 25;
+const size_t SqliteIndexStorage::s_storageVersion = 26;
 
 namespace
 {
@@ -75,6 +76,111 @@ void SqliteIndexStorage::setProjectSettingsText(std::string text)
 	insertOrUpdateMetaValue("project_settings", text);
 }
 
+std::map<FilePath, size_t> SqliteIndexStorage::getIndexingDurations() const
+{
+	std::map<FilePath, size_t> durations;
+
+	if (!hasTable("indexing_duration"))
+	{
+		return durations;
+	}
+
+	CppSQLite3Query q = executeQuery("SELECT path, duration_ms FROM indexing_duration;");
+	while (!q.eof())
+	{
+		const std::string filePath = q.getStringField(0, "");
+		const sqlite_int64 duration = q.getInt64Field(1, -1);
+
+		if (filePath.size() && duration >= 0)
+		{
+			durations.emplace(FilePath(utility::decodeFromUtf8(filePath)), duration);
+		}
+
+		q.nextRow();
+	}
+
+	return durations;
+}
+
+void SqliteIndexStorage::setIndexingDurations(const std::map<FilePath, size_t>& durations)
+{
+	CppSQLite3Statement stmt = m_database.compileStatement(
+		"INSERT OR REPLACE INTO indexing_duration(path, duration_ms) VALUES(?, ?);");
+
+	for (const auto& p: durations)
+	{
+		stmt.bind(1, utility::encodeToUtf8(p.first.wstr()).c_str());
+		stmt.bind(2, static_cast<sqlite_int64>(p.second));
+		executeStatement(stmt);
+	}
+}
+
+std::map<FilePath, std::map<std::string, size_t>> SqliteIndexStorage::getIndexingPhaseDurations()
+	const
+{
+	std::map<FilePath, std::map<std::string, size_t>> phaseDurations;
+
+	if (!hasTable("indexing_phase_duration"))
+	{
+		return phaseDurations;
+	}
+
+	CppSQLite3Query q = executeQuery(
+		"SELECT path, phase, duration_ms FROM indexing_phase_duration;");
+	while (!q.eof())
+	{
+		const std::string filePath = q.getStringField(0, "");
+		const std::string phase = q.getStringField(1, "");
+		const sqlite_int64 duration = q.getInt64Field(2, -1);
+
+		if (phase.size() && duration >= 0)
+		{
+			phaseDurations[FilePath(utility::decodeFromUtf8(filePath))][phase] = duration;
+		}
+
+		q.nextRow();
+	}
+
+	return phaseDurations;
+}
+
+void SqliteIndexStorage::setIndexingPhaseDurations(
+	const std::map<FilePath, std::map<std::string, size_t>>& phaseDurations)
+{
+	CppSQLite3Statement deleteStmt = m_database.compileStatement(
+		"DELETE FROM indexing_phase_duration WHERE path = ?;");
+	CppSQLite3Statement insertStmt = m_database.compileStatement(
+		"INSERT INTO indexing_phase_duration(path, phase, duration_ms) VALUES(?, ?, ?);");
+
+	for (const auto& p: phaseDurations)
+	{
+		const std::string filePath = utility::encodeToUtf8(p.first.wstr());
+
+		deleteStmt.bind(1, filePath.c_str());
+		executeStatement(deleteStmt);
+
+		for (const auto& phase: p.second)
+		{
+			insertStmt.bind(1, filePath.c_str());
+			insertStmt.bind(2, phase.first.c_str());
+			insertStmt.bind(3, static_cast<sqlite_int64>(phase.second));
+			executeStatement(insertStmt);
+		}
+	}
+}
+
+void SqliteIndexStorage::removeIndexingPhaseDurations(const std::vector<FilePath>& filePaths)
+{
+	CppSQLite3Statement deleteStmt = m_database.compileStatement(
+		"DELETE FROM indexing_phase_duration WHERE path = ?;");
+
+	for (const FilePath& filePath: filePaths)
+	{
+		deleteStmt.bind(1, utility::encodeToUtf8(filePath.wstr()).c_str());
+		executeStatement(deleteStmt);
+	}
+}
+
 Id SqliteIndexStorage::addNode(const StorageNodeData& data)
 {
 	std::vector<Id> ids = addNodes({StorageNode(0, data)});
@@ -184,10 +290,12 @@ bool SqliteIndexStorage::addFile(const StorageFile& data)
 
 	std::shared_ptr<TextAccess> content;
 	int lineCount = 0;
+	std::string contentHash;
 	if (data.indexed)
 	{
 		content = TextAccess::createFromFile(filePath);
 		lineCount = content->getLineCount();
+		contentHash = utility::getContentHash(content->getText());
 	}
 
 	bool success = false;
@@ -199,6 +307,14 @@ bool SqliteIndexStorage::addFile(const StorageFile& data)
 		m_insertFileStmt.bind(5, data.indexed);
 		m_insertFileStmt.bind(6, data.complete);
 		m_insertFileStmt.bind(7, lineCount);
+		if (content)
+		{
+			m_insertFileStmt.bind(8, contentHash.c_str());
+		}
+		else
+		{
+			m_insertFileStmt.bindNull(8);
+		}
 		success = executeStatement(m_insertFileStmt);
 	}
 
@@ -848,6 +964,22 @@ std::vector<StorageFile> SqliteIndexStorage::getFilesByPaths(const std::vector<F
 		"WHERE file.path IN ('" + utility::join(utility::toStrings(filePaths), "', '") + "')");
 }
 
+std::map<FilePath, std::string> SqliteIndexStorage::getFileContentHashes() const
+{
+	std::map<FilePath, std::string> contentHashes;
+
+	CppSQLite3Query q = executeQuery(
+		"SELECT path, content_hash FROM file WHERE content_hash IS NOT NULL;");
+	while (!q.eof())
+	{
+		contentHashes.emplace(
+			FilePath(utility::decodeFromUtf8(q.getStringField(0, ""))), q.getStringField(1, ""));
+		q.nextRow();
+	}
+
+	return contentHashes;
+}
+
 std::shared_ptr<TextAccess> SqliteIndexStorage::getFileContentById(Id fileId) const
 {
 	CppSQLite3Query q = executeQuery(
@@ -1227,6 +1359,8 @@ void SqliteIndexStorage::clearTables()
 		m_database.execDML("DROP TABLE IF EXISTS main.element_component;");
 		m_database.execDML("DROP TABLE IF EXISTS main.element;");
 		m_database.execDML("DROP TABLE IF EXISTS main.meta;");
+		m_database.execDML("DROP TABLE IF EXISTS main.indexing_duration;");
+		m_database.execDML("DROP TABLE IF EXISTS main.indexing_phase_duration;");
 	}
 	catch (CppSQLite3Exception& e)
 	{
@@ -1288,6 +1422,7 @@ void SqliteIndexStorage::setupTables()
 			"indexed INTEGER, "
 			"complete INTEGER, "
 			"line_count INTEGER, "
+			"content_hash TEXT, "
 			"PRIMARY KEY(id), "
 			"FOREIGN KEY(id) REFERENCES node(id) ON DELETE CASCADE);");
 
@@ -1343,6 +1478,19 @@ void SqliteIndexStorage::setupTables()
 			"translation_unit TEXT, "
 			"PRIMARY KEY(id), "
 			"FOREIGN KEY(id) REFERENCES element(id) ON DELETE CASCADE);");
+
+		m_database.execDML(
+			"CREATE TABLE IF NOT EXISTS indexing_duration("
+			"path TEXT NOT NULL, "
+			"duration_ms INTEGER NOT NULL, "
+			"PRIMARY KEY(path));");
+
+		m_database.execDML(
+			"CREATE TABLE IF NOT EXISTS indexing_phase_duration("
+			"path TEXT NOT NULL, "
+			"phase TEXT NOT NULL, "
+			"duration_ms INTEGER NOT NULL, "
+			"PRIMARY KEY(path, phase));");
 	}
 	catch (CppSQLite3Exception& e)
 	{
@@ -1426,7 +1574,7 @@ void SqliteIndexStorage::setupPrecompiledStatements()
 			"INSERT INTO element_component(id, element_id, type, data) VALUES(NULL, ?, ?, ?);");
 		m_insertFileStmt = m_database.compileStatement(
 			"INSERT INTO file(id, path, language, modification_time, indexed, complete, "
-			"line_count) VALUES(?, ?, ?, ?, ?, ?, ?);");
+			"line_count, content_hash) VALUES(?, ?, ?, ?, ?, ?, ?, ?);");
 		m_insertFileContentStmt = m_database.compileStatement(
 			"INSERT INTO filecontent(id, content) VALUES(?, ?);");
 		m_checkErrorExistsStmt = m_database.compileStatement(
@@ -1,6 +1,7 @@
 #ifndef SQLITE_INDEX_STORAGE_H
 #define SQLITE_INDEX_STORAGE_H
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -50,6 +51,18 @@ public:
 	std::string getProjectSettingsText() const;
 	void setProjectSettingsText(std::string text);
 
+	// indexing duration in milliseconds of each indexed source file, used to schedule the most
+	// expensive translation units first on the next indexing run
+	std::map<FilePath, size_t> getIndexingDurations() const;
+	void setIndexingDurations(const std::map<FilePath, size_t>& durations);
+
+	// profile of the last indexing run of each source file in milliseconds per indexing phase,
+	// phases that are not attributable to a single source file are stored with an empty path
+	std::map<FilePath, std::map<std::string, size_t>> getIndexingPhaseDurations() const;
+	void setIndexingPhaseDurations(
+		const std::map<FilePath, std::map<std::string, size_t>>& phaseDurations);
+	void removeIndexingPhaseDurations(const std::vector<FilePath>& filePaths);
+
 	Id addNode(const StorageNodeData& data);
 	std::vector<Id> addNodes(const std::vector<StorageNode>& nodes);
 	bool addSymbol(const StorageSymbol& data);
@@ -107,6 +120,8 @@ public:
 	StorageFile getFileByPath(const std::wstring& filePath) const;
 
 	std::vector<StorageFile> getFilesByPaths(const std::vector<FilePath>& filePaths) const;
+	// xxHash of the stored content of every indexed file
+	std::map<FilePath, std::string> getFileContentHashes() const;
 	std::shared_ptr<TextAccess> getFileContentByPath(const std::wstring& filePath) const;
 	std::shared_ptr<TextAccess> getFileContentById(Id fileId) const;
 
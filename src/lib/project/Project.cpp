@@ -22,6 +22,7 @@
 #include "TaskMergeStorages.h"
 #include "TaskParseWrapper.h"
 
+#include "FileInfo.h"
 #include "FilePath.h"
 #include "FileSystem.h"
 #include "MessageErrorCountClear.h"
@@ -94,6 +95,42 @@ bool Project::isIndexing() const
 	return m_refreshStage == RefreshStageType::INDEXING;
 }
 
+std::map<FilePath, std::map<std::string, size_t>> Project::getIndexingPhaseDurations() const
+{
+	if (!m_storage)
+	{
+		return std::map<FilePath, std::map<std::string, size_t>>();
+	}
+	return m_storage->getIndexingPhaseDurations();
+}
+
+std::set<FilePath> Project::getFilePathsToWatch() const
+{
+	std::set<FilePath> filePaths;
+
+	// indexed headers are only known to the storage, they are watched for the same source groups
+	// that the refresh checks them for
+	std::set<FilePath> storedFilePaths;
+	if (m_storage)
+	{
+		for (const FileInfo& fileInfo: m_storage->getFileInfoForAllFiles())
+		{
+			storedFilePaths.insert(fileInfo.path);
+		}
+	}
+
+	for (const std::shared_ptr<SourceGroup>& sourceGroup: m_sourceGroups)
+	{
+		if (sourceGroup->getStatus() == SOURCE_GROUP_STATUS_ENABLED)
+		{
+			utility::append(filePaths, sourceGroup->getAllSourceFilePaths());
+			utility::append(filePaths, sourceGroup->filterToContainedFilePaths(storedFilePaths));
+		}
+	}
+
+	return filePaths;
+}
+
 bool Project::settingsEqualExceptNameAndLocation(const ProjectSettings& otherSettings) const
 {
 	return m_settings->equalsExceptNameAndLocation(otherSettings);
@@ -605,6 +642,7 @@ void Project::buildIndex(RefreshInfo info, std::shared_ptr<DialogView> dialogVie
 	taskSequential->addTask(std::make_shared<TaskSetValue<int>>("indexed_source_file_count", 0));
 	taskSequential->addTask(std::make_shared<TaskSetValue<bool>>("interrupted_indexing", false));
 	taskSequential->addTask(std::make_shared<TaskSetValue<float>>("index_time", 0.0f));
+	taskSequential->addTask(std::make_shared<TaskSetValue<float>>("injection_time", 0.0f));
 
 	int indexerThreadCount = ApplicationSettings::getInstance()->getIndexerThreadCount();
 	if (indexerThreadCount <= 0)
@@ -638,7 +676,8 @@ void Project::buildIndex(RefreshInfo info, std::shared_ptr<DialogView> dialogVie
 		{
 			if (sourceGroup->getStatus() == SOURCE_GROUP_STATUS_ENABLED)
 			{
-				preIndexTasks->addTask(sourceGroup->getPreIndexTask(storageProvider, dialogView));
+				preIndexTasks->addTask(
+					sourceGroup->getPreIndexTask(info, storageProvider, dialogView));
 			}
 		}
 
@@ -652,7 +691,7 @@ void Project::buildIndex(RefreshInfo info, std::shared_ptr<DialogView> dialogVie
 
 		// add task for refilling the indexer command queue
 		taskParallelIndexing->addTask(std::make_shared<TaskFillIndexerCommandsQueue>(
-			m_appUUID, std::move(indexerCommandProvider), 20));
+			m_appUUID, std::move(indexerCommandProvider), 20, m_storage->getIndexingDurations()));
 
 		// add task for indexing
 		bool multiProcess = ApplicationSettings::getInstance()->getMultiProcessIndexingEnabled() &&
@@ -666,22 +705,27 @@ void Project::buildIndex(RefreshInfo info, std::shared_ptr<DialogView> dialogVie
 			std::make_shared<TaskBuildIndex>(
 				adjustedIndexerThreadCount, storageProvider, dialogView, m_appUUID, multiProcess)));
 
-		// add task for merging the intermediate storages
-		taskParallelIndexing->addTask(std::make_shared<TaskGroupSequence>()->addChildTasks(
-			// block until there are indexers running
-			std::make_shared<TaskDecoratorRepeat>(
-				TaskDecoratorRepeat::CONDITION_WHILE_SUCCESS, Task::STATE_SUCCESS, 25)
-				->addChildTask(std::make_shared<TaskReturnSuccessIf<bool>>(
-					"indexer_threads_started", TaskReturnSuccessIf<bool>::CONDITION_EQUALS, false)),
-			// merge until all indexers stopped and nothing left to merge
-			std::make_shared<TaskDecoratorRepeat>(
-				TaskDecoratorRepeat::CONDITION_WHILE_SUCCESS, Task::STATE_SUCCESS, 250)
-				->addChildTask(std::make_shared<TaskGroupSelector>()->addChildTasks(
-					std::make_shared<TaskMergeStorages>(storageProvider),
-					std::make_shared<TaskReturnSuccessIf<bool>>(
-						"indexer_threads_stopped",
-						TaskReturnSuccessIf<bool>::CONDITION_EQUALS,
-						false)))));
+		// add tasks for merging the intermediate storages, these form a merge tree that keeps
+		// reducing the smallest storages in parallel while the largest one is injected
+		const int mergerThreadCount = std::max<int>(1, adjustedIndexerThreadCount / 2);
+		for (int i = 0; i < mergerThreadCount; i++)
+		{
+			taskParallelIndexing->addTask(std::make_shared<TaskGroupSequence>()->addChildTasks(
+				// block until there are indexers running
+				std::make_shared<TaskDecoratorRepeat>(
+					TaskDecoratorRepeat::CONDITION_WHILE_SUCCESS, Task::STATE_SUCCESS, 25)
+					->addChildTask(std::make_shared<TaskReturnSuccessIf<bool>>(
+						"indexer_threads_started", TaskReturnSuccessIf<bool>::CONDITION_EQUALS, false)),
+				// merge until all indexers stopped and nothing left to merge
+				std::make_shared<TaskDecoratorRepeat>(
+					TaskDecoratorRepeat::CONDITION_WHILE_SUCCESS, Task::STATE_SUCCESS, 250)
+					->addChildTask(std::make_shared<TaskGroupSelector>()->addChildTasks(
+						std::make_shared<TaskMergeStorages>(storageProvider),
+						std::make_shared<TaskReturnSuccessIf<bool>>(
+							"indexer_threads_stopped",
+							TaskReturnSuccessIf<bool>::CONDITION_EQUALS,
+							false)))));
+		}
 
 		// add task for injecting the intermediate storages into the persistent storage
 		taskParallelIndexing->addTask(std::make_shared<TaskGroupSequence>()->addChildTasks(
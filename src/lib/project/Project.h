@@ -1,6 +1,7 @@
 #ifndef PROJECT_H
 #define PROJECT_H
 
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
@@ -32,6 +33,12 @@ public:
 	bool isLoaded() const;
 	bool isIndexing() const;
 
+	// profile of the last indexing run stored in the project database
+	std::map<FilePath, std::map<std::string, size_t>> getIndexingPhaseDurations() const;
+
+	// source files and indexed files, e.g. headers, of enabled source groups
+	std::set<FilePath> getFilePathsToWatch() const;
+
 	bool settingsEqualExceptNameAndLocation(const ProjectSettings& otherSettings) const;
 	void setStateOutdated();
 
@@ -1,5 +1,8 @@
 #include "RefreshInfoGenerator.h"
 
+#include <mutex>
+#include <thread>
+
 #include "FileInfo.h"
 #include "FileSystem.h"
 #include "PersistentStorage.h"
@@ -8,6 +11,8 @@
 #include "SourceGroupStatusType.h"
 #include "TextAccess.h"
 #include "utility.h"
+#include "utilityApp.h"
+#include "utilityHash.h"
 
 RefreshInfo RefreshInfoGenerator::getRefreshInfoForUpdatedFiles(
 	const std::vector<std::shared_ptr<SourceGroup>>& sourceGroups,
@@ -39,14 +44,27 @@ RefreshInfo RefreshInfoGenerator::getRefreshInfoForUpdatedFiles(
 			}
 		}
 
+		// the file system is checked once and in parallel, which matters for large projects
+		const std::vector<FileInfo> fileInfosFromDisk = FileSystem::getFileInfosForPaths(
+			utility::convert<FileInfo, FilePath>(
+				fileInfosFromStorage, [](const FileInfo& info) { return info.path; }));
+
+		const std::set<FilePath> contentChangedFilePaths = getChangedFilePaths(
+			fileInfosFromStorage, fileInfosFromDisk, storage);
+		auto didFileChange = [&contentChangedFilePaths](const FileInfo& info) {
+			return contentChangedFilePaths.find(info.path) != contentChangedFilePaths.end();
+		};
+
 		// checking source and header files
-		for (const FileInfo& info: fileInfosFromStorage)
+		for (size_t i = 0; i < fileInfosFromStorage.size(); i++)
 		{
-			if (alreadyKnownPaths.find(info.path) != alreadyKnownPaths.end() && info.path.exists())
+			const FileInfo& info = fileInfosFromStorage[i];
+			const bool exists = !fileInfosFromDisk[i].path.empty();
+			if (alreadyKnownPaths.find(info.path) != alreadyKnownPaths.end() && exists)
 			{
 				if (storage->getFilePathIndexed(info.path))
 				{
-					if (didFileChange(info, storage))
+					if (didFileChange(info))
 					{
 						changedFilePaths.insert(info.path);
 					}
@@ -60,7 +78,7 @@ RefreshInfo RefreshInfoGenerator::getRefreshInfoForUpdatedFiles(
 					changedFilePaths.insert(info.path);
 				}
 			}
-			else if (!storage->getFilePathIndexed(info.path) && !didFileChange(info, storage))
+			else if (!storage->getFilePathIndexed(info.path) && !didFileChange(info))
 			{
 				unchangedNonindexedFilePaths.insert(info.path);
 			}
@@ -211,55 +229,79 @@ RefreshInfo RefreshInfoGenerator::getRefreshInfoForAllFiles(
 std::set<FilePath> RefreshInfoGenerator::getAllSourceFilePaths(
 	const std::vector<std::shared_ptr<SourceGroup>>& sourceGroups)
 {
-	std::set<FilePath> allSourceFilePaths;
+	std::vector<FilePath> sourceFilePaths;
 
 	for (const std::shared_ptr<const SourceGroup>& sourceGroup: sourceGroups)
 	{
 		if (sourceGroup->getStatus() == SOURCE_GROUP_STATUS_ENABLED)
 		{
-			for (const FilePath& sourceFilePath: sourceGroup->getAllSourceFilePaths())
-			{
-				if (sourceFilePath.exists())
-				{
-					allSourceFilePaths.insert(sourceFilePath);
-				}
-			}
+			utility::append(
+				sourceFilePaths, utility::toVector(sourceGroup->getAllSourceFilePaths()));
+		}
+	}
+
+	std::set<FilePath> allSourceFilePaths;
+	for (const FileInfo& info: FileSystem::getFileInfosForPaths(sourceFilePaths))
+	{
+		if (!info.path.empty())
+		{
+			allSourceFilePaths.insert(info.path);
 		}
 	}
 
 	return allSourceFilePaths;
 }
 
-bool RefreshInfoGenerator::didFileChange(
-	const FileInfo& info, std::shared_ptr<const PersistentStorage> storage)
+std::set<FilePath> RefreshInfoGenerator::getChangedFilePaths(
+	const std::vector<FileInfo>& fileInfos,
+	const std::vector<FileInfo>& diskFileInfos,
+	std::shared_ptr<const PersistentStorage> storage)
 {
-	FileInfo diskFileInfo = FileSystem::getFileInfoForPath(info.path);
-	if (diskFileInfo.lastWriteTime > info.lastWriteTime)
+	// only files with a newer modification time are candidates, their content is hashed to ignore
+	// files that were just touched, e.g. by switching branches or by a build system
+	std::vector<FilePath> touchedFilePaths;
+	for (size_t i = 0; i < fileInfos.size(); i++)
 	{
-		if (!storage->hasContentForFile(info.path))
+		if (diskFileInfos[i].lastWriteTime > fileInfos[i].lastWriteTime)
 		{
-			return true;
+			touchedFilePaths.push_back(fileInfos[i].path);
 		}
+	}
 
-		std::shared_ptr<TextAccess> storedFileContent = storage->getFileContent(info.path, false);
-		std::shared_ptr<TextAccess> diskFileContent = TextAccess::createFromFile(diskFileInfo.path);
+	if (touchedFilePaths.empty())
+	{
+		return {};
+	}
 
-		const std::vector<std::string>& diskFileLines = diskFileContent->getAllLines();
-		const std::vector<std::string>& storedFileLines = storedFileContent->getAllLines();
+	const std::map<FilePath, std::string> storedContentHashes = storage->getFileContentHashes();
 
-		if (diskFileLines.size() != storedFileLines.size())
-		{
-			return true;
-		}
+	std::set<FilePath> changedFilePaths;
+	std::mutex changedFilePathsMutex;
+	std::vector<std::shared_ptr<std::thread>> threads;
+	for (const std::vector<FilePath>& filePaths: utility::splitToEqualySizedParts(
+			 touchedFilePaths, utility::getIdealThreadCount()))
+	{
+		threads.push_back(std::make_shared<std::thread>(
+			[&storedContentHashes, &changedFilePaths, &changedFilePathsMutex, filePaths]() {
+				for (const FilePath& filePath: filePaths)
+				{
+					// files without content hash were not indexed, so their content is unknown
+					auto it = storedContentHashes.find(filePath);
+					if (it == storedContentHashes.end() ||
+						it->second != utility::getContentHash(
+										  TextAccess::createFromFile(filePath)->getText()))
+					{
+						std::lock_guard<std::mutex> lock(changedFilePathsMutex);
+						changedFilePaths.insert(filePath);
+					}
+				}
+			}));
+	}
 
-		for (size_t i = 0; i < diskFileLines.size(); i++)
-		{
-			if (diskFileLines[i] != storedFileLines[i])
-			{
-				return true;
-			}
-		}
-		return false;
+	for (const std::shared_ptr<std::thread>& thread: threads)
+	{
+		thread->join();
 	}
-	return false;
+
+	return changedFilePaths;
 }
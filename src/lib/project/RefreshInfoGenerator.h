@@ -29,7 +29,12 @@ private:
 	static std::set<FilePath> getAllSourceFilePaths(
 		const std::vector<std::shared_ptr<SourceGroup>>& sourceGroups);
 
-	static bool didFileChange(const FileInfo& info, std::shared_ptr<const PersistentStorage> storage);
+	// Returns the files with a newer modification time on disk and a content that differs from the
+	// content that was indexed. "diskFileInfos" holds the current state of each of the "fileInfos".
+	static std::set<FilePath> getChangedFilePaths(
+		const std::vector<FileInfo>& fileInfos,
+		const std::vector<FileInfo>& diskFileInfos,
+		std::shared_ptr<const PersistentStorage> storage);
 };
 
 #endif	  // REFRESH_INFO_GENERATOR_H
@@ -13,7 +13,9 @@ std::shared_ptr<IndexerCommandProvider> SourceGroup::getIndexerCommandProvider(c
 }
 
 std::shared_ptr<Task> SourceGroup::getPreIndexTask(
-	std::shared_ptr<StorageProvider> storageProvider, std::shared_ptr<DialogView> dialogView) const
+	const RefreshInfo& info,
+	std::shared_ptr<StorageProvider> storageProvider,
+	std::shared_ptr<DialogView> dialogView) const
 {
 	return std::make_shared<TaskLambda>([]() {});
 }
@@ -389,6 +389,26 @@ void ApplicationSettings::setMultiProcessIndexingEnabled(bool enabled)
 	setValue<bool>("indexing/multi_process_indexing", enabled);
 }
 
+bool ApplicationSettings::getSkipIndexedHeadersEnabled() const
+{
+	return getValue<bool>("indexing/skip_indexed_headers", false);
+}
+
+void ApplicationSettings::setSkipIndexedHeadersEnabled(bool enabled)
+{
+	setValue<bool>("indexing/skip_indexed_headers", enabled);
+}
+
+bool ApplicationSettings::getImplicitPchEnabled() const
+{
+	return getValue<bool>("indexing/implicit_pch", true);
+}
+
+void ApplicationSettings::setImplicitPchEnabled(bool enabled)
+{
+	setValue<bool>("indexing/implicit_pch", enabled);
+}
+
 FilePath ApplicationSettings::getJavaPath() const
 {
 	return FilePath(getValue<std::wstring>("indexing/java/java_path", L""));
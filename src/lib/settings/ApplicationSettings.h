@@ -98,6 +98,12 @@ public:
 	bool getMultiProcessIndexingEnabled() const;
 	void setMultiProcessIndexingEnabled(bool enabled);
 
+	bool getSkipIndexedHeadersEnabled() const;
+	void setSkipIndexedHeadersEnabled(bool enabled);
+
+	bool getImplicitPchEnabled() const;
+	void setImplicitPchEnabled(bool enabled);
+
 	FilePath getJavaPath() const;
 	void setJavaPath(const FilePath& path);
 
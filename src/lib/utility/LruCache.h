@@ -0,0 +1,83 @@
+#ifndef LRU_CACHE_H
+#define LRU_CACHE_H
+
+#include <list>
+#include <map>
+#include <utility>
+
+// Keeps the values of the most recently used keys. Once more than maxSize values are stored, the
+// value that was used least recently gets dropped.
+template <typename KeyType, typename ValType>
+class LruCache
+{
+public:
+	LruCache(size_t maxSize);
+
+	bool getValue(const KeyType& key, ValType* value);
+	void setValue(const KeyType& key, const ValType& value);
+
+	size_t size() const;
+	void clear();
+
+private:
+	typedef std::list<std::pair<KeyType, ValType>> EntryList;
+
+	size_t m_maxSize;
+	EntryList m_entries;
+	std::map<KeyType, typename EntryList::iterator> m_entryIndex;
+};
+
+template <typename KeyType, typename ValType>
+LruCache<KeyType, ValType>::LruCache(size_t maxSize): m_maxSize(maxSize)
+{
+}
+
+template <typename KeyType, typename ValType>
+bool LruCache<KeyType, ValType>::getValue(const KeyType& key, ValType* value)
+{
+	auto it = m_entryIndex.find(key);
+	if (it == m_entryIndex.end())
+	{
+		return false;
+	}
+
+	m_entries.splice(m_entries.begin(), m_entries, it->second);
+	*value = it->second->second;
+	return true;
+}
+
+template <typename KeyType, typename ValType>
+void LruCache<KeyType, ValType>::setValue(const KeyType& key, const ValType& value)
+{
+	auto it = m_entryIndex.find(key);
+	if (it != m_entryIndex.end())
+	{
+		m_entries.splice(m_entries.begin(), m_entries, it->second);
+		it->second->second = value;
+		return;
+	}
+
+	m_entries.emplace_front(key, value);
+	m_entryIndex.emplace(key, m_entries.begin());
+
+	while (m_entries.size() > m_maxSize)
+	{
+		m_entryIndex.erase(m_entries.back().first);
+		m_entries.pop_back();
+	}
+}
+
+template <typename KeyType, typename ValType>
+size_t LruCache<KeyType, ValType>::size() const
+{
+	return m_entries.size();
+}
+
+template <typename KeyType, typename ValType>
+void LruCache<KeyType, ValType>::clear()
+{
+	m_entries.clear();
+	m_entryIndex.clear();
+}
+
+#endif	  // LRU_CACHE_H
@@ -7,6 +7,8 @@
 
 #include "CommandlineCommandConfig.h"
 #include "CommandlineCommandIndex.h"
+#include "CommandlineCommandMetrics.h"
+#include "CommandlineCommandWatch.h"
 #include "CommandlineHelper.h"
 #include "ConfigManager.h"
 #include "TextAccess.h"
@@ -28,6 +30,8 @@ CommandLineParser::CommandLineParser(const std::string& version): m_version(vers
 
 	m_commands.push_back(std::make_unique<commandline::CommandlineCommandConfig>(this));
 	m_commands.push_back(std::make_unique<commandline::CommandlineCommandIndex>(this));
+	m_commands.push_back(std::make_unique<commandline::CommandlineCommandWatch>(this));
+	m_commands.push_back(std::make_unique<commandline::CommandlineCommandMetrics>(this));
 
 	for (auto& command: m_commands)
 	{
@@ -235,6 +239,26 @@ void CommandLineParser::setShallowIndexingRequested(bool enabled)
 	m_shallowIndexingRequested = enabled;
 }
 
+void CommandLineParser::setIndexingProfileRequested(bool enabled)
+{
+	m_indexingProfileRequested = enabled;
+}
+
+void CommandLineParser::setWatchRequested(int debounceMs)
+{
+	m_watchRequested = true;
+	m_watchDebounceMs = debounceMs;
+}
+
+void CommandLineParser::setMetricsRequested(
+	size_t topCount, bool callsOnly, const FilePath& outputFilePath)
+{
+	m_metricsRequested = true;
+	m_metricsTopCount = topCount;
+	m_metricsCallsOnly = callsOnly;
+	m_metricsOutputFilePath = outputFilePath;
+}
+
 const FilePath& CommandLineParser::getProjectFilePath() const
 {
 	return m_projectFile;
@@ -250,4 +274,39 @@ bool CommandLineParser::getShallowIndexingRequested() const
 	return m_shallowIndexingRequested;
 }
 
+bool CommandLineParser::getIndexingProfileRequested() const
+{
+	return m_indexingProfileRequested;
+}
+
+bool CommandLineParser::getWatchRequested() const
+{
+	return m_watchRequested;
+}
+
+int CommandLineParser::getWatchDebounceMs() const
+{
+	return m_watchDebounceMs;
+}
+
+bool CommandLineParser::getMetricsRequested() const
+{
+	return m_metricsRequested;
+}
+
+size_t CommandLineParser::getMetricsTopCount() const
+{
+	return m_metricsTopCount;
+}
+
+bool CommandLineParser::getMetricsCallsOnly() const
+{
+	return m_metricsCallsOnly;
+}
+
+const FilePath& CommandLineParser::getMetricsOutputFilePath() const
+{
+	return m_metricsOutputFilePath;
+}
+
 }	 // namespace commandline
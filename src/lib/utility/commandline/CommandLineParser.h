@@ -35,12 +35,22 @@ public:
 	void fullRefresh();
 	void incompleteRefresh();
 	void setShallowIndexingRequested(bool enabled = true);
+	void setIndexingProfileRequested(bool enabled = true);
+	void setWatchRequested(int debounceMs);
+	void setMetricsRequested(size_t topCount, bool callsOnly, const FilePath& outputFilePath);
 
 	const FilePath& getProjectFilePath() const;
 	void setProjectFile(const FilePath& filepath);
 
 	RefreshMode getRefreshMode() const;
 	bool getShallowIndexingRequested() const;
+	bool getIndexingProfileRequested() const;
+	bool getWatchRequested() const;
+	int getWatchDebounceMs() const;
+	bool getMetricsRequested() const;
+	size_t getMetricsTopCount() const;
+	bool getMetricsCallsOnly() const;
+	const FilePath& getMetricsOutputFilePath() const;
 
 private:
 	void processProjectfile();
@@ -56,6 +66,13 @@ private:
 	FilePath m_projectFile;
 	RefreshMode m_refreshMode = REFRESH_UPDATED_FILES;
 	bool m_shallowIndexingRequested = false;
+	bool m_indexingProfileRequested = false;
+	bool m_watchRequested = false;
+	int m_watchDebounceMs = 0;
+	bool m_metricsRequested = false;
+	size_t m_metricsTopCount = 0;
+	bool m_metricsCallsOnly = false;
+	FilePath m_metricsOutputFilePath;
 
 	bool m_quit = false;
 	bool m_withoutGUI = false;
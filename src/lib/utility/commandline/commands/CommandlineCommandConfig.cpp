@@ -87,6 +87,14 @@ void CommandlineCommandConfig::setup()
 		"use-processes,p",
 		po::value<bool>(),
 		"Enable C/C++ Indexer threads to run in different processes. <true/false>")(
+		"skip-indexed-headers,H",
+		po::value<bool>(),
+		"Skip C/C++ headers that were already indexed by another translation unit with the same "
+		"compiler flags. <true/false>")(
+		"implicit-pch",
+		po::value<bool>(),
+		"Precompile the includes shared by C/C++ source files with the same compiler flags. "
+		"Enabled by default. <true/false>")(
 		"logging-enabled,l", po::value<bool>(), "Enable file/console logging <true/false>")(
 		"verbose-indexer-logging-enabled,L",
 		po::value<bool>(),
@@ -148,6 +156,8 @@ CommandlineCommand::ReturnStatus CommandlineCommandConfig::parse(std::vector<std
 		std::cout << "Sourcetrail Settings:\n"
 				  << "\n  indexer-threads: " << settings->getIndexerThreadCount()
 				  << "\n  use-processes: " << settings->getMultiProcessIndexingEnabled()
+				  << "\n  skip-indexed-headers: " << settings->getSkipIndexedHeadersEnabled()
+				  << "\n  implicit-pch: " << settings->getImplicitPchEnabled()
 				  << "\n  logging-enabled: " << settings->getLoggingEnabled()
 				  << "\n  verbose-indexer-logging-enabled: "
 				  << settings->getVerboseIndexerLoggingEnabled()
@@ -161,6 +171,9 @@ CommandlineCommand::ReturnStatus CommandlineCommandConfig::parse(std::vector<std
 
 	parseAndSetValue(
 		&ApplicationSettings::setMultiProcessIndexingEnabled, "use-processes", settings, vm);
+	parseAndSetValue(
+		&ApplicationSettings::setSkipIndexedHeadersEnabled, "skip-indexed-headers", settings, vm);
+	parseAndSetValue(&ApplicationSettings::setImplicitPchEnabled, "implicit-pch", settings, vm);
 	parseAndSetValue(&ApplicationSettings::setLoggingEnabled, "logging-enabled", settings, vm);
 	parseAndSetValue(
 		&ApplicationSettings::setVerboseIndexerLoggingEnabled,
@@ -23,6 +23,7 @@ void CommandlineCommandIndex::setup()
 		"incomplete,i", "Also reindex incomplete files (files with errors)")(
 		"full,f", "Index full project (omit to only index new/changed files)")(
 		"shallow,s", "Build a shallow index is supported by the project")(
+		"profile,p", "Print the slowest translation units and time spent per indexing phase")(
 		"project-file", po::value<std::string>(), "Project file to index (.srctrlprj)");
 
 	m_options.add(options);
@@ -67,6 +68,11 @@ CommandlineCommand::ReturnStatus CommandlineCommandIndex::parse(std::vector<std:
 		m_parser->setShallowIndexingRequested();
 	}
 
+	if (vm.count("profile"))
+	{
+		m_parser->setIndexingProfileRequested();
+	}
+
 	if (vm.count("project-file"))
 	{
 		m_parser->setProjectFile(FilePath(vm["project-file"].as<std::string>()));
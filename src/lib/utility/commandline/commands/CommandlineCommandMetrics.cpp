@@ -0,0 +1,83 @@
+#include "CommandlineCommandMetrics.h"
+
+#include <iostream>
+
+#include "CommandLineParser.h"
+#include "CommandlineHelper.h"
+
+namespace po = boost::program_options;
+
+namespace commandline
+{
+CommandlineCommandMetrics::CommandlineCommandMetrics(CommandLineParser* parser)
+	: CommandlineCommand(
+		  "metrics", "Compute graph metrics of an indexed project and print them as JSON.", parser)
+{
+}
+
+CommandlineCommandMetrics::~CommandlineCommandMetrics() {}
+
+void CommandlineCommandMetrics::setup()
+{
+	po::options_description options("Config Options");
+	options.add_options()("help,h", "Print this help message")(
+		"calls,c", "Only follow call edges (omit to follow all edges except member edges)")(
+		"top,t", po::value<int>()->default_value(20), "Number of nodes listed for each metric")(
+		"output,o",
+		po::value<std::string>(),
+		"File to write the metrics to (omit to print them to the console)")(
+		"project-file", po::value<std::string>(), "Indexed project file (.srctrlprj)");
+
+	m_options.add(options);
+	m_positional.add("project-file", 1);
+}
+
+CommandlineCommand::ReturnStatus CommandlineCommandMetrics::parse(std::vector<std::string>& args)
+{
+	po::variables_map vm;
+	try
+	{
+		po::store(
+			po::command_line_parser(args).options(m_options).positional(m_positional).run(), vm);
+		po::notify(vm);
+
+		parseConfigFile(vm, m_options);
+	}
+	catch (po::error& e)
+	{
+		std::cerr << "ERROR: " << e.what() << std::endl << std::endl;
+		std::cerr << m_options << std::endl;
+		return ReturnStatus::CMD_FAILURE;
+	}
+
+	if (vm.count("help") || args.size() == 0 || args[0] == "help")
+	{
+		printHelp();
+		return ReturnStatus::CMD_QUIT;
+	}
+
+	const int topCount = vm["top"].as<int>();
+	if (topCount <= 0)
+	{
+		std::cerr << "ERROR: number of listed nodes must be positive" << std::endl << std::endl;
+		std::cerr << m_options << std::endl;
+		return ReturnStatus::CMD_FAILURE;
+	}
+
+	FilePath outputFilePath;
+	if (vm.count("output"))
+	{
+		outputFilePath = FilePath(vm["output"].as<std::string>());
+	}
+
+	m_parser->setMetricsRequested(topCount, vm.count("calls") > 0, outputFilePath);
+
+	if (vm.count("project-file"))
+	{
+		m_parser->setProjectFile(FilePath(vm["project-file"].as<std::string>()));
+	}
+
+	return ReturnStatus::CMD_OK;
+}
+
+}	 // namespace commandline
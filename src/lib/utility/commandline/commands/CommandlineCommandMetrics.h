@@ -0,0 +1,25 @@
+#ifndef COMMANDLINE_COMMAND_METRICS_H
+#define COMMANDLINE_COMMAND_METRICS_H
+
+#include "CommandlineCommand.h"
+
+namespace commandline
+{
+class CommandlineCommandMetrics: public CommandlineCommand
+{
+public:
+	CommandlineCommandMetrics(CommandLineParser* parser);
+	virtual ~CommandlineCommandMetrics();
+
+	virtual void setup();
+	virtual ReturnStatus parse(std::vector<std::string>& args);
+
+	virtual bool hasHelp() const
+	{
+		return true;
+	}
+};
+
+}	 // namespace commandline
+
+#endif	  // COMMANDLINE_COMMAND_METRICS_H
@@ -0,0 +1,87 @@
+#include "CommandlineCommandWatch.h"
+
+#include <iostream>
+
+#include "CommandLineParser.h"
+#include "CommandlineHelper.h"
+
+namespace po = boost::program_options;
+
+namespace commandline
+{
+CommandlineCommandWatch::CommandlineCommandWatch(CommandLineParser* parser)
+	: CommandlineCommand(
+		  "watch", "Index a project and keep reindexing it when its files change.", parser)
+{
+}
+
+CommandlineCommandWatch::~CommandlineCommandWatch() {}
+
+void CommandlineCommandWatch::setup()
+{
+	po::options_description options("Config Options");
+	options.add_options()("help,h", "Print this help message")(
+		"full,f", "Index full project on startup (omit to only index new/changed files)")(
+		"shallow,s", "Build a shallow index if supported by the project")(
+		"debounce,d",
+		po::value<int>()->default_value(1000),
+		"Milliseconds to wait for further file changes before reindexing")(
+		"project-file", po::value<std::string>(), "Project file to watch (.srctrlprj)");
+
+	m_options.add(options);
+	m_positional.add("project-file", 1);
+}
+
+CommandlineCommand::ReturnStatus CommandlineCommandWatch::parse(std::vector<std::string>& args)
+{
+	po::variables_map vm;
+	try
+	{
+		po::store(
+			po::command_line_parser(args).options(m_options).positional(m_positional).run(), vm);
+		po::notify(vm);
+
+		parseConfigFile(vm, m_options);
+	}
+	catch (po::error& e)
+	{
+		std::cerr << "ERROR: " << e.what() << std::endl << std::endl;
+		std::cerr << m_options << std::endl;
+		return ReturnStatus::CMD_FAILURE;
+	}
+
+	if (vm.count("help") || args.size() == 0 || args[0] == "help")
+	{
+		printHelp();
+		return ReturnStatus::CMD_QUIT;
+	}
+
+	if (vm.count("full"))
+	{
+		m_parser->fullRefresh();
+	}
+
+	if (vm.count("shallow"))
+	{
+		m_parser->setShallowIndexingRequested();
+	}
+
+	const int debounceMs = vm["debounce"].as<int>();
+	if (debounceMs < 0)
+	{
+		std::cerr << "ERROR: debounce delay must not be negative" << std::endl << std::endl;
+		std::cerr << m_options << std::endl;
+		return ReturnStatus::CMD_FAILURE;
+	}
+
+	m_parser->setWatchRequested(debounceMs);
+
+	if (vm.count("project-file"))
+	{
+		m_parser->setProjectFile(FilePath(vm["project-file"].as<std::string>()));
+	}
+
+	return ReturnStatus::CMD_OK;
+}
+
+}	 // namespace commandline
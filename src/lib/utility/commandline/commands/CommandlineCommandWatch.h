@@ -0,0 +1,25 @@
+#ifndef COMMANDLINE_COMMAND_WATCH_H
+#define COMMANDLINE_COMMAND_WATCH_H
+
+#include "CommandlineCommand.h"
+
+namespace commandline
+{
+class CommandlineCommandWatch: public CommandlineCommand
+{
+public:
+	CommandlineCommandWatch(CommandLineParser* parser);
+	virtual ~CommandlineCommandWatch();
+
+	virtual void setup();
+	virtual ReturnStatus parse(std::vector<std::string>& args);
+
+	virtual bool hasHelp() const
+	{
+		return true;
+	}
+};
+
+}	 // namespace commandline
+
+#endif	  // COMMANDLINE_COMMAND_WATCH_H
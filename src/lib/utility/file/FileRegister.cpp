@@ -1,5 +1,7 @@
 #include "FileRegister.h"
 
+#include <algorithm>
+
 #include "FilePath.h"
 #include "FilePathFilter.h"
 
@@ -10,18 +12,14 @@ FileRegister::FileRegister(
 	: m_currentPath(currentPath)
 	, m_indexedPaths(indexedPaths)
 	, m_excludeFilters(excludeFilters)
-	, m_hasFilePathCache([&](const std::wstring& f) {
-		const FilePath filePath(f);
-		bool ret = false;
-
-		if (filePath == m_currentPath)
-		{
-			ret = true;
-		}
-
-		if (!ret)
-		{
-			for (const FilePath& indexedPath: m_indexedPaths)
+	, m_hasCurrentPath(!FilePathFilter::areMatching(excludeFilters, currentPath))
+{
+	m_hasFilePathCache = std::make_shared<UnorderedCache<std::wstring, bool>>(
+		[indexedPaths, excludeFilters](const std::wstring& f) {
+			const FilePath filePath(f);
+			bool ret = false;
+
+			for (const FilePath& indexedPath: indexedPaths)
 			{
 				if (indexedPath.isDirectory())
 				{
@@ -40,20 +38,44 @@ FileRegister::FileRegister(
 					}
 				}
 			}
-		}
-
-		if (ret)
-		{
-			ret = !FilePathFilter::areMatching(m_excludeFilters, filePath);
-		}
-		return ret;
-	})
+
+			if (ret)
+			{
+				ret = !FilePathFilter::areMatching(excludeFilters, filePath);
+			}
+			return ret;
+		});
+}
+
+FileRegister::FileRegister(const FilePath& currentPath, const FileRegister& other)
+	: m_currentPath(currentPath)
+	, m_indexedPaths(other.m_indexedPaths)
+	, m_excludeFilters(other.m_excludeFilters)
+	, m_hasCurrentPath(!FilePathFilter::areMatching(other.m_excludeFilters, currentPath))
+	, m_hasFilePathCache(other.m_hasFilePathCache)
 {
 }
 
 FileRegister::~FileRegister() {}
 
+bool FileRegister::hasSameIndexedPaths(
+	const std::set<FilePath>& indexedPaths, const std::set<FilePathFilter>& excludeFilters) const
+{
+	return m_indexedPaths == indexedPaths &&
+		std::equal(
+			m_excludeFilters.begin(),
+			m_excludeFilters.end(),
+			excludeFilters.begin(),
+			excludeFilters.end(),
+			[](const FilePathFilter& a, const FilePathFilter& b) { return a.wstr() == b.wstr(); });
+}
+
 bool FileRegister::hasFilePath(const FilePath& filePath) const
 {
-	return m_hasFilePathCache.getValue(filePath.wstr());
+	if (filePath == m_currentPath)
+	{
+		return m_hasCurrentPath;
+	}
+
+	return m_hasFilePathCache->getValue(filePath.wstr());
 }
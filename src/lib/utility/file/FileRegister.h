@@ -1,6 +1,7 @@
 #ifndef FILE_REGISTER_H
 #define FILE_REGISTER_H
 
+#include <memory>
 #include <set>
 
 #include "FilePath.h"
@@ -15,15 +16,25 @@ public:
 		const FilePath& currentPath,
 		const std::set<FilePath>& indexedPaths,
 		const std::set<FilePathFilter>& excludeFilters);
+
+	// shares the cached lookups of a register that was created for the same indexed paths and
+	// exclude filters, so that they persist across the translation units processed by an indexer
+	FileRegister(const FilePath& currentPath, const FileRegister& other);
+
 	virtual ~FileRegister();
 
+	bool hasSameIndexedPaths(
+		const std::set<FilePath>& indexedPaths,
+		const std::set<FilePathFilter>& excludeFilters) const;
+
 	virtual bool hasFilePath(const FilePath& filePath) const;
 
 private:
-	const FilePath& m_currentPath;
+	const FilePath m_currentPath;
 	const std::set<FilePath> m_indexedPaths;
 	const std::set<FilePathFilter> m_excludeFilters;
-	mutable UnorderedCache<std::wstring, bool> m_hasFilePathCache;
+	bool m_hasCurrentPath;
+	std::shared_ptr<UnorderedCache<std::wstring, bool>> m_hasFilePathCache;
 };
 
 #endif	  // FILE_REGISTER_H
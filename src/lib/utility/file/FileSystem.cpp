@@ -1,6 +1,18 @@
 #include "FileSystem.h"
 
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
 #include <set>
+#include <thread>
+
+#ifndef _WIN32
+#	include <dirent.h>
+#	include <fcntl.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
 
 #include <boost/date_time.hpp>
 #include <boost/date_time/c_local_time_adjustor.hpp>
@@ -8,6 +20,225 @@
 
 #include "utilityString.h"
 
+namespace
+{
+TimeStamp toLocalTimeStamp(std::time_t time)
+{
+	return TimeStamp(boost::date_time::c_local_adjustor<boost::posix_time::ptime>::utc_to_local(
+		boost::posix_time::from_time_t(time)));
+}
+
+size_t getScanThreadCount()
+{
+	return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+#ifndef _WIN32
+// Collects the files of directory trees with a pool of threads. Each thread reads whole
+// directories and takes the entry types from the directory listing, so only matching files and
+// symlinks need a separate stat call. Files are identified by device and inode instead of their
+// canonical path, which avoids resolving every path component again.
+class DirectoryScanner
+{
+public:
+	struct ScannedFile
+	{
+		std::string path;
+		std::pair<dev_t, ino_t> id;
+		std::time_t lastWriteTime;
+	};
+
+	DirectoryScanner(const std::set<std::wstring>& extensions, bool followSymLinks)
+		: m_followSymLinks(followSymLinks)
+	{
+		for (const std::wstring& extension: extensions)
+		{
+			m_extensions.insert(utility::encodeToUtf8(extension));
+		}
+	}
+
+	std::vector<ScannedFile> scan(const std::vector<std::string>& directoryPaths)
+	{
+		m_directoryPaths = directoryPaths;
+
+		std::vector<std::thread> threads;
+		for (size_t i = 0; i < getScanThreadCount(); i++)
+		{
+			threads.emplace_back(&DirectoryScanner::run, this);
+		}
+
+		for (std::thread& thread: threads)
+		{
+			thread.join();
+		}
+
+		return std::move(m_files);
+	}
+
+private:
+	void run()
+	{
+		std::vector<std::string> subDirectoryPaths;
+		std::vector<ScannedFile> files;
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while (true)
+		{
+			m_condition.wait(
+				lock, [this]() { return !m_directoryPaths.empty() || m_activeCount == 0; });
+			if (m_directoryPaths.empty())
+			{
+				break;
+			}
+
+			const std::string directoryPath = std::move(m_directoryPaths.back());
+			m_directoryPaths.pop_back();
+			m_activeCount++;
+			lock.unlock();
+
+			scanDirectory(directoryPath, subDirectoryPaths, files);
+
+			lock.lock();
+			m_activeCount--;
+			std::move(
+				subDirectoryPaths.begin(),
+				subDirectoryPaths.end(),
+				std::back_inserter(m_directoryPaths));
+			subDirectoryPaths.clear();
+			m_condition.notify_all();
+		}
+
+		std::move(files.begin(), files.end(), std::back_inserter(m_files));
+	}
+
+	void scanDirectory(
+		const std::string& directoryPath,
+		std::vector<std::string>& subDirectoryPaths,
+		std::vector<ScannedFile>& files)
+	{
+		const int directoryFd = open(directoryPath.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		if (directoryFd < 0)
+		{
+			return;
+		}
+
+		DIR* directory = fdopendir(directoryFd);
+		if (!directory)
+		{
+			close(directoryFd);
+			return;
+		}
+
+		std::string prefix = directoryPath;
+		if (prefix.back() != '/')
+		{
+			prefix += '/';
+		}
+
+		struct stat status;
+		while (const dirent* entry = readdir(directory))
+		{
+			const char* name = entry->d_name;
+			if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+			{
+				continue;
+			}
+
+			unsigned char type = entry->d_type;
+			if (type == DT_UNKNOWN)
+			{
+				if (fstatat(directoryFd, name, &status, AT_SYMLINK_NOFOLLOW) != 0)
+				{
+					continue;
+				}
+				if (S_ISLNK(status.st_mode))
+				{
+					type = DT_LNK;
+				}
+				else if (S_ISDIR(status.st_mode))
+				{
+					type = DT_DIR;
+				}
+				else if (S_ISREG(status.st_mode))
+				{
+					type = DT_REG;
+				}
+				else
+				{
+					// fifos, sockets and device nodes are never source files
+					continue;
+				}
+			}
+
+			if (type == DT_DIR)
+			{
+				subDirectoryPaths.push_back(prefix + name);
+			}
+			else if (type == DT_LNK)
+			{
+				// self-referencing and broken symlinks fail to resolve
+				if (!m_followSymLinks || fstatat(directoryFd, name, &status, 0) != 0)
+				{
+					continue;
+				}
+
+				if (S_ISDIR(status.st_mode))
+				{
+					// each symlinked directory is only visited once, which also breaks cycles
+					std::lock_guard<std::mutex> lock(m_mutex);
+					if (m_symLinkedDirectories.insert({status.st_dev, status.st_ino}).second)
+					{
+						subDirectoryPaths.push_back(prefix + name);
+					}
+				}
+				else if (S_ISREG(status.st_mode) && hasExtension(name))
+				{
+					addFile(prefix + name, status, files);
+				}
+			}
+			else if (
+				type == DT_REG && hasExtension(name) &&
+				fstatat(directoryFd, name, &status, 0) == 0 && S_ISREG(status.st_mode))
+			{
+				addFile(prefix + name, status, files);
+			}
+		}
+
+		closedir(directory);
+	}
+
+	static void addFile(
+		const std::string& path, const struct stat& status, std::vector<ScannedFile>& files)
+	{
+		files.push_back({path, {status.st_dev, status.st_ino}, status.st_mtime});
+	}
+
+	bool hasExtension(const char* name) const
+	{
+		if (m_extensions.empty())
+		{
+			return true;
+		}
+
+		const char* extension = std::strrchr(name, '.');
+		return extension &&
+			m_extensions.find(utility::encodeToUtf8(utility::toLowerCase(
+				utility::decodeFromUtf8(extension)))) != m_extensions.end();
+	}
+
+	const bool m_followSymLinks;
+	std::set<std::string> m_extensions;
+
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::vector<std::string> m_directoryPaths;
+	size_t m_activeCount = 0;
+	std::set<std::pair<dev_t, ino_t>> m_symLinkedDirectories;
+	std::vector<ScannedFile> m_files;
+};
+#endif
+}	 // namespace
+
 std::vector<FilePath> FileSystem::getFilePathsFromDirectory(
 	const FilePath& path, const std::vector<std::wstring>& extensions)
 {
@@ -51,6 +282,31 @@ FileInfo FileSystem::getFileInfoForPath(const FilePath& filePath)
 	return FileInfo();
 }
 
+std::vector<FileInfo> FileSystem::getFileInfosForPaths(const std::vector<FilePath>& filePaths)
+{
+	std::vector<FileInfo> fileInfos(filePaths.size());
+
+	const size_t threadCount = std::min(getScanThreadCount(), filePaths.size());
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < threadCount; i++)
+	{
+		threads.emplace_back([&filePaths, &fileInfos, threadCount, i]() {
+			for (size_t j = i; j < filePaths.size(); j += threadCount)
+			{
+				// copied, because checking a path caches the result in the path
+				fileInfos[j] = getFileInfoForPath(FilePath(filePaths[j]));
+			}
+		});
+	}
+
+	for (std::thread& thread: threads)
+	{
+		thread.join();
+	}
+
+	return fileInfos;
+}
+
 std::vector<FileInfo> FileSystem::getFileInfosFromPaths(
 	const std::vector<FilePath>& paths,
 	const std::vector<std::wstring>& fileExtensions,
@@ -62,11 +318,59 @@ std::vector<FileInfo> FileSystem::getFileInfosFromPaths(
 		ext.insert(utility::toLowerCase(e));
 	}
 
+	std::vector<FileInfo> files;
+
+#ifndef _WIN32
+	std::vector<std::string> directoryPaths;
+	std::vector<DirectoryScanner::ScannedFile> listedFiles;
+	for (const FilePath& path: paths)
+	{
+		if (path.isDirectory())
+		{
+			directoryPaths.push_back(path.str());
+		}
+		else if (
+			path.exists() &&
+			(ext.empty() || ext.find(utility::toLowerCase(path.extension())) != ext.end()))
+		{
+			const std::string canonicalPath = path.getCanonical().str();
+			struct stat status;
+			if (stat(canonicalPath.c_str(), &status) == 0)
+			{
+				listedFiles.push_back(
+					{canonicalPath, {status.st_dev, status.st_ino}, status.st_mtime});
+			}
+		}
+	}
+
+	std::vector<DirectoryScanner::ScannedFile> scannedFiles;
+	if (!directoryPaths.empty())
+	{
+		scannedFiles = DirectoryScanner(ext, followSymLinks).scan(directoryPaths);
+
+		// the order of the scan depends on thread timing, sorting keeps the result deterministic
+		std::sort(
+			scannedFiles.begin(),
+			scannedFiles.end(),
+			[](const DirectoryScanner::ScannedFile& a, const DirectoryScanner::ScannedFile& b) {
+				return a.path < b.path;
+			});
+	}
+	scannedFiles.insert(scannedFiles.end(), listedFiles.begin(), listedFiles.end());
+
+	std::set<std::pair<dev_t, ino_t>> fileIds;
+	for (const DirectoryScanner::ScannedFile& file: scannedFiles)
+	{
+		if (fileIds.insert(file.id).second)
+		{
+			files.emplace_back(
+				FilePath(utility::decodeFromUtf8(file.path)), toLocalTimeStamp(file.lastWriteTime));
+		}
+	}
+#else
 	std::set<boost::filesystem::path> symlinkDirs;
 	std::set<boost::filesystem::path> filePaths;
 
-	std::vector<FileInfo> files;
-
 	for (const FilePath& path: paths)
 	{
 		if (path.isDirectory())
@@ -134,6 +438,7 @@ std::vector<FileInfo> FileSystem::getFileInfosFromPaths(
 			files.push_back(getFileInfoForPath(canonicalPath));
 		}
 	}
+#endif
 
 	return files;
 }
@@ -200,15 +505,11 @@ unsigned long long FileSystem::getFileByteSize(const FilePath& filePath)
 
 TimeStamp FileSystem::getLastWriteTime(const FilePath& filePath)
 {
-	boost::posix_time::ptime lastWriteTime;
 	if (filePath.exists())
 	{
-		std::time_t t = boost::filesystem::last_write_time(filePath.getPath());
-		lastWriteTime = boost::posix_time::from_time_t(t);
-		lastWriteTime = boost::date_time::c_local_adjustor<boost::posix_time::ptime>::utc_to_local(
-			lastWriteTime);
+		return toLocalTimeStamp(boost::filesystem::last_write_time(filePath.getPath()));
 	}
-	return TimeStamp(lastWriteTime);
+	return TimeStamp(boost::posix_time::ptime());
 }
 
 bool FileSystem::remove(const FilePath& path)
@@ -15,6 +15,8 @@ public:
 		const FilePath& path, const std::vector<std::wstring>& extensions = {});
 
 	static FileInfo getFileInfoForPath(const FilePath& filePath);
+	// Same as getFileInfoForPath for each path, but checks the paths in parallel.
+	static std::vector<FileInfo> getFileInfosForPaths(const std::vector<FilePath>& filePaths);
 
 	static std::vector<FileInfo> getFileInfosFromPaths(
 		const std::vector<FilePath>& paths,
@@ -51,6 +51,59 @@ std::vector<FilePath> utility::partitionFilePathsBySize(std::vector<FilePath> fi
 	return sortedFilePaths;
 }
 
+std::vector<FilePath> utility::orderFilePathsByPredictedCost(
+	const std::vector<FilePath>& filePaths, const std::map<FilePath, size_t>& knownDurations)
+{
+	if (knownDurations.empty())
+	{
+		return partitionFilePathsBySize(filePaths, 2);
+	}
+
+	typedef std::pair<double, FilePath> PairType;
+	std::vector<PairType> costsToFilePaths;
+	std::vector<std::pair<unsigned long long int, FilePath>> unknownFileSizes;
+
+	double knownDurationSum = 0.0;
+	double knownByteSizeSum = 0.0;
+	for (const FilePath& path: filePaths)
+	{
+		const unsigned long long int byteSize = path.exists() ? FileSystem::getFileByteSize(path)
+															  : 1;
+
+		auto it = knownDurations.find(path);
+		if (it != knownDurations.end())
+		{
+			costsToFilePaths.push_back(std::make_pair(static_cast<double>(it->second), path));
+			knownDurationSum += it->second;
+			knownByteSizeSum += byteSize;
+		}
+		else
+		{
+			unknownFileSizes.push_back(std::make_pair(byteSize, path));
+		}
+	}
+
+	const double millisecondsPerByte = (knownDurationSum > 0.0 && knownByteSizeSum > 0.0)
+		? knownDurationSum / knownByteSizeSum
+		: 1.0;
+	for (const std::pair<unsigned long long int, FilePath>& pair: unknownFileSizes)
+	{
+		costsToFilePaths.push_back(std::make_pair(pair.first * millisecondsPerByte, pair.second));
+	}
+
+	std::stable_sort(
+		costsToFilePaths.begin(),
+		costsToFilePaths.end(),
+		[](const PairType& p, const PairType& q) { return p.first > q.first; });
+
+	std::vector<FilePath> sortedFilePaths;
+	for (const PairType& pair: costsToFilePaths)
+	{
+		sortedFilePaths.push_back(pair.second);
+	}
+	return sortedFilePaths;
+}
+
 std::vector<FilePath> utility::getTopLevelPaths(const std::vector<FilePath>& paths)
 {
 	return utility::getTopLevelPaths(utility::toSet(paths));
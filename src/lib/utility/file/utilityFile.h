@@ -1,15 +1,23 @@
 #ifndef UTILITY_FILE_H
 #define UTILITY_FILE_H
 
+#include <map>
 #include <set>
 #include <vector>
 
+#include "types.h"
+
 class FilePath;
 
 namespace utility
 {
 std::vector<FilePath> partitionFilePathsBySize(std::vector<FilePath> filePaths, int partitionCount = 0);
 
+// orders the file paths by descending predicted indexing cost; the cost of files without a known
+// duration is extrapolated from their byte size using the average throughput of the known files
+std::vector<FilePath> orderFilePathsByPredictedCost(
+	const std::vector<FilePath>& filePaths, const std::map<FilePath, size_t>& knownDurations);
+
 std::vector<FilePath> getTopLevelPaths(const std::vector<FilePath>& paths);
 std::vector<FilePath> getTopLevelPaths(const std::set<FilePath>& paths);
 
@@ -20,6 +20,7 @@ public:
 		, edgeTypes(edgeTypes)
 		, nodeNonIndexed(false)
 		, depth(depth)
+		, maxPathCount(0)
 		, horizontalLayout(horizontalLayout)
 		, custom(false)
 	{
@@ -33,6 +34,7 @@ public:
 		Edge::TypeMask edgeTypes,
 		bool nodeNonIndexed,
 		size_t depth,
+		size_t maxPathCount,
 		bool horizontalLayout)
 		: originId(originId)
 		, targetId(targetId)
@@ -40,6 +42,7 @@ public:
 		, edgeTypes(edgeTypes)
 		, nodeNonIndexed(nodeNonIndexed)
 		, depth(depth)
+		, maxPathCount(maxPathCount)
 		, horizontalLayout(horizontalLayout)
 		, custom(true)
 	{
@@ -64,6 +67,7 @@ public:
 	const Edge::TypeMask edgeTypes;
 	const bool nodeNonIndexed;
 	const size_t depth;
+	const size_t maxPathCount;	  // 0 shows all shortest paths between origin and target
 	const bool horizontalLayout;
 	const bool custom;
 };
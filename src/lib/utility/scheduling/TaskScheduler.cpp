@@ -41,10 +41,18 @@ void TaskScheduler::pushNextTask(std::shared_ptr<Task> task)
 
 void TaskScheduler::startSchedulerLoopThreaded()
 {
+	{
+		std::lock_guard<std::mutex> lock(m_threadMutex);
+		m_threadIsRunning = true;
+	}
+
 	std::thread(&TaskScheduler::startSchedulerLoop, this).detach();
 
-	std::lock_guard<std::mutex> lock(m_threadMutex);
-	m_threadIsRunning = true;
+	// a stop right after this call would otherwise precede the start of the loop and never return
+	while (!loopIsRunning())
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
 }
 
 void TaskScheduler::startSchedulerLoop()
@@ -0,0 +1,125 @@
+#include "utilityHash.h"
+
+namespace
+{
+const uint64_t s_prime1 = 0x9E3779B185EBCA87ULL;
+const uint64_t s_prime2 = 0xC2B2AE3D27D4EB4FULL;
+const uint64_t s_prime3 = 0x165667B19E3779F9ULL;
+const uint64_t s_prime4 = 0x85EBCA77C2B2AE63ULL;
+const uint64_t s_prime5 = 0x27D4EB2F165667C5ULL;
+
+uint64_t rotateLeft(uint64_t value, int bits)
+{
+	return (value << bits) | (value >> (64 - bits));
+}
+
+// reads little endian, so hashes are the same on every platform
+uint64_t read64(const unsigned char* p)
+{
+	uint64_t value = 0;
+	for (int i = 7; i >= 0; i--)
+	{
+		value = (value << 8) | p[i];
+	}
+	return value;
+}
+
+uint64_t read32(const unsigned char* p)
+{
+	return uint64_t(p[0]) | (uint64_t(p[1]) << 8) | (uint64_t(p[2]) << 16) |
+		(uint64_t(p[3]) << 24);
+}
+
+uint64_t processRound(uint64_t accumulator, uint64_t input)
+{
+	accumulator += input * s_prime2;
+	accumulator = rotateLeft(accumulator, 31);
+	return accumulator * s_prime1;
+}
+
+uint64_t mergeRound(uint64_t accumulator, uint64_t value)
+{
+	accumulator ^= processRound(0, value);
+	return accumulator * s_prime1 + s_prime4;
+}
+}	 // namespace
+
+namespace utility
+{
+uint64_t xxHash64(const char* data, size_t size, uint64_t seed)
+{
+	const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+	const unsigned char* const end = p + size;
+
+	uint64_t hash = 0;
+	if (size >= 32)
+	{
+		uint64_t v1 = seed + s_prime1 + s_prime2;
+		uint64_t v2 = seed + s_prime2;
+		uint64_t v3 = seed;
+		uint64_t v4 = seed - s_prime1;
+
+		const unsigned char* const limit = end - 32;
+		do
+		{
+			v1 = processRound(v1, read64(p));
+			v2 = processRound(v2, read64(p + 8));
+			v3 = processRound(v3, read64(p + 16));
+			v4 = processRound(v4, read64(p + 24));
+			p += 32;
+		} while (p <= limit);
+
+		hash = rotateLeft(v1, 1) + rotateLeft(v2, 7) + rotateLeft(v3, 12) + rotateLeft(v4, 18);
+		hash = mergeRound(hash, v1);
+		hash = mergeRound(hash, v2);
+		hash = mergeRound(hash, v3);
+		hash = mergeRound(hash, v4);
+	}
+	else
+	{
+		hash = seed + s_prime5;
+	}
+
+	hash += uint64_t(size);
+
+	for (; p + 8 <= end; p += 8)
+	{
+		hash ^= processRound(0, read64(p));
+		hash = rotateLeft(hash, 27) * s_prime1 + s_prime4;
+	}
+
+	if (p + 4 <= end)
+	{
+		hash ^= read32(p) * s_prime1;
+		hash = rotateLeft(hash, 23) * s_prime2 + s_prime3;
+		p += 4;
+	}
+
+	for (; p < end; p++)
+	{
+		hash ^= (*p) * s_prime5;
+		hash = rotateLeft(hash, 11) * s_prime1;
+	}
+
+	hash ^= hash >> 33;
+	hash *= s_prime2;
+	hash ^= hash >> 29;
+	hash *= s_prime3;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+std::string getContentHash(const std::string& content)
+{
+	const char* digits = "0123456789abcdef";
+	uint64_t hash = xxHash64(content.data(), content.size());
+
+	std::string hexHash(16, '0');
+	for (int i = 15; i >= 0; i--)
+	{
+		hexHash[i] = digits[hash & 0xF];
+		hash >>= 4;
+	}
+	return hexHash;
+}
+}	 // namespace utility
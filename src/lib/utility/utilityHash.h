@@ -0,0 +1,16 @@
+#ifndef UTILITY_HASH_H
+#define UTILITY_HASH_H
+
+#include <cstdint>
+#include <string>
+
+namespace utility
+{
+// 64 bit xxHash (XXH64) of the given data, a fast non-cryptographic hash for change detection
+uint64_t xxHash64(const char* data, size_t size, uint64_t seed = 0);
+
+// xxHash of the content as 16 hexadecimal digits
+std::string getContentHash(const std::string& content);
+}	 // namespace utility
+
+#endif	  // UTILITY_HASH_H
@@ -183,6 +183,46 @@ const FilePath& IndexerCommandCxx::getWorkingDirectory() const
 	return m_workingDirectory;
 }
 
+std::wstring IndexerCommandCxx::getPreprocessorContext() const
+{
+	// flags that only name the input or outputs of the compilation don't change how headers are
+	// preprocessed and would otherwise prevent sharing the context between translation units
+	const std::set<std::wstring> outputFlags = {L"-o", L"-MF", L"-MT", L"-MQ"};
+	const std::wstring sourceFileName = getSourceFilePath().fileName();
+
+	std::wstring context = m_workingDirectory.wstr();
+	for (size_t i = 0; i < m_compilerFlags.size(); i++)
+	{
+		const std::wstring& flag = m_compilerFlags[i];
+		if (outputFlags.find(flag) != outputFlags.end())
+		{
+			i++;
+		}
+		else if (
+			flag != L"-c" &&
+			(utility::isPrefix<std::wstring>(L"-", flag) ||
+			 FilePath(flag).fileName() != sourceFileName))
+		{
+			context += L'\n' + flag;
+		}
+	}
+
+	for (const FilePath& path: m_indexedPaths)
+	{
+		if (path != getSourceFilePath())
+		{
+			context += L'\n' + path.wstr();
+		}
+	}
+
+	for (const FilePathFilter& filter: m_excludeFilters)
+	{
+		context += L'\n' + filter.wstr();
+	}
+
+	return std::to_wstring(std::hash<std::wstring>()(context));
+}
+
 QJsonObject IndexerCommandCxx::doSerialize() const
 {
 	QJsonObject jsonObject = IndexerCommand::doSerialize();
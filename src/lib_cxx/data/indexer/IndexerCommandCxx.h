@@ -47,6 +47,8 @@ public:
 	const std::vector<std::wstring>& getCompilerFlags() const;
 	const FilePath& getWorkingDirectory() const;
 
+	std::wstring getPreprocessorContext() const override;
+
 protected:
 	QJsonObject doSerialize() const override;
 
@@ -1,20 +1,54 @@
 #include "IndexerCxx.h"
 
+#include <algorithm>
+
+#include "ApplicationSettings.h"
 #include "CxxParser.h"
 #include "FileRegister.h"
+#include "utilityApp.h"
+
+namespace
+{
+// all indexer threads or processes of an indexing run share the memory budget of their caches
+size_t getMaxCachedByteSize()
+{
+	int indexerCount = ApplicationSettings::getInstance()->getIndexerThreadCount();
+	if (indexerCount <= 0)
+	{
+		indexerCount = utility::getIdealThreadCount();
+	}
+	return size_t(512) * 1024 * 1024 / std::max(indexerCount, 1);
+}
+}	 // namespace
 
 void IndexerCxx::doIndex(
 	std::shared_ptr<IndexerCommandCxx> indexerCommand,
 	std::shared_ptr<ParserClientImpl> parserClient,
 	std::shared_ptr<IndexerStateInfo> m_indexerStateInfo)
 {
-	CxxParser parser(
-		parserClient,
-		std::make_shared<FileRegister>(
+	if (m_fileRegister &&
+		m_fileRegister->hasSameIndexedPaths(
+			indexerCommand->getIndexedPaths(), indexerCommand->getExcludeFilters()))
+	{
+		m_fileRegister = std::make_shared<FileRegister>(
+			indexerCommand->getSourceFilePath(), *m_fileRegister);
+	}
+	else
+	{
+		m_fileRegister = std::make_shared<FileRegister>(
 			indexerCommand->getSourceFilePath(),
 			indexerCommand->getIndexedPaths(),
-			indexerCommand->getExcludeFilters()),
-		m_indexerStateInfo);
+			indexerCommand->getExcludeFilters());
+	}
+
+	if (!m_fileSystem)
+	{
+		m_fileSystem = new CxxCachingFileSystem(
+			llvm::vfs::getRealFileSystem(), getMaxCachedByteSize());
+	}
+	m_fileSystem->clearFailedLookups();
+
+	CxxParser parser(parserClient, m_fileRegister, m_indexerStateInfo, m_fileSystem);
 
 	parser.buildIndex(indexerCommand);
 }
@@ -1,9 +1,12 @@
 #ifndef INDEXER_CXX_H
 #define INDEXER_CXX_H
 
+#include "CxxCachingFileSystem.h"
 #include "Indexer.h"
 #include "IndexerCommandCxx.h"
 
+class FileRegister;
+
 class IndexerCxx: public Indexer<IndexerCommandCxx>
 {
 private:
@@ -11,6 +14,12 @@ private:
 		std::shared_ptr<IndexerCommandCxx> indexerCommand,
 		std::shared_ptr<ParserClientImpl> parserClient,
 		std::shared_ptr<IndexerStateInfo> m_indexerStateInfo) override;
+
+	// kept to reuse its file lookups for subsequent commands of the same source group
+	std::shared_ptr<FileRegister> m_fileRegister;
+
+	// shares headers read from disk between the translation units of this indexer
+	llvm::IntrusiveRefCntPtr<CxxCachingFileSystem> m_fileSystem;
 };
 
 #endif	  // INDEXER_CXX_H
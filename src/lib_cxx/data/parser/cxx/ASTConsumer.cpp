@@ -1,8 +1,14 @@
 #include "ASTConsumer.h"
 
+#include <clang/Lex/HeaderSearch.h>
+#include <clang/Lex/Preprocessor.h>
+
 #include "ApplicationSettings.h"
+#include "CanonicalFilePathCache.h"
 #include "CxxAstVisitor.h"
 #include "CxxVerboseAstVisitor.h"
+#include "IndexerStateInfo.h"
+#include "IndexingProfile.h"
 
 ASTConsumer::ASTConsumer(
 	clang::ASTContext* context,
@@ -10,6 +16,9 @@ ASTConsumer::ASTConsumer(
 	std::shared_ptr<ParserClient> client,
 	std::shared_ptr<CanonicalFilePathCache> canonicalFilePathCache,
 	std::shared_ptr<IndexerStateInfo> indexerStateInfo)
+	: m_preprocessor(preprocessor)
+	, m_canonicalFilePathCache(canonicalFilePathCache)
+	, m_indexerStateInfo(indexerStateInfo)
 {
 	ApplicationSettings* appSettings = ApplicationSettings::getInstance().get();
 
@@ -27,5 +36,35 @@ ASTConsumer::ASTConsumer(
 
 void ASTConsumer::HandleTranslationUnit(clang::ASTContext& context)
 {
+	IndexingProfile::ScopedPhase profilePhase(INDEXING_PHASE_TRAVERSAL);
+
 	m_visitor->indexDecl(context.getTranslationUnitDecl());
+
+	if (m_indexerStateInfo)
+	{
+		recordGuardedHeaderFilePaths(context.getSourceManager());
+	}
+}
+
+void ASTConsumer::recordGuardedHeaderFilePaths(const clang::SourceManager& sourceManager)
+{
+	// include guarded headers expand the same way in every translation unit that shares the
+	// preprocessor context, so these can be skipped by the following translation units
+	const clang::FileEntry* mainFileEntry = sourceManager.getFileEntryForID(
+		sourceManager.getMainFileID());
+	clang::HeaderSearch& headerSearch = m_preprocessor->getHeaderSearchInfo();
+
+	for (auto it = sourceManager.fileinfo_begin(); it != sourceManager.fileinfo_end(); it++)
+	{
+		const clang::FileEntry* fileEntry = it->first;
+		if (fileEntry && fileEntry != mainFileEntry &&
+			headerSearch.isFileMultipleIncludeGuarded(fileEntry))
+		{
+			const FilePath filePath = m_canonicalFilePathCache->getCanonicalFilePath(fileEntry);
+			if (m_canonicalFilePathCache->getFileRegister()->hasFilePath(filePath))
+			{
+				m_indexerStateInfo->guardedHeaderFilePaths.insert(filePath);
+			}
+		}
+	}
 }
@@ -24,6 +24,10 @@ public:
 	virtual void HandleTranslationUnit(clang::ASTContext& context) override;
 
 private:
+	void recordGuardedHeaderFilePaths(const clang::SourceManager& sourceManager);
+
+	clang::Preprocessor* m_preprocessor;
+	std::shared_ptr<CanonicalFilePathCache> m_canonicalFilePathCache;
 	std::shared_ptr<CxxAstVisitor> m_visitor;
 	std::shared_ptr<IndexerStateInfo> m_indexerStateInfo;
 };
@@ -5,8 +5,9 @@
 #include "utilityClang.h"
 #include "utilityString.h"
 
-CanonicalFilePathCache::CanonicalFilePathCache(std::shared_ptr<FileRegister> fileRegister)
-	: m_fileRegister(fileRegister)
+CanonicalFilePathCache::CanonicalFilePathCache(
+	std::shared_ptr<FileRegister> fileRegister, std::set<FilePath> skippedFilePaths)
+	: m_fileRegister(fileRegister), m_skippedFilePaths(std::move(skippedFilePaths))
 {
 }
 
@@ -157,3 +158,24 @@ bool CanonicalFilePathCache::isProjectFile(
 	m_isProjectFileMap.emplace(fileId, ret);
 	return ret;
 }
+
+bool CanonicalFilePathCache::shouldIndexFile(
+	const clang::FileID& fileId, const clang::SourceManager& sourceManager)
+{
+	if (m_skippedFilePaths.empty())
+	{
+		return isProjectFile(fileId, sourceManager);
+	}
+
+	auto it = m_shouldIndexFileMap.find(fileId);
+	if (it != m_shouldIndexFileMap.end())
+	{
+		return it->second;
+	}
+
+	bool ret = isProjectFile(fileId, sourceManager) &&
+		m_skippedFilePaths.find(getCanonicalFilePath(fileId, sourceManager)) ==
+			m_skippedFilePaths.end();
+	m_shouldIndexFileMap.emplace(fileId, ret);
+	return ret;
+}
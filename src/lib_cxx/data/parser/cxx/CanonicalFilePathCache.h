@@ -2,6 +2,7 @@
 #define CANONICAL_FILE_PATH_CACHE_H
 
 #include <map>
+#include <set>
 #include <string>
 #include <unordered_map>
 
@@ -15,7 +16,9 @@
 class CanonicalFilePathCache
 {
 public:
-	CanonicalFilePathCache(std::shared_ptr<FileRegister> fileRegister);
+	CanonicalFilePathCache(
+		std::shared_ptr<FileRegister> fileRegister,
+		std::set<FilePath> skippedFilePaths = std::set<FilePath>());
 
 	std::shared_ptr<FileRegister> getFileRegister() const;
 
@@ -34,8 +37,12 @@ public:
 
 	bool isProjectFile(const clang::FileID& fileId, const clang::SourceManager& sourceManager);
 
+	// project files that were already indexed by another translation unit are not indexed again
+	bool shouldIndexFile(const clang::FileID& fileId, const clang::SourceManager& sourceManager);
+
 private:
 	std::shared_ptr<FileRegister> m_fileRegister;
+	const std::set<FilePath> m_skippedFilePaths;
 
 	std::map<clang::FileID, FilePath> m_fileIdMap;
 	std::unordered_map<std::wstring, FilePath> m_fileStringMap;
@@ -45,6 +52,7 @@ private:
 	std::unordered_map<std::wstring, Id> m_fileStringSymbolIdMap;
 
 	std::map<clang::FileID, bool> m_isProjectFileMap;
+	std::map<clang::FileID, bool> m_shouldIndexFileMap;
 };
 
 #endif	  // CANONICAL_FILE_PATH_CACHE_H
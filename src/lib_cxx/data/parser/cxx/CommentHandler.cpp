@@ -19,7 +19,7 @@ bool CommentHandler::HandleComment(clang::Preprocessor& preprocessor, clang::Sou
 	const clang::FileID fileId = sourceManager.getFileID(sourceRange.getBegin());
 	Id fileSymbolId = m_canonicalFilePathCache->getFileSymbolId(fileId);
 
-	if (fileSymbolId && m_canonicalFilePathCache->isProjectFile(fileId, sourceManager))
+	if (fileSymbolId && m_canonicalFilePathCache->shouldIndexFile(fileId, sourceManager))
 	{
 		const clang::PresumedLoc& presumedBegin = sourceManager.getPresumedLoc(
 			sourceRange.getBegin(), false);
@@ -711,5 +711,5 @@ bool CxxAstVisitor::isLocatedInProjectFile(clang::SourceLocation loc) const
 	}
 
 	const clang::SourceManager& sourceManager = m_astContext->getSourceManager();
-	return m_canonicalFilePathCache->isProjectFile(sourceManager.getFileID(loc), sourceManager);
+	return m_canonicalFilePathCache->shouldIndexFile(sourceManager.getFileID(loc), sourceManager);
 }
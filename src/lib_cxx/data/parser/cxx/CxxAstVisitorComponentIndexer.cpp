@@ -991,7 +991,8 @@ Id CxxAstVisitorComponentIndexer::getOrCreateSymbolId(const clang::NamedDecl* de
 	if (decl)
 	{
 		std::unique_ptr<CxxDeclName> declName =
-			CxxDeclNameResolver(getAstVisitor()->getCanonicalFilePathCache()).getName(decl);
+			CxxDeclNameResolver(getAstVisitor()->getCanonicalFilePathCache(), &m_nameResolverCache)
+				.getName(decl);
 		if (declName)
 		{
 			symbolName = declName->toNameHierarchy();
@@ -1028,7 +1029,8 @@ Id CxxAstVisitorComponentIndexer::getOrCreateSymbolId(const clang::Type* type)
 	if (type)
 	{
 		std::unique_ptr<CxxTypeName> typeName =
-			CxxTypeNameResolver(getAstVisitor()->getCanonicalFilePathCache()).getName(type);
+			CxxTypeNameResolver(getAstVisitor()->getCanonicalFilePathCache(), &m_nameResolverCache)
+				.getName(type);
 		if (typeName)
 		{
 			symbolName = typeName->toNameHierarchy();
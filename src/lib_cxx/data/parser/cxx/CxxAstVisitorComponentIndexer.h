@@ -4,6 +4,7 @@
 #include <unordered_map>
 
 #include "CxxAstVisitorComponent.h"
+#include "CxxNameResolverCache.h"
 #include "ParseLocation.h"
 #include "ReferenceKind.h"
 #include "SymbolKind.h"
@@ -80,6 +81,7 @@ private:
 
 	std::map<const clang::NamedDecl*, Id> m_declSymbolIds;
 	std::map<const clang::Type*, Id> m_typeSymbolIds;
+	CxxNameResolverCache m_nameResolverCache;
 };
 
 #endif	  // CXX_AST_VISITOR_COMPONENT_INDEXER_H
@@ -0,0 +1,182 @@
+#include "CxxCachingFileSystem.h"
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+namespace
+{
+// refers to a cached buffer and keeps it alive while clang uses it
+class SharedMemoryBuffer: public llvm::MemoryBuffer
+{
+public:
+	SharedMemoryBuffer(
+		std::shared_ptr<llvm::MemoryBuffer> buffer,
+		const std::string& name,
+		bool requiresNullTerminator)
+		: m_buffer(buffer), m_name(name)
+	{
+		init(buffer->getBufferStart(), buffer->getBufferEnd(), requiresNullTerminator);
+	}
+
+	llvm::StringRef getBufferIdentifier() const override
+	{
+		return m_name;
+	}
+
+	BufferKind getBufferKind() const override
+	{
+		return m_buffer->getBufferKind();
+	}
+
+private:
+	std::shared_ptr<llvm::MemoryBuffer> m_buffer;
+	std::string m_name;
+};
+
+class CachedFile: public llvm::vfs::File
+{
+public:
+	CachedFile(const llvm::vfs::Status& status, std::shared_ptr<llvm::MemoryBuffer> buffer)
+		: m_status(status), m_buffer(buffer)
+	{
+	}
+
+	llvm::ErrorOr<llvm::vfs::Status> status() override
+	{
+		return m_status;
+	}
+
+	llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> getBuffer(
+		const llvm::Twine& name,
+		int64_t fileSize,
+		bool requiresNullTerminator,
+		bool isVolatile) override
+	{
+		return std::unique_ptr<llvm::MemoryBuffer>(
+			new SharedMemoryBuffer(m_buffer, name.str(), requiresNullTerminator));
+	}
+
+	std::error_code close() override
+	{
+		return std::error_code();
+	}
+
+private:
+	llvm::vfs::Status m_status;
+	std::shared_ptr<llvm::MemoryBuffer> m_buffer;
+};
+}	 // namespace
+
+CxxCachingFileSystem::CxxCachingFileSystem(
+	llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem, size_t maxCachedByteSize)
+	: llvm::vfs::ProxyFileSystem(fileSystem)
+	, m_maxCachedByteSize(maxCachedByteSize)
+	, m_cachedByteSize(0)
+{
+}
+
+llvm::ErrorOr<llvm::vfs::Status> CxxCachingFileSystem::status(const llvm::Twine& path)
+{
+	const std::string key = getCacheKey(path);
+
+	auto it = m_statusCache.find(key);
+	if (it != m_statusCache.end())
+	{
+		return llvm::vfs::Status::copyWithNewName(it->second, path.str());
+	}
+
+	// header search probes many paths that don't exist, remember these for the current translation
+	// unit only, because they may be generated while indexing
+	auto failedIt = m_failedStatusCache.find(key);
+	if (failedIt != m_failedStatusCache.end())
+	{
+		return failedIt->second;
+	}
+
+	llvm::ErrorOr<llvm::vfs::Status> status = getUnderlyingFS().status(path);
+	if (status)
+	{
+		m_statusCache.emplace(key, *status);
+	}
+	else
+	{
+		m_failedStatusCache.emplace(key, status.getError());
+	}
+	return status;
+}
+
+llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>> CxxCachingFileSystem::openFileForRead(
+	const llvm::Twine& path)
+{
+	const std::string key = getCacheKey(path);
+
+	auto failedIt = m_failedStatusCache.find(key);
+	if (failedIt != m_failedStatusCache.end())
+	{
+		return failedIt->second;
+	}
+
+	auto bufferIt = m_bufferCache.find(key);
+	if (bufferIt != m_bufferCache.end())
+	{
+		return std::unique_ptr<llvm::vfs::File>(new CachedFile(
+			llvm::vfs::Status::copyWithNewName(m_statusCache.at(key), path.str()),
+			bufferIt->second));
+	}
+
+	llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>> file = getUnderlyingFS().openFileForRead(path);
+	if (!file)
+	{
+		m_statusCache.erase(key);
+		m_failedStatusCache.emplace(key, file.getError());
+		return file;
+	}
+
+	if (m_openedFilePaths.insert(key).second)
+	{
+		return file;
+	}
+
+	llvm::ErrorOr<llvm::vfs::Status> status = (*file)->status();
+	if (!status || m_cachedByteSize + status->getSize() > m_maxCachedByteSize)
+	{
+		return file;
+	}
+
+	llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer = (*file)->getBuffer(
+		path, status->getSize());
+	if (!buffer)
+	{
+		return buffer.getError();
+	}
+	(*file)->close();
+
+	std::shared_ptr<llvm::MemoryBuffer> sharedBuffer = std::move(*buffer);
+	m_cachedByteSize += sharedBuffer->getBufferSize();
+
+	// keep the stat result consistent with the cached content
+	m_statusCache.erase(key);
+	m_statusCache.emplace(key, *status);
+	m_bufferCache.emplace(key, sharedBuffer);
+
+	return std::unique_ptr<llvm::vfs::File>(
+		new CachedFile(llvm::vfs::Status::copyWithNewName(*status, path.str()), sharedBuffer));
+}
+
+void CxxCachingFileSystem::clearFailedLookups()
+{
+	m_failedStatusCache.clear();
+}
+
+size_t CxxCachingFileSystem::getCachedByteSize() const
+{
+	return m_cachedByteSize;
+}
+
+std::string CxxCachingFileSystem::getCacheKey(const llvm::Twine& path) const
+{
+	llvm::SmallString<256> key;
+	path.toVector(key);
+	makeAbsolute(key);
+	return key.str().str();
+}
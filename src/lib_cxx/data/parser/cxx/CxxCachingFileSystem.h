@@ -0,0 +1,42 @@
+#ifndef CXX_CACHING_FILE_SYSTEM_H
+#define CXX_CACHING_FILE_SYSTEM_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <llvm/Support/VirtualFileSystem.h>
+
+// Caches stat results and file contents of the underlying file system across the translation units
+// parsed by one indexer. Contents are only cached once a file is opened a second time, so source
+// files that are parsed once don't take up memory. Paths that don't exist are only remembered until
+// clearFailedLookups is called for the next translation unit. The cache lives as long as the
+// indexer, which is recreated for every indexing run, and is not thread-safe.
+class CxxCachingFileSystem: public llvm::vfs::ProxyFileSystem
+{
+public:
+	CxxCachingFileSystem(
+		llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem, size_t maxCachedByteSize);
+
+	llvm::ErrorOr<llvm::vfs::Status> status(const llvm::Twine& path) override;
+	llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>> openFileForRead(
+		const llvm::Twine& path) override;
+
+	void clearFailedLookups();
+
+	size_t getCachedByteSize() const;
+
+private:
+	std::string getCacheKey(const llvm::Twine& path) const;
+
+	const size_t m_maxCachedByteSize;
+	size_t m_cachedByteSize;
+
+	std::unordered_map<std::string, llvm::vfs::Status> m_statusCache;
+	std::unordered_map<std::string, std::error_code> m_failedStatusCache;
+	std::unordered_map<std::string, std::shared_ptr<llvm::MemoryBuffer>> m_bufferCache;
+	std::unordered_set<std::string> m_openedFilePaths;
+};
+
+#endif	  // CXX_CACHING_FILE_SYSTEM_H
@@ -18,6 +18,8 @@
 #include "FilePath.h"
 #include "FileRegister.h"
 #include "IndexerCommandCxx.h"
+#include "IndexerStateInfo.h"
+#include "IndexingProfile.h"
 #include "ParserClient.h"
 #include "ResourcePaths.h"
 #include "SingleFrontendActionFactory.h"
@@ -121,8 +123,12 @@ void CxxParser::initializeLLVM()
 CxxParser::CxxParser(
 	std::shared_ptr<ParserClient> client,
 	std::shared_ptr<FileRegister> fileRegister,
-	std::shared_ptr<IndexerStateInfo> indexerStateInfo)
-	: Parser(client), m_fileRegister(fileRegister), m_indexerStateInfo(indexerStateInfo)
+	std::shared_ptr<IndexerStateInfo> indexerStateInfo,
+	llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem)
+	: Parser(client)
+	, m_fileRegister(fileRegister)
+	, m_indexerStateInfo(indexerStateInfo)
+	, m_fileSystem(fileSystem)
 {
 	llvm::InitializeNativeTarget();
 	llvm::InitializeNativeTargetAsmParser();
@@ -171,10 +177,14 @@ void CxxParser::runTool(
 
 	clang::tooling::ClangTool tool(
 		*compilationDatabase,
-		std::vector<std::string>(1, utility::encodeToUtf8(sourceFilePath.wstr())));
+		std::vector<std::string>(1, utility::encodeToUtf8(sourceFilePath.wstr())),
+		std::make_shared<clang::PCHContainerOperations>(),
+		m_fileSystem);
 
 	std::shared_ptr<CanonicalFilePathCache> canonicalFilePathCache =
-		std::make_shared<CanonicalFilePathCache>(m_fileRegister);
+		std::make_shared<CanonicalFilePathCache>(
+			m_fileRegister,
+			m_indexerStateInfo ? m_indexerStateInfo->skippedHeaderFilePaths : std::set<FilePath>());
 
 	std::shared_ptr<CxxDiagnosticConsumer> diagnostics = getDiagnostics(
 		sourceFilePath, canonicalFilePathCache, true);
@@ -200,7 +210,11 @@ void CxxParser::runTool(
 
 	clang::ASTFrontendAction* action = new ASTAction(
 		m_client, canonicalFilePathCache, m_indexerStateInfo);
-	tool.run(new SingleFrontendActionFactory(action));
+	{
+		// time not claimed by a nested phase is spent by clang parsing and analyzing the source
+		IndexingProfile::ScopedPhase profilePhase(INDEXING_PHASE_FRONTEND);
+		tool.run(new SingleFrontendActionFactory(action));
+	}
 
 	if (!m_client->hasContent())
 	{
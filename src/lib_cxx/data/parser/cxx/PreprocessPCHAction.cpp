@@ -0,0 +1,20 @@
+#include "PreprocessPCHAction.h"
+
+#include <clang/Frontend/CompilerInstance.h>
+
+#include "PreprocessorCallbacks.h"
+
+PreprocessPCHAction::PreprocessPCHAction(
+	std::shared_ptr<ParserClient> client,
+	std::shared_ptr<CanonicalFilePathCache> canonicalFilePathCache)
+	: m_client(client), m_canonicalFilePathCache(canonicalFilePathCache)
+{
+}
+
+bool PreprocessPCHAction::BeginSourceFileAction(clang::CompilerInstance& compiler)
+{
+	clang::Preprocessor& preprocessor = compiler.getPreprocessor();
+	preprocessor.addPPCallbacks(std::make_unique<PreprocessorCallbacks>(
+		compiler.getSourceManager(), m_client, m_canonicalFilePathCache));
+	return true;
+}
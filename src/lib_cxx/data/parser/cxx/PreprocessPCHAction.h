@@ -0,0 +1,26 @@
+#ifndef PREPROCESS_PCH_ACTION_H
+#define PREPROCESS_PCH_ACTION_H
+
+#include <clang/Frontend/FrontendActions.h>
+
+class ParserClient;
+class CanonicalFilePathCache;
+
+// Records the files and macros of a precompiled header input without building the precompiled
+// header itself. This is used if a precompiled header of a previous indexing run can be reused.
+class PreprocessPCHAction: public clang::PreprocessOnlyAction
+{
+public:
+	explicit PreprocessPCHAction(
+		std::shared_ptr<ParserClient> client,
+		std::shared_ptr<CanonicalFilePathCache> canonicalFilePathCache);
+
+protected:
+	bool BeginSourceFileAction(clang::CompilerInstance& compiler) override;
+
+private:
+	std::shared_ptr<ParserClient> m_client;
+	std::shared_ptr<CanonicalFilePathCache> m_canonicalFilePathCache;
+};
+
+#endif	  // PREPROCESS_PCH_ACTION_H
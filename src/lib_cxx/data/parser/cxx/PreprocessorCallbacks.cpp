@@ -5,6 +5,7 @@
 #include <clang/Lex/MacroArgs.h>
 
 #include "CanonicalFilePathCache.h"
+#include "IndexingProfile.h"
 #include "ParseLocation.h"
 #include "ParserClient.h"
 #include "utilityClang.h"
@@ -27,6 +28,8 @@ void PreprocessorCallbacks::FileChanged(
 	clang::SrcMgr::CharacteristicKind,
 	clang::FileID prevID)
 {
+	IndexingProfile::ScopedPhase profilePhase(INDEXING_PHASE_PREPROCESSOR);
+
 	const clang::FileID fileId = m_sourceManager.getFileID(location);
 	const FilePath currentPath = m_canonicalFilePathCache->getCanonicalFilePath(
 		fileId, m_sourceManager);
@@ -34,12 +37,15 @@ void PreprocessorCallbacks::FileChanged(
 
 	if (!currentPath.empty())
 	{
-		m_currentPathIsProjectFile = m_canonicalFilePathCache->isProjectFile(fileId, m_sourceManager);
+		m_currentPathIsProjectFile = m_canonicalFilePathCache->shouldIndexFile(
+			fileId, m_sourceManager);
 
 		if (m_fileWasRecorded.find(fileId) == m_fileWasRecorded.end())
 		{
 			m_currentFileSymbolId = m_client->recordFile(
-				currentPath, m_currentPathIsProjectFile);	 // todo: fix for tests
+				currentPath,
+				m_canonicalFilePathCache->isProjectFile(
+					fileId, m_sourceManager));	  // todo: fix for tests
 			m_client->recordFileLanguage(m_currentFileSymbolId, L"cpp");
 
 			m_canonicalFilePathCache->addFileSymbolId(fileId, currentPath, m_currentFileSymbolId);
@@ -64,6 +70,8 @@ void PreprocessorCallbacks::InclusionDirective(
 	const clang::Module* imported,
 	clang::SrcMgr::CharacteristicKind fileType)
 {
+	IndexingProfile::ScopedPhase profilePhase(INDEXING_PHASE_PREPROCESSOR);
+
 	if (m_currentFileSymbolId && fileEntry)
 	{
 		const FilePath includedFilePath = m_canonicalFilePathCache->getCanonicalFilePath(fileEntry);
@@ -82,6 +90,8 @@ void PreprocessorCallbacks::InclusionDirective(
 void PreprocessorCallbacks::MacroDefined(
 	const clang::Token& macroNameToken, const clang::MacroDirective* macroDirective)
 {
+	IndexingProfile::ScopedPhase profilePhase(INDEXING_PHASE_PREPROCESSOR);
+
 	if (m_currentPathIsProjectFile)
 	{
 		// ignore builtin macros
@@ -147,6 +157,8 @@ void PreprocessorCallbacks::MacroExpands(
 
 void PreprocessorCallbacks::onMacroUsage(const clang::Token& macroNameToken)
 {
+	IndexingProfile::ScopedPhase profilePhase(INDEXING_PHASE_PREPROCESSOR);
+
 	if (m_currentPathIsProjectFile && isLocatedInProjectFile(macroNameToken.getLocation()))
 	{
 		const ParseLocation loc = getParseLocation(macroNameToken);
@@ -233,6 +245,6 @@ bool PreprocessorCallbacks::isLocatedInProjectFile(const clang::SourceLocation l
 		return false;
 	}
 
-	return m_canonicalFilePathCache->isProjectFile(
+	return m_canonicalFilePathCache->shouldIndexFile(
 		m_sourceManager.getFileID(spellingLoc), m_sourceManager);
 }
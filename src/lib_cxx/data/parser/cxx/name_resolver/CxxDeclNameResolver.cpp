@@ -4,18 +4,21 @@
 
 #include "CanonicalFilePathCache.h"
 #include "CxxFunctionDeclName.h"
+#include "CxxNameResolverCache.h"
 #include "CxxSpecifierNameResolver.h"
 #include "CxxStaticFunctionDeclName.h"
 #include "CxxTemplateArgumentNameResolver.h"
 #include "CxxTemplateParameterStringResolver.h"
 #include "CxxTypeNameResolver.h"
 #include "CxxVariableDeclName.h"
+#include "IndexingProfile.h"
 #include "ScopedSwitcher.h"
 #include "utilityClang.h"
 #include "utilityString.h"
 
-CxxDeclNameResolver::CxxDeclNameResolver(CanonicalFilePathCache* canonicalFilePathCache)
-	: CxxNameResolver(canonicalFilePathCache), m_currentDecl(nullptr)
+CxxDeclNameResolver::CxxDeclNameResolver(
+	CanonicalFilePathCache* canonicalFilePathCache, CxxNameResolverCache* nameResolverCache)
+	: CxxNameResolver(canonicalFilePathCache, nameResolverCache), m_currentDecl(nullptr)
 {
 }
 
@@ -26,6 +29,8 @@ CxxDeclNameResolver::CxxDeclNameResolver(const CxxNameResolver* other)
 
 std::unique_ptr<CxxDeclName> CxxDeclNameResolver::getName(const clang::NamedDecl* declaration)
 {
+	IndexingProfile::ScopedPhase profilePhase(INDEXING_PHASE_NAME_RESOLUTION);
+
 	declaration = utility::getFirstDecl(declaration);
 
 	if ((declaration) && (clang::isa<clang::CXXRecordDecl>(declaration)) &&
@@ -72,9 +77,16 @@ std::unique_ptr<CxxDeclName> CxxDeclNameResolver::getName(const clang::NamedDecl
 	return declName;
 }
 
-std::unique_ptr<CxxName> CxxDeclNameResolver::getContextName(const clang::DeclContext* declContext)
+std::shared_ptr<CxxName> CxxDeclNameResolver::getContextName(const clang::DeclContext* declContext)
 {
-	std::unique_ptr<CxxName> contextDeclName;
+	std::shared_ptr<CxxName> contextDeclName;
+
+	// the names of all members of a context share the name of that context
+	CxxNameResolverCache* nameResolverCache = getNameResolverCache();
+	if (nameResolverCache && nameResolverCache->getContextName(declContext, contextDeclName))
+	{
+		return contextDeclName;
+	}
 
 	if (declContext && !ignoresContext(declContext))
 	{
@@ -92,6 +104,11 @@ std::unique_ptr<CxxName> CxxDeclNameResolver::getContextName(const clang::DeclCo
 			}
 		}
 	}
+
+	if (nameResolverCache)
+	{
+		nameResolverCache->addContextName(declContext, contextDeclName);
+	}
 	return contextDeclName;
 }
 
@@ -13,13 +13,15 @@ class CanonicalFilePathCache;
 class CxxDeclNameResolver: public CxxNameResolver
 {
 public:
-	CxxDeclNameResolver(CanonicalFilePathCache* canonicalFilePathCache);
+	CxxDeclNameResolver(
+		CanonicalFilePathCache* canonicalFilePathCache,
+		CxxNameResolverCache* nameResolverCache = nullptr);
 	CxxDeclNameResolver(const CxxNameResolver* other);
 
 	std::unique_ptr<CxxDeclName> getName(const clang::NamedDecl* declaration);
 
 private:
-	std::unique_ptr<CxxName> getContextName(const clang::DeclContext* declaration);
+	std::shared_ptr<CxxName> getContextName(const clang::DeclContext* declContext);
 	std::unique_ptr<CxxDeclName> getDeclName(const clang::NamedDecl* declaration);
 	std::wstring getTranslationUnitMainFileName(const clang::Decl* declaration);
 	std::wstring getNameForAnonymousSymbol(
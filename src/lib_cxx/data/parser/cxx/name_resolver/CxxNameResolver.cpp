@@ -1,12 +1,14 @@
 #include "CxxNameResolver.h"
 
-CxxNameResolver::CxxNameResolver(CanonicalFilePathCache* canonicalFilePathCache)
-	: m_canonicalFilePathCache(canonicalFilePathCache)
+CxxNameResolver::CxxNameResolver(
+	CanonicalFilePathCache* canonicalFilePathCache, CxxNameResolverCache* nameResolverCache)
+	: m_canonicalFilePathCache(canonicalFilePathCache), m_nameResolverCache(nameResolverCache)
 {
 }
 
 CxxNameResolver::CxxNameResolver(const CxxNameResolver* other)
 	: m_canonicalFilePathCache(other->getCanonicalFilePathCache())
+	, m_nameResolverCache(other->m_nameResolverCache)
 	, m_ignoredContextDecls(other->getIgnoredContextDecls())
 {
 }
@@ -48,6 +50,11 @@ CanonicalFilePathCache* CxxNameResolver::getCanonicalFilePathCache() const
 	return m_canonicalFilePathCache;
 }
 
+CxxNameResolverCache* CxxNameResolver::getNameResolverCache() const
+{
+	return m_ignoredContextDecls.empty() ? m_nameResolverCache : nullptr;
+}
+
 const std::vector<const clang::Decl*>& CxxNameResolver::getIgnoredContextDecls() const
 {
 	return m_ignoredContextDecls;
@@ -6,11 +6,14 @@
 #include <clang/AST/Decl.h>
 
 class CanonicalFilePathCache;
+class CxxNameResolverCache;
 
 class CxxNameResolver
 {
 public:
-	CxxNameResolver(CanonicalFilePathCache* canonicalFilePathCache);
+	CxxNameResolver(
+		CanonicalFilePathCache* canonicalFilePathCache,
+		CxxNameResolverCache* nameResolverCache = nullptr);
 	CxxNameResolver(const CxxNameResolver* other);
 
 	void ignoreContextDecl(const clang::Decl* decl);
@@ -19,10 +22,14 @@ public:
 
 protected:
 	CanonicalFilePathCache* getCanonicalFilePathCache() const;
+
+	// returns the cache only if it can be used, names are cached while no context is ignored
+	CxxNameResolverCache* getNameResolverCache() const;
 	const std::vector<const clang::Decl*>& getIgnoredContextDecls() const;
 
 private:
 	CanonicalFilePathCache* m_canonicalFilePathCache;
+	CxxNameResolverCache* m_nameResolverCache;
 	std::vector<const clang::Decl*> m_ignoredContextDecls;
 };
 
@@ -0,0 +1,38 @@
+#include "CxxNameResolverCache.h"
+
+#include "CxxDeclName.h"
+
+bool CxxNameResolverCache::getContextName(
+	const clang::DeclContext* declContext, std::shared_ptr<CxxName>& name) const
+{
+	auto it = m_contextNames.find(declContext);
+	if (it != m_contextNames.end())
+	{
+		name = it->second;
+		return true;
+	}
+	return false;
+}
+
+void CxxNameResolverCache::addContextName(
+	const clang::DeclContext* declContext, std::shared_ptr<CxxName> name)
+{
+	m_contextNames.emplace(declContext, std::move(name));
+}
+
+std::shared_ptr<CxxDeclName> CxxNameResolverCache::getDeclName(
+	const clang::NamedDecl* declaration) const
+{
+	auto it = m_declNames.find(declaration);
+	if (it != m_declNames.end())
+	{
+		return it->second;
+	}
+	return nullptr;
+}
+
+void CxxNameResolverCache::addDeclName(
+	const clang::NamedDecl* declaration, std::shared_ptr<CxxDeclName> name)
+{
+	m_declNames.emplace(declaration, std::move(name));
+}
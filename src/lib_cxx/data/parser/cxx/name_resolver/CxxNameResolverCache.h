@@ -0,0 +1,29 @@
+#ifndef CXX_NAME_RESOLVER_CACHE_H
+#define CXX_NAME_RESOLVER_CACHE_H
+
+#include <memory>
+#include <unordered_map>
+
+#include <clang/AST/Decl.h>
+
+class CxxDeclName;
+class CxxName;
+
+// Keeps names that were resolved without ignoring any context. These names only depend on the
+// resolved declaration, so they stay valid as long as the AST of the translation unit is alive.
+class CxxNameResolverCache
+{
+public:
+	bool getContextName(
+		const clang::DeclContext* declContext, std::shared_ptr<CxxName>& name) const;
+	void addContextName(const clang::DeclContext* declContext, std::shared_ptr<CxxName> name);
+
+	std::shared_ptr<CxxDeclName> getDeclName(const clang::NamedDecl* declaration) const;
+	void addDeclName(const clang::NamedDecl* declaration, std::shared_ptr<CxxDeclName> name);
+
+private:
+	std::unordered_map<const clang::DeclContext*, std::shared_ptr<CxxName>> m_contextNames;
+	std::unordered_map<const clang::NamedDecl*, std::shared_ptr<CxxDeclName>> m_declNames;
+};
+
+#endif	  // CXX_NAME_RESOLVER_CACHE_H
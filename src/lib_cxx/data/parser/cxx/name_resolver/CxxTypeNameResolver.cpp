@@ -5,13 +5,16 @@
 #include <clang/AST/PrettyPrinter.h>
 
 #include "CxxDeclNameResolver.h"
+#include "CxxNameResolverCache.h"
 #include "CxxSpecifierNameResolver.h"
 #include "CxxTemplateArgumentNameResolver.h"
+#include "IndexingProfile.h"
 #include "logging.h"
 #include "utilityString.h"
 
-CxxTypeNameResolver::CxxTypeNameResolver(CanonicalFilePathCache* canonicalFilePathCache)
-	: CxxNameResolver(canonicalFilePathCache)
+CxxTypeNameResolver::CxxTypeNameResolver(
+	CanonicalFilePathCache* canonicalFilePathCache, CxxNameResolverCache* nameResolverCache)
+	: CxxNameResolver(canonicalFilePathCache, nameResolverCache)
 {
 }
 
@@ -29,6 +32,8 @@ std::unique_ptr<CxxTypeName> CxxTypeNameResolver::getName(const clang::QualType&
 
 std::unique_ptr<CxxTypeName> CxxTypeNameResolver::getName(const clang::Type* type)
 {
+	IndexingProfile::ScopedPhase profilePhase(INDEXING_PHASE_NAME_RESOLUTION);
+
 	if (type)
 	{
 		switch (type->getTypeClass())
@@ -48,7 +53,7 @@ std::unique_ptr<CxxTypeName> CxxTypeNameResolver::getName(const clang::Type* typ
 		}
 		case clang::Type::Typedef:
 		{
-			std::unique_ptr<CxxDeclName> declName = CxxDeclNameResolver(this).getName(
+			std::shared_ptr<CxxDeclName> declName = getDeclName(
 				type->getAs<clang::TypedefType>()->getDecl());
 			if (declName)
 			{
@@ -105,7 +110,7 @@ std::unique_ptr<CxxTypeName> CxxTypeNameResolver::getName(const clang::Type* typ
 		case clang::Type::Enum:
 		case clang::Type::Record:
 		{
-			std::unique_ptr<CxxDeclName> declName = CxxDeclNameResolver(this).getName(
+			std::shared_ptr<CxxDeclName> declName = getDeclName(
 				type->getAs<clang::TagType>()->getDecl());
 			if (declName)
 			{
@@ -135,8 +140,7 @@ std::unique_ptr<CxxTypeName> CxxTypeNameResolver::getName(const clang::Type* typ
 												  // into namepart and parameter part
 			if (tagType)
 			{
-				std::unique_ptr<CxxDeclName> declName = CxxDeclNameResolver(this).getName(
-					tagType->getDecl());
+				std::shared_ptr<CxxDeclName> declName = getDeclName(tagType->getDecl());
 				if (declName)
 				{
 					return std::make_unique<CxxTypeName>(
@@ -293,3 +297,23 @@ std::unique_ptr<CxxTypeName> CxxTypeNameResolver::getName(const clang::Type* typ
 	}
 	return nullptr;
 }
+
+std::shared_ptr<CxxDeclName> CxxTypeNameResolver::getDeclName(const clang::NamedDecl* declaration)
+{
+	// many different types refer to the same declaration, e.g. "Foo", "const Foo&" and "Foo*"
+	CxxNameResolverCache* nameResolverCache = getNameResolverCache();
+	if (nameResolverCache)
+	{
+		if (std::shared_ptr<CxxDeclName> declName = nameResolverCache->getDeclName(declaration))
+		{
+			return declName;
+		}
+	}
+
+	std::shared_ptr<CxxDeclName> declName = CxxDeclNameResolver(this).getName(declaration);
+	if (nameResolverCache && declName)
+	{
+		nameResolverCache->addDeclName(declaration, declName);
+	}
+	return declName;
+}
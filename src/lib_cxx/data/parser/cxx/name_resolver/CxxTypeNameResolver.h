@@ -4,14 +4,21 @@
 #include "CxxNameResolver.h"
 #include "CxxTypeName.h"
 
+class CxxDeclName;
+
 class CxxTypeNameResolver: public CxxNameResolver
 {
 public:
-	CxxTypeNameResolver(CanonicalFilePathCache* canonicalFilePathCache);
+	CxxTypeNameResolver(
+		CanonicalFilePathCache* canonicalFilePathCache,
+		CxxNameResolverCache* nameResolverCache = nullptr);
 	CxxTypeNameResolver(const CxxNameResolver* other);
 
 	std::unique_ptr<CxxTypeName> getName(const clang::QualType& qualType);
 	std::unique_ptr<CxxTypeName> getName(const clang::Type* type);
+
+private:
+	std::shared_ptr<CxxDeclName> getDeclName(const clang::NamedDecl* declaration);
 };
 
 #endif	  // CXX_TYPE_NAME_RESOLVER_H
@@ -0,0 +1,319 @@
+#include "CxxImplicitPchPlanner.h"
+
+#include <cctype>
+#include <fstream>
+#include <map>
+
+#include "FileSystem.h"
+#include "TextAccess.h"
+#include "utility.h"
+#include "utilityHash.h"
+#include "utilityString.h"
+
+namespace
+{
+bool getDirectiveArgument(
+	const std::string& directive, const std::string& keyword, std::string& argument)
+{
+	if (!utility::isPrefix(keyword, directive) || directive.size() <= keyword.size() ||
+		!std::isspace(static_cast<unsigned char>(directive[keyword.size()])))
+	{
+		return false;
+	}
+
+	argument = utility::trim(directive.substr(keyword.size()));
+	return true;
+}
+
+std::string getPchInputStamp(const FilePath& filePath)
+{
+	if (!filePath.recheckExists())
+	{
+		return "";
+	}
+
+	// clang rejects a precompiled header as soon as the size or modification time of one of its
+	// inputs changed, even if a file was only touched. The content hash catches edits that keep
+	// the size within the same second.
+	return std::to_string(FileSystem::getFileByteSize(filePath)) + ' ' +
+		FileSystem::getLastWriteTime(filePath).toString() + ' ' +
+		utility::getContentHash(TextAccess::createFromFile(filePath)->getText());
+}
+
+FilePath getPrefixHeaderFilePath(const FilePath& filePath)
+{
+	// "<hash>.h", "<hash>.h.pch" and "<hash>.h.pch.inputs" belong to the same prefix header
+	FilePath prefixHeaderFilePath = filePath;
+	while (!prefixHeaderFilePath.extension().empty() && prefixHeaderFilePath.extension() != L".h")
+	{
+		prefixHeaderFilePath = prefixHeaderFilePath.withoutExtension();
+	}
+	return prefixHeaderFilePath;
+}
+}	 // namespace
+
+std::vector<std::string> CxxImplicitPchPlanner::getLeadingDirectives(
+	const std::vector<std::string>& lines)
+{
+	std::vector<std::string> directives;
+
+	bool inBlockComment = false;
+	for (const std::string& line: lines)
+	{
+		std::string code = utility::trim(line);
+		while (!code.empty())
+		{
+			if (inBlockComment)
+			{
+				const size_t pos = code.find("*/");
+				code = (pos == std::string::npos ? "" : utility::trim(code.substr(pos + 2)));
+				inBlockComment = (pos == std::string::npos);
+			}
+			else if (utility::isPrefix<std::string>("//", code))
+			{
+				code.clear();
+			}
+			else if (utility::isPrefix<std::string>("/*", code))
+			{
+				code = code.substr(2);
+				inBlockComment = true;
+			}
+			else
+			{
+				break;
+			}
+		}
+
+		if (code.empty())
+		{
+			continue;
+		}
+
+		if (code[0] != '#')
+		{
+			break;
+		}
+
+		directives.push_back(utility::trim(code.substr(1)));
+	}
+
+	return directives;
+}
+
+bool CxxImplicitPchPlanner::isIncludeGuarded(const std::vector<std::string>& directives)
+{
+	std::string argument;
+	if (!directives.empty() && getDirectiveArgument(directives[0], "pragma", argument))
+	{
+		return argument == "once";
+	}
+
+	std::string guardMacro;
+	return directives.size() >= 2 && getDirectiveArgument(directives[0], "ifndef", guardMacro) &&
+		getDirectiveArgument(directives[1], "define", argument) &&
+		utility::substrBeforeFirst(argument, ' ') == guardMacro;
+}
+
+std::vector<CxxImplicitPchPlanner::Include> CxxImplicitPchPlanner::getLeadingIncludes(
+	const std::vector<std::string>& directives,
+	const FilePath& sourceDirectoryPath,
+	const std::vector<FilePath>& searchDirectoryPaths)
+{
+	std::vector<Include> includes;
+	for (const std::string& directive: directives)
+	{
+		std::string argument;
+		if (!getDirectiveArgument(directive, "include", argument) || argument.size() < 2)
+		{
+			break;
+		}
+
+		const char closingDelimiter = (argument[0] == '<' ? '>' : argument[0]);
+		const size_t end = argument.find(closingDelimiter, 1);
+		if ((argument[0] != '<' && argument[0] != '"') || end == std::string::npos)
+		{
+			break;
+		}
+
+		const std::string trailing = utility::trim(argument.substr(end + 1));
+		if (!trailing.empty() && !utility::isPrefix<std::string>("//", trailing))
+		{
+			break;
+		}
+
+		Include include;
+		include.spelling = argument.substr(0, end + 1);
+
+		const FilePath includedPath(utility::decodeFromUtf8(argument.substr(1, end - 1)));
+		if (closingDelimiter == '"' && sourceDirectoryPath.getConcatenated(includedPath).exists())
+		{
+			include.filePath = sourceDirectoryPath.getConcatenated(includedPath).makeAbsolute();
+			include.spelling = '"' + include.filePath.str() + '"';
+		}
+		else
+		{
+			for (const FilePath& searchDirectoryPath: searchDirectoryPaths)
+			{
+				if (searchDirectoryPath.getConcatenated(includedPath).exists())
+				{
+					include.filePath =
+						searchDirectoryPath.getConcatenated(includedPath).makeAbsolute();
+					break;
+				}
+			}
+		}
+
+		includes.push_back(include);
+	}
+	return includes;
+}
+
+std::string CxxImplicitPchPlanner::getPrefixHeaderContent(const std::vector<Include>& prefix)
+{
+	std::string content;
+	for (const Include& include: prefix)
+	{
+		content += "#include " + include.spelling + '\n';
+	}
+	return content;
+}
+
+FilePath CxxImplicitPchPlanner::getPchInputsFilePath(const FilePath& pchOutputFilePath)
+{
+	return FilePath(pchOutputFilePath.wstr() + L".inputs");
+}
+
+void CxxImplicitPchPlanner::writePchInputs(
+	const FilePath& pchOutputFilePath, const std::vector<FilePath>& inputFilePaths)
+{
+	std::ofstream fileStream;
+	fileStream.open(getPchInputsFilePath(pchOutputFilePath).str());
+	for (const FilePath& inputFilePath: inputFilePaths)
+	{
+		fileStream << getPchInputStamp(inputFilePath) << '\t'
+				   << utility::encodeToUtf8(inputFilePath.wstr()) << '\n';
+	}
+	fileStream.close();
+}
+
+bool CxxImplicitPchPlanner::isPchUpToDate(const FilePath& pchOutputFilePath)
+{
+	const FilePath inputsFilePath = getPchInputsFilePath(pchOutputFilePath);
+	if (!pchOutputFilePath.recheckExists() || !inputsFilePath.recheckExists())
+	{
+		return false;
+	}
+
+	std::ifstream fileStream(inputsFilePath.str());
+	std::string line;
+	bool hasInputs = false;
+	while (std::getline(fileStream, line))
+	{
+		const size_t pos = line.find('\t');
+		if (pos == std::string::npos || pos == 0 ||
+			getPchInputStamp(FilePath(utility::decodeFromUtf8(line.substr(pos + 1)))) !=
+				line.substr(0, pos))
+		{
+			return false;
+		}
+		hasInputs = true;
+	}
+	return hasInputs;
+}
+
+void CxxImplicitPchPlanner::removeUnusedPchs(
+	const FilePath& pchDirectoryPath, const std::set<FilePath>& prefixHeaderFilePaths)
+{
+	for (const FilePath& filePath: FileSystem::getFilePathsFromDirectory(pchDirectoryPath))
+	{
+		if (prefixHeaderFilePaths.find(getPrefixHeaderFilePath(filePath)) ==
+			prefixHeaderFilePaths.end())
+		{
+			FileSystem::remove(filePath);
+		}
+	}
+}
+
+CxxImplicitPchPlanner::CxxImplicitPchPlanner(size_t minimumTranslationUnitCount)
+	: m_minimumTranslationUnitCount(minimumTranslationUnitCount)
+{
+}
+
+size_t CxxImplicitPchPlanner::addTranslationUnit(
+	const std::wstring& key, const std::vector<Include>& includes)
+{
+	m_translationUnits.emplace_back(key, includes);
+	return m_translationUnits.size() - 1;
+}
+
+std::vector<CxxImplicitPchPlanner::Group> CxxImplicitPchPlanner::getGroups(
+	const std::function<bool(const FilePath&)>& isHeaderIncludeGuarded) const
+{
+	// translation units with the same key that start with the same include are grouped, each
+	// group shares the longest include prefix of its translation units
+	std::map<std::wstring, std::vector<size_t>> groupIndices;
+	for (size_t i = 0; i < m_translationUnits.size(); i++)
+	{
+		const std::vector<Include>& includes = m_translationUnits[i].second;
+		if (!includes.empty())
+		{
+			groupIndices[m_translationUnits[i].first + L'\n' +
+						 utility::decodeFromUtf8(includes.front().spelling)]
+				.push_back(i);
+		}
+	}
+
+	std::map<FilePath, bool> includeGuardedHeaders;
+
+	std::vector<Group> groups;
+	for (const auto& it: groupIndices)
+	{
+		const std::vector<size_t>& indices = it.second;
+		if (indices.size() < m_minimumTranslationUnitCount)
+		{
+			continue;
+		}
+
+		std::vector<Include> prefix = m_translationUnits[indices.front()].second;
+		for (const size_t index: indices)
+		{
+			const std::vector<Include>& includes = m_translationUnits[index].second;
+			size_t length = 0;
+			while (length < prefix.size() && length < includes.size() &&
+				   prefix[length].spelling == includes[length].spelling)
+			{
+				length++;
+			}
+			prefix.resize(length);
+		}
+
+		for (size_t i = 0; i < prefix.size(); i++)
+		{
+			const FilePath& headerFilePath = prefix[i].filePath;
+			if (headerFilePath.empty())
+			{
+				continue;
+			}
+
+			auto guardedIt = includeGuardedHeaders.find(headerFilePath);
+			if (guardedIt == includeGuardedHeaders.end())
+			{
+				guardedIt = includeGuardedHeaders
+								.emplace(headerFilePath, isHeaderIncludeGuarded(headerFilePath))
+								.first;
+			}
+
+			if (!guardedIt->second)
+			{
+				prefix.resize(i);
+				break;
+			}
+		}
+
+		if (!prefix.empty())
+		{
+			groups.push_back({it.first, prefix, indices});
+		}
+	}
+	return groups;
+}
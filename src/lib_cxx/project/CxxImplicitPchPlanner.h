@@ -0,0 +1,74 @@
+#ifndef CXX_IMPLICIT_PCH_PLANNER_H
+#define CXX_IMPLICIT_PCH_PLANNER_H
+
+#include <functional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "FilePath.h"
+
+// Groups translation units that start with the same includes, so that the shared include prefix of
+// each group can be precompiled once. Apart from the inputs files of precompiled headers, only
+// reads files, the caller decides what to write.
+class CxxImplicitPchPlanner
+{
+public:
+	struct Include
+	{
+		std::string spelling;
+		FilePath filePath;	  // empty if the include could not be resolved
+	};
+
+	struct Group
+	{
+		std::wstring key;
+		std::vector<Include> prefix;
+		std::vector<size_t> translationUnitIndices;
+	};
+
+	// Returns the preprocessor directives at the start of a file, up to the first line of code.
+	// Comments, blank lines and the leading '#' are removed.
+	static std::vector<std::string> getLeadingDirectives(const std::vector<std::string>& lines);
+
+	static bool isIncludeGuarded(const std::vector<std::string>& directives);
+
+	// Returns the #include directives that start a source file. Quoted includes found next to the
+	// source file are spelled with their absolute path, so that they resolve to the same header
+	// when included from elsewhere.
+	static std::vector<Include> getLeadingIncludes(
+		const std::vector<std::string>& directives,
+		const FilePath& sourceDirectoryPath,
+		const std::vector<FilePath>& searchDirectoryPaths);
+
+	static std::string getPrefixHeaderContent(const std::vector<Include>& prefix);
+
+	// The inputs file of a precompiled header lists the size, modification time and content hash
+	// of every file it was built from. The precompiled header can be reused as long as these match.
+	static FilePath getPchInputsFilePath(const FilePath& pchOutputFilePath);
+	static void writePchInputs(
+		const FilePath& pchOutputFilePath, const std::vector<FilePath>& inputFilePaths);
+	static bool isPchUpToDate(const FilePath& pchOutputFilePath);
+
+	// Removes the prefix headers in the directory that are not in the given set, together with
+	// their precompiled headers and inputs files.
+	static void removeUnusedPchs(
+		const FilePath& pchDirectoryPath, const std::set<FilePath>& prefixHeaderFilePaths);
+
+	CxxImplicitPchPlanner(size_t minimumTranslationUnitCount);
+
+	// Translation units with different keys, e.g. different flags or languages, are never grouped.
+	// Returns the index of the translation unit.
+	size_t addTranslationUnit(const std::wstring& key, const std::vector<Include>& includes);
+
+	// The source files still include the prefix themselves after it was precompiled, so the prefix
+	// of each group ends before the first header that would expand twice.
+	std::vector<Group> getGroups(
+		const std::function<bool(const FilePath&)>& isHeaderIncludeGuarded) const;
+
+private:
+	const size_t m_minimumTranslationUnitCount;
+	std::vector<std::pair<std::wstring, std::vector<Include>>> m_translationUnits;
+};
+
+#endif	  // CXX_IMPLICIT_PCH_PLANNER_H
@@ -1,5 +1,7 @@
 #include "SourceGroupCxxCdb.h"
 
+#include <map>
+
 #include <clang/Tooling/JSONCompilationDatabase.h>
 #include <clang/Tooling/Tooling.h>
 
@@ -11,7 +13,6 @@
 #include "IndexerCommandCxx.h"
 #include "MessageStatus.h"
 #include "SourceGroupSettingsCxxCdb.h"
-#include "TaskLambda.h"
 #include "logging.h"
 #include "utility.h"
 #include "utilitySourceGroupCxx.h"
@@ -34,6 +35,20 @@ bool SourceGroupCxxCdb::prepareIndexing()
 		Application::getInstance()->handleDialog(error, {L"Ok"});
 		return false;
 	}
+
+	m_implicitPchs.clear();
+	if (m_settings->getPchInputFilePath().empty() &&
+		ApplicationSettings::getInstance()->getImplicitPchEnabled())
+	{
+		// all source files are grouped, so that the groups don't depend on the files to index
+		std::shared_ptr<clang::tooling::JSONCompilationDatabase> cdb = utility::loadCDB(cdbPath);
+		if (cdb)
+		{
+			m_implicitPchs = utility::getImplicitPchs(
+				getIndexerCommandsCxx(cdb, getAllSourceFilePaths(cdb)),
+				getImplicitPchDirectoryPath());
+		}
+	}
 	return true;
 }
 
@@ -81,57 +96,42 @@ std::shared_ptr<IndexerCommandProvider> SourceGroupCxxCdb::getIndexerCommandProv
 	std::shared_ptr<CxxIndexerCommandProvider> provider =
 		std::make_shared<CxxIndexerCommandProvider>();
 
-	const FilePath cdbPath = m_settings->getCompilationDatabasePathExpandedAndAbsolute();
-	std::shared_ptr<clang::tooling::JSONCompilationDatabase> cdb = utility::loadCDB(cdbPath);
+	std::shared_ptr<clang::tooling::JSONCompilationDatabase> cdb = utility::loadCDB(
+		m_settings->getCompilationDatabasePathExpandedAndAbsolute());
 	if (!cdb)
 	{
 		return provider;
 	}
 
-	std::vector<std::wstring> compilerFlags = getBaseCompilerFlags();
-	utility::append(compilerFlags, m_settings->getCompilerFlags());
-
-	const std::vector<std::wstring> includePchFlags = utility::getIncludePchFlags(m_settings.get());
-
-	const std::set<FilePath> indexedHeaderPaths = utility::toSet(
-		m_settings->getIndexedHeaderPathsExpandedAndAbsolute());
-	const std::set<FilePathFilter> excludeFilters = utility::toSet(
-		m_settings->getExcludeFiltersExpandedAndAbsolute());
-	const std::set<FilePath>& sourceFilePaths = getAllSourceFilePaths(cdb);
-
-	for (const clang::tooling::CompileCommand& command: cdb->getAllCompileCommands())
+	std::set<FilePath> sourceFilePaths;
+	for (const FilePath& sourceFilePath: getAllSourceFilePaths(cdb))
 	{
-		FilePath sourcePath = FilePath(utility::decodeFromUtf8(command.Filename)).makeCanonical();
-		if (!sourcePath.isAbsolute())
+		if (info.filesToIndex.find(sourceFilePath) != info.filesToIndex.end())
 		{
-			sourcePath = FilePath(utility::decodeFromUtf8(command.Directory + '/' + command.Filename))
-							 .makeCanonical();
-			if (!sourcePath.isAbsolute())
-			{
-				sourcePath = cdbPath.getParentDirectory().getConcatenated(sourcePath).makeCanonical();
-			}
+			sourceFilePaths.insert(sourceFilePath);
 		}
+	}
 
-		if (info.filesToIndex.find(sourcePath) != info.filesToIndex.end() &&
-			sourceFilePaths.find(sourcePath) != sourceFilePaths.end())
+	std::map<FilePath, const utility::ImplicitPch*> implicitPchs;
+	for (const utility::ImplicitPch& pch: m_implicitPchs)
+	{
+		for (const FilePath& sourceFilePath: pch.sourceFilePaths)
 		{
-			std::vector<std::wstring> cdbFlags = utility::convert<std::string, std::wstring>(
-				command.CommandLine, [](const std::string& s) { return utility::decodeFromUtf8(s); });
-
-			utility::removeIncludePchFlag(cdbFlags);
-
-			if (command.CommandLine.size() != cdbFlags.size())
-			{
-				utility::append(cdbFlags, includePchFlags);
-			}
+			implicitPchs.emplace(sourceFilePath, &pch);
+		}
+	}
 
-			provider->addCommand(std::make_shared<IndexerCommandCxx>(
-				sourcePath,
-				utility::concat(indexedHeaderPaths, {sourcePath}),
-				excludeFilters,
-				std::set<FilePathFilter>(),
-				FilePath(utility::decodeFromUtf8(command.Directory)),
-				utility::concat(cdbFlags, compilerFlags)));
+	for (const std::shared_ptr<IndexerCommandCxx>& indexerCommand:
+		 getIndexerCommandsCxx(cdb, sourceFilePaths))
+	{
+		auto it = implicitPchs.find(indexerCommand->getSourceFilePath());
+		if (it != implicitPchs.end())
+		{
+			provider->addCommand(utility::getWithImplicitPchInclude(*indexerCommand, *it->second));
+		}
+		else
+		{
+			provider->addCommand(indexerCommand);
 		}
 	}
 
@@ -147,11 +147,18 @@ std::vector<std::shared_ptr<IndexerCommand>> SourceGroupCxxCdb::getIndexerComman
 }
 
 std::shared_ptr<Task> SourceGroupCxxCdb::getPreIndexTask(
-	std::shared_ptr<StorageProvider> storageProvider, std::shared_ptr<DialogView> dialogView) const
+	const RefreshInfo& info,
+	std::shared_ptr<StorageProvider> storageProvider,
+	std::shared_ptr<DialogView> dialogView) const
 {
 	if (m_settings->getPchInputFilePath().empty())
 	{
-		return std::make_shared<TaskLambda>([]() {});
+		return utility::createBuildImplicitPchTask(
+			m_implicitPchs,
+			info.filesToIndex,
+			getImplicitPchDirectoryPath(),
+			storageProvider,
+			dialogView);
 	}
 
 	std::vector<std::wstring> compilerFlags;
@@ -192,10 +199,10 @@ std::shared_ptr<Task> SourceGroupCxxCdb::getPreIndexTask(
 					}
 
 					CxxCompilationDatabaseSingle compilationDatabase(command);
-					ClangInvocationInfo info = ClangInvocationInfo::getClangInvocationString(
-						&compilationDatabase);
+					ClangInvocationInfo invocationInfo =
+						ClangInvocationInfo::getClangInvocationString(&compilationDatabase);
 
-					if (info.invocation.find("\"-x\" \"c++\""))
+					if (invocationInfo.invocation.find("\"-x\" \"c++\""))
 					{
 						compilerFlags.push_back(L"-x");
 						compilerFlags.push_back(L"c++");
@@ -248,3 +255,62 @@ std::vector<std::wstring> SourceGroupCxxCdb::getBaseCompilerFlags() const
 
 	return compilerFlags;
 }
+
+std::vector<std::shared_ptr<IndexerCommandCxx>> SourceGroupCxxCdb::getIndexerCommandsCxx(
+	std::shared_ptr<clang::tooling::JSONCompilationDatabase> cdb,
+	const std::set<FilePath>& sourceFilePaths) const
+{
+	const FilePath cdbPath = m_settings->getCompilationDatabasePathExpandedAndAbsolute();
+
+	std::vector<std::wstring> compilerFlags = getBaseCompilerFlags();
+	utility::append(compilerFlags, m_settings->getCompilerFlags());
+
+	const std::vector<std::wstring> includePchFlags = utility::getIncludePchFlags(m_settings.get());
+
+	const std::set<FilePath> indexedHeaderPaths = utility::toSet(
+		m_settings->getIndexedHeaderPathsExpandedAndAbsolute());
+	const std::set<FilePathFilter> excludeFilters = utility::toSet(
+		m_settings->getExcludeFiltersExpandedAndAbsolute());
+
+	std::vector<std::shared_ptr<IndexerCommandCxx>> indexerCommands;
+	for (const clang::tooling::CompileCommand& command: cdb->getAllCompileCommands())
+	{
+		FilePath sourcePath = FilePath(utility::decodeFromUtf8(command.Filename)).makeCanonical();
+		if (!sourcePath.isAbsolute())
+		{
+			sourcePath = FilePath(utility::decodeFromUtf8(command.Directory + '/' + command.Filename))
+							 .makeCanonical();
+			if (!sourcePath.isAbsolute())
+			{
+				sourcePath = cdbPath.getParentDirectory().getConcatenated(sourcePath).makeCanonical();
+			}
+		}
+
+		if (sourceFilePaths.find(sourcePath) != sourceFilePaths.end())
+		{
+			std::vector<std::wstring> cdbFlags = utility::convert<std::string, std::wstring>(
+				command.CommandLine, [](const std::string& s) { return utility::decodeFromUtf8(s); });
+
+			utility::removeIncludePchFlag(cdbFlags);
+
+			if (command.CommandLine.size() != cdbFlags.size())
+			{
+				utility::append(cdbFlags, includePchFlags);
+			}
+
+			indexerCommands.push_back(std::make_shared<IndexerCommandCxx>(
+				sourcePath,
+				utility::concat(indexedHeaderPaths, {sourcePath}),
+				excludeFilters,
+				std::set<FilePathFilter>(),
+				FilePath(utility::decodeFromUtf8(command.Directory)),
+				utility::concat(cdbFlags, compilerFlags)));
+		}
+	}
+	return indexerCommands;
+}
+
+FilePath SourceGroupCxxCdb::getImplicitPchDirectoryPath() const
+{
+	return m_settings->getPchDependenciesDirectoryPath().concatenate(L"implicit");
+}
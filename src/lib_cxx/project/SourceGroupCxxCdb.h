@@ -6,8 +6,8 @@
 #include <vector>
 
 #include "SourceGroup.h"
+#include "utilitySourceGroupCxx.h"
 
-class FilePath;
 namespace clang
 {
 namespace tooling
@@ -16,6 +16,7 @@ class JSONCompilationDatabase;
 }
 }	 // namespace clang
 
+class IndexerCommandCxx;
 class SourceGroupSettingsCxxCdb;
 
 class SourceGroupCxxCdb: public SourceGroup
@@ -32,6 +33,7 @@ public:
 		const RefreshInfo& info) const override;
 	std::vector<std::shared_ptr<IndexerCommand>> getIndexerCommands(const RefreshInfo& info) const override;
 	std::shared_ptr<Task> getPreIndexTask(
+		const RefreshInfo& info,
 		std::shared_ptr<StorageProvider> storageProvider,
 		std::shared_ptr<DialogView> dialogView) const override;
 
@@ -39,8 +41,15 @@ private:
 	std::shared_ptr<SourceGroupSettings> getSourceGroupSettings() override;
 	std::shared_ptr<const SourceGroupSettings> getSourceGroupSettings() const override;
 	std::vector<std::wstring> getBaseCompilerFlags() const;
+	std::vector<std::shared_ptr<IndexerCommandCxx>> getIndexerCommandsCxx(
+		std::shared_ptr<clang::tooling::JSONCompilationDatabase> cdb,
+		const std::set<FilePath>& sourceFilePaths) const;
+	FilePath getImplicitPchDirectoryPath() const;
 
 	std::shared_ptr<SourceGroupSettingsCxxCdb> m_settings;
+
+	// prefix headers shared by the source files, computed by prepareIndexing
+	std::vector<utility::ImplicitPch> m_implicitPchs;
 };
 
 #endif	  // SOURCE_GROUP_CXX_CDB_H
@@ -121,7 +121,9 @@ std::vector<std::shared_ptr<IndexerCommand>> SourceGroupCxxEmpty::getIndexerComm
 }
 
 std::shared_ptr<Task> SourceGroupCxxEmpty::getPreIndexTask(
-	std::shared_ptr<StorageProvider> storageProvider, std::shared_ptr<DialogView> dialogView) const
+	const RefreshInfo& info,
+	std::shared_ptr<StorageProvider> storageProvider,
+	std::shared_ptr<DialogView> dialogView) const
 {
 	const SourceGroupSettingsWithCxxPchOptions* pchSettings =
 		dynamic_cast<const SourceGroupSettingsWithCxxPchOptions*>(m_settings.get());
@@ -19,6 +19,7 @@ public:
 		const RefreshInfo& info) const override;
 	std::vector<std::shared_ptr<IndexerCommand>> getIndexerCommands(const RefreshInfo& info) const override;
 	std::shared_ptr<Task> getPreIndexTask(
+		const RefreshInfo& info,
 		std::shared_ptr<StorageProvider> storageProvider,
 		std::shared_ptr<DialogView> dialogView) const override;
 
@@ -1,24 +1,205 @@
 #include "utilitySourceGroupCxx.h"
 
+#include <fstream>
+#include <set>
+
 #include <clang/Tooling/JSONCompilationDatabase.h>
 
 #include "CanonicalFilePathCache.h"
 #include "CxxCompilationDatabaseSingle.h"
 #include "CxxDiagnosticConsumer.h"
+#include "CxxImplicitPchPlanner.h"
 #include "CxxParser.h"
 #include "DialogView.h"
 #include "FilePathFilter.h"
 #include "FileRegister.h"
 #include "FileSystem.h"
 #include "GeneratePCHAction.h"
+#include "IndexerCommandCxx.h"
+#include "IntermediateStorage.h"
 #include "ParserClientImpl.h"
+#include "PreprocessPCHAction.h"
 #include "SingleFrontendActionFactory.h"
 #include "SourceGroupSettingsWithCxxPchOptions.h"
 #include "StorageProvider.h"
 #include "TaskLambda.h"
+#include "TextAccess.h"
 #include "logging.h"
 #include "utility.h"
 
+namespace
+{
+// Builds the precompiled header, or only records its files and macros if "emitPch" is false, and
+// returns the recorded data after adding it to the storage provider.
+std::shared_ptr<IntermediateStorage> buildPch(
+	const FilePath& pchInputFilePath,
+	const FilePath& workingDirectory,
+	const std::vector<std::wstring>& compilerFlags,
+	std::shared_ptr<FileRegister> fileRegister,
+	std::shared_ptr<StorageProvider> storageProvider,
+	bool emitPch = true)
+{
+	std::shared_ptr<IntermediateStorage> storage = std::make_shared<IntermediateStorage>();
+	std::shared_ptr<ParserClientImpl> client = std::make_shared<ParserClientImpl>(storage.get());
+
+	std::shared_ptr<CanonicalFilePathCache> canonicalFilePathCache =
+		std::make_shared<CanonicalFilePathCache>(fileRegister);
+
+	clang::tooling::CompileCommand pchCommand;
+	pchCommand.Filename = utility::encodeToUtf8(pchInputFilePath.fileName());
+	pchCommand.Directory = utility::encodeToUtf8(workingDirectory.wstr());
+	// DON'T use "-fsyntax-only" here because it will cause the output file to be erased
+	pchCommand.CommandLine = utility::concat(
+		{"clang-tool"}, CxxParser::getCommandlineArgumentsEssential(compilerFlags));
+
+	CxxCompilationDatabaseSingle compilationDatabase(pchCommand);
+	clang::tooling::ClangTool tool(
+		compilationDatabase, {utility::encodeToUtf8(pchInputFilePath.wstr())});
+	clang::FrontendAction* action = nullptr;
+	if (emitPch)
+	{
+		action = new GeneratePCHAction(client, canonicalFilePathCache);
+	}
+	else
+	{
+		action = new PreprocessPCHAction(client, canonicalFilePathCache);
+	}
+
+	llvm::IntrusiveRefCntPtr<clang::DiagnosticOptions> options = new clang::DiagnosticOptions();
+	CxxDiagnosticConsumer diagnostics(
+		llvm::errs(), &*options, client, canonicalFilePathCache, pchInputFilePath, true);
+
+	tool.setDiagnosticConsumer(&diagnostics);
+	tool.clearArgumentsAdjusters();
+	tool.run(new SingleFrontendActionFactory(action));
+
+	storageProvider->insert(storage);
+
+	return storage;
+}
+
+// the prefix header is listed as well, since the files recorded in the storage may not include it
+void writePchInputs(
+	const FilePath& pchOutputFilePath,
+	const FilePath& pchInputFilePath,
+	const IntermediateStorage& storage)
+{
+	std::vector<FilePath> inputFilePaths = {pchInputFilePath};
+	for (const StorageFile& file: storage.getStorageFiles())
+	{
+		inputFilePaths.push_back(FilePath(file.filePath));
+	}
+	CxxImplicitPchPlanner::writePchInputs(pchOutputFilePath, inputFilePaths);
+}
+
+bool isIncludeGuarded(const FilePath& headerFilePath)
+{
+	return CxxImplicitPchPlanner::isIncludeGuarded(CxxImplicitPchPlanner::getLeadingDirectives(
+		TextAccess::createFromFile(headerFilePath)->getAllLines()));
+}
+
+std::vector<FilePath> getHeaderSearchDirectories(const IndexerCommandCxx& indexerCommand)
+{
+	const std::vector<std::wstring> searchPathFlags = {
+		L"-I", L"-iquote", L"-isystem", L"-idirafter"};
+	const std::vector<std::wstring>& compilerFlags = indexerCommand.getCompilerFlags();
+
+	std::vector<FilePath> directories;
+	for (size_t i = 0; i < compilerFlags.size(); i++)
+	{
+		for (const std::wstring& searchPathFlag: searchPathFlags)
+		{
+			if (utility::isPrefix(searchPathFlag, compilerFlags[i]))
+			{
+				FilePath directory(compilerFlags[i].substr(searchPathFlag.size()));
+				if (compilerFlags[i] == searchPathFlag && i + 1 < compilerFlags.size())
+				{
+					directory = FilePath(compilerFlags[++i]);
+				}
+
+				if (!directory.isAbsolute())
+				{
+					directory = indexerCommand.getWorkingDirectory().getConcatenated(directory);
+				}
+				directories.push_back(directory);
+				break;
+			}
+		}
+	}
+	return directories;
+}
+
+std::wstring getPchLanguage(const FilePath& sourceFilePath)
+{
+	const std::wstring extension = sourceFilePath.extension();
+	if (extension == L".c")
+	{
+		return L"c-header";
+	}
+	else if (extension == L".m")
+	{
+		return L"objective-c-header";
+	}
+	else if (extension == L".mm")
+	{
+		return L"objective-c++-header";
+	}
+	else if (
+		extension == L".cpp" || extension == L".cc" || extension == L".cxx" ||
+		extension == L".c++" || extension == L".cp" || extension == L".C")
+	{
+		return L"c++-header";
+	}
+	return L"";
+}
+
+// Implicit prefix headers rely on being the first forced include and on the language following
+// from the file extension, so commands that already pick these themselves are left alone.
+bool canUseImplicitPch(const std::vector<std::wstring>& compilerFlags)
+{
+	for (const std::wstring& flag: compilerFlags)
+	{
+		if (utility::isPrefix<std::wstring>(L"-include", flag) ||
+			utility::isPrefix<std::wstring>(L"-imacros", flag) ||
+			utility::isPrefix<std::wstring>(L"-x", flag) || flag == L"--driver-mode=cl")
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+std::vector<std::wstring> getPchCompilerFlags(const IndexerCommandCxx& indexerCommand)
+{
+	const std::set<std::wstring> flagsWithOutputArgument = {L"-o", L"-MF", L"-MT", L"-MQ"};
+	const std::set<std::wstring> flagsWithOutput = {L"-c", L"-M", L"-MM", L"-MD", L"-MMD", L"-MP"};
+	const std::wstring sourceFileName = indexerCommand.getSourceFilePath().fileName();
+	const std::vector<std::wstring>& compilerFlags = indexerCommand.getCompilerFlags();
+
+	std::vector<std::wstring> pchFlags;
+	for (size_t i = 0; i < compilerFlags.size(); i++)
+	{
+		const std::wstring& flag = compilerFlags[i];
+		if (flagsWithOutputArgument.find(flag) != flagsWithOutputArgument.end())
+		{
+			i++;
+		}
+		else if (utility::isPrefix<std::wstring>(L"-", flag))
+		{
+			if (flagsWithOutput.find(flag) == flagsWithOutput.end())
+			{
+				pchFlags.push_back(flag);
+			}
+		}
+		else if (i != 0 && FilePath(flag).fileName() != sourceFileName)
+		{
+			pchFlags.push_back(flag);
+		}
+	}
+	return pchFlags;
+}
+}	 // namespace
+
 namespace utility
 {
 std::shared_ptr<Task> createBuildPchTask(
@@ -67,41 +248,221 @@ std::shared_ptr<Task> createBuildPchTask(
 				FileSystem::createDirectory(pchOutputFilePath.getParentDirectory());
 			}
 
-			std::shared_ptr<IntermediateStorage> storage = std::make_shared<IntermediateStorage>();
-			std::shared_ptr<ParserClientImpl> client = std::make_shared<ParserClientImpl>(
-				storage.get());
+			buildPch(
+				pchInputFilePath,
+				pchOutputFilePath.getParentDirectory(),
+				compilerFlags,
+				std::make_shared<FileRegister>(
+					pchInputFilePath,
+					std::set<FilePath> {pchInputFilePath},
+					std::set<FilePathFilter> {}),
+				storageProvider);
+		});
+}
 
-			std::shared_ptr<FileRegister> fileRegister = std::make_shared<FileRegister>(
-				pchInputFilePath, std::set<FilePath> {pchInputFilePath}, std::set<FilePathFilter> {});
+std::vector<ImplicitPch> getImplicitPchs(
+	const std::vector<std::shared_ptr<IndexerCommandCxx>>& indexerCommands,
+	const FilePath& pchDirectoryPath)
+{
+	// a precompiled prefix is only worth building if it saves parsing it a few times
+	CxxImplicitPchPlanner planner(4);
 
-			std::shared_ptr<CanonicalFilePathCache> canonicalFilePathCache =
-				std::make_shared<CanonicalFilePathCache>(fileRegister);
+	// commands with the same preprocessor context and language can share a prefix header
+	std::vector<size_t> commandIndices;
+	for (size_t i = 0; i < indexerCommands.size(); i++)
+	{
+		const IndexerCommandCxx& indexerCommand = *indexerCommands[i];
+		const std::wstring language = getPchLanguage(indexerCommand.getSourceFilePath());
+		if (language.empty() || !canUseImplicitPch(indexerCommand.getCompilerFlags()))
+		{
+			continue;
+		}
 
-			clang::tooling::CompileCommand pchCommand;
-			pchCommand.Filename = utility::encodeToUtf8(pchInputFilePath.fileName());
-			pchCommand.Directory = pchOutputFilePath.getParentDirectory().str();
-			// DON'T use "-fsyntax-only" here because it will cause the output file to be erased
-			pchCommand.CommandLine = utility::concat(
-				{"clang-tool"}, CxxParser::getCommandlineArgumentsEssential(compilerFlags));
+		planner.addTranslationUnit(
+			indexerCommand.getPreprocessorContext() + L'\n' + language,
+			CxxImplicitPchPlanner::getLeadingIncludes(
+				CxxImplicitPchPlanner::getLeadingDirectives(
+					TextAccess::createFromFile(indexerCommand.getSourceFilePath())->getAllLines()),
+				indexerCommand.getSourceFilePath().getParentDirectory(),
+				getHeaderSearchDirectories(indexerCommand)));
+		commandIndices.push_back(i);
+	}
 
-			CxxCompilationDatabaseSingle compilationDatabase(pchCommand);
-			clang::tooling::ClangTool tool(
-				compilationDatabase, {utility::encodeToUtf8(pchInputFilePath.wstr())});
-			GeneratePCHAction* action = new GeneratePCHAction(client, canonicalFilePathCache);
+	const FilePathFilter pchDirectoryFilter(pchDirectoryPath.wstr() + L"/**");
 
-			llvm::IntrusiveRefCntPtr<clang::DiagnosticOptions> options =
-				new clang::DiagnosticOptions();
-			CxxDiagnosticConsumer diagnostics(
-				llvm::errs(), &*options, client, canonicalFilePathCache, pchInputFilePath, true);
+	std::vector<ImplicitPch> pchs;
+	for (const CxxImplicitPchPlanner::Group& group: planner.getGroups(isIncludeGuarded))
+	{
+		ImplicitPch pch;
+		pch.inputFileContent = CxxImplicitPchPlanner::getPrefixHeaderContent(group.prefix);
 
-			tool.setDiagnosticConsumer(&diagnostics);
-			tool.clearArgumentsAdjusters();
-			tool.run(new SingleFrontendActionFactory(action));
+		// the prefix header is named after its content and flags, so it is kept for later indexing
+		// runs and only written once, because rewriting it would invalidate its precompiled header
+		pch.inputFilePath = pchDirectoryPath.getConcatenated(
+			std::to_wstring(std::hash<std::wstring>()(
+				group.key + L'\n' + utility::decodeFromUtf8(pch.inputFileContent))) +
+			L".h");
 
-			storageProvider->insert(storage);
-		});
+		const IndexerCommandCxx& firstCommand =
+			*indexerCommands[commandIndices[group.translationUnitIndices.front()]];
+
+		std::set<FilePath> indexedPaths = firstCommand.getIndexedPaths();
+		indexedPaths.erase(firstCommand.getSourceFilePath());
+
+		pch.pchCommand = std::make_shared<IndexerCommandCxx>(
+			pch.inputFilePath,
+			indexedPaths,
+			utility::concat(firstCommand.getExcludeFilters(), pchDirectoryFilter),
+			firstCommand.getIncludeFilters(),
+			firstCommand.getWorkingDirectory(),
+			utility::concat(
+				getPchCompilerFlags(firstCommand),
+				{L"-x", getPchLanguage(firstCommand.getSourceFilePath())}));
+
+		for (const size_t index: group.translationUnitIndices)
+		{
+			pch.sourceFilePaths.insert(indexerCommands[commandIndices[index]]->getSourceFilePath());
+		}
+
+		pchs.push_back(pch);
+	}
+
+	return pchs;
+}
+
+std::shared_ptr<IndexerCommandCxx> getWithImplicitPchInclude(
+	const IndexerCommandCxx& indexerCommand, const ImplicitPch& pch)
+{
+	// the driver picks up "<header>.pch" for the first forced include and falls back to including
+	// the header if building the precompiled header failed
+	return std::make_shared<IndexerCommandCxx>(
+		indexerCommand.getSourceFilePath(),
+		indexerCommand.getIndexedPaths(),
+		utility::concat(
+			indexerCommand.getExcludeFilters(),
+			FilePathFilter(pch.inputFilePath.getParentDirectory().wstr() + L"/**")),
+		indexerCommand.getIncludeFilters(),
+		indexerCommand.getWorkingDirectory(),
+		utility::concat(
+			indexerCommand.getCompilerFlags(),
+			{L"-fallow-pch-with-compiler-errors", L"-include", pch.inputFilePath.wstr()}));
 }
 
+std::shared_ptr<Task> createBuildImplicitPchTask(
+	const std::vector<ImplicitPch>& pchs,
+	const std::set<FilePath>& filesToIndex,
+	const FilePath& pchDirectoryPath,
+	std::shared_ptr<StorageProvider> storageProvider,
+	std::shared_ptr<DialogView> dialogView)
+{
+	// only the precompiled headers of groups with files to index are needed for this run
+	std::vector<ImplicitPch> usedPchs;
+	for (const ImplicitPch& pch: pchs)
+	{
+		for (const FilePath& sourceFilePath: pch.sourceFilePaths)
+		{
+			if (filesToIndex.find(sourceFilePath) != filesToIndex.end())
+			{
+				usedPchs.push_back(pch);
+				break;
+			}
+		}
+	}
+
+	if (usedPchs.empty() && !pchDirectoryPath.exists())
+	{
+		return std::make_shared<TaskLambda>([]() {});
+	}
+
+	std::set<FilePath> pchInputFilePaths;
+	for (const ImplicitPch& pch: pchs)
+	{
+		pchInputFilePaths.insert(pch.inputFilePath);
+	}
+
+	return std::make_shared<TaskLambda>([dialogView,
+										 storageProvider,
+										 usedPchs,
+										 pchInputFilePaths,
+										 pchDirectoryPath]() {
+		// prefix headers of groups that no longer exist are never used again
+		CxxImplicitPchPlanner::removeUnusedPchs(pchDirectoryPath, pchInputFilePaths);
+
+		if (usedPchs.empty())
+		{
+			return;
+		}
+
+		dialogView->showUnknownProgressDialog(
+			L"Preparing Indexing", L"Processing Precompiled Headers");
+
+		CxxParser::initializeLLVM();
+
+		if (!pchDirectoryPath.exists())
+		{
+			FileSystem::createDirectory(pchDirectoryPath);
+		}
+
+		for (const ImplicitPch& pch: usedPchs)
+		{
+			const FilePath pchOutputFilePath(pch.inputFilePath.wstr() + L".pch");
+			const std::shared_ptr<FileRegister> fileRegister = std::make_shared<FileRegister>(
+				pch.inputFilePath,
+				pch.pchCommand->getIndexedPaths(),
+				pch.pchCommand->getExcludeFilters());
+
+			if (!pch.inputFilePath.recheckExists())
+			{
+				std::ofstream fileStream;
+				fileStream.open(pch.inputFilePath.str());
+				fileStream << pch.inputFileContent;
+				fileStream.close();
+			}
+
+			// a precompiled header of a previous run is only preprocessed again, which records its
+			// files and macros for the storage without parsing and serializing its declarations
+			if (CxxImplicitPchPlanner::isPchUpToDate(pchOutputFilePath))
+			{
+				LOG_INFO(
+					L"Reusing implicit precompiled header at location \"" +
+					pchOutputFilePath.wstr() + L"\"");
+
+				buildPch(
+					pch.inputFilePath,
+					pch.pchCommand->getWorkingDirectory(),
+					utility::concat(
+						pch.pchCommand->getCompilerFlags(),
+						{pch.inputFilePath.wstr(), L"-fsyntax-only"}),
+					fileRegister,
+					storageProvider,
+					false);
+				continue;
+			}
+
+			LOG_INFO(
+				L"Generating implicit precompiled header at location \"" +
+				pchOutputFilePath.wstr() + L"\"");
+
+			// the driver must not pick up an outdated precompiled header if building it fails
+			FileSystem::remove(pchOutputFilePath);
+			FileSystem::remove(CxxImplicitPchPlanner::getPchInputsFilePath(pchOutputFilePath));
+
+			const std::shared_ptr<IntermediateStorage> storage = buildPch(
+				pch.inputFilePath,
+				pch.pchCommand->getWorkingDirectory(),
+				utility::concat(
+					pch.pchCommand->getCompilerFlags(),
+					{pch.inputFilePath.wstr(), L"-emit-pch", L"-o", pchOutputFilePath.wstr()}),
+				fileRegister,
+				storageProvider);
+
+			if (pchOutputFilePath.recheckExists())
+			{
+				writePchInputs(pchOutputFilePath, pch.inputFilePath, *storage);
+			}
+		}
+	});
+}
 std::shared_ptr<clang::tooling::JSONCompilationDatabase> loadCDB(
 	const FilePath& cdbPath, std::string* error)
 {
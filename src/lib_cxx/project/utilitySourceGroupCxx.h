@@ -2,9 +2,12 @@
 #define UTILITY_SOURCE_GROUP_CXX_H
 
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
+#include "FilePath.h"
+
 namespace clang
 {
 namespace tooling
@@ -14,19 +17,42 @@ class JSONCompilationDatabase;
 }	 // namespace clang
 
 class DialogView;
-class FilePath;
+class IndexerCommandCxx;
 class SourceGroupSettingsWithCxxPchOptions;
 class StorageProvider;
 class Task;
 
 namespace utility
 {
+struct ImplicitPch
+{
+	FilePath inputFilePath;
+	std::string inputFileContent;
+	std::shared_ptr<IndexerCommandCxx> pchCommand;
+	std::set<FilePath> sourceFilePaths;
+};
+
 std::shared_ptr<Task> createBuildPchTask(
 	const SourceGroupSettingsWithCxxPchOptions* settings,
 	std::vector<std::wstring> compilerFlags,
 	std::shared_ptr<StorageProvider> storageProvider,
 	std::shared_ptr<DialogView> dialogView);
 
+// Returns a prefix header to precompile for each group of commands whose source files start with
+// the same includes and share compiler flags. Only reads the source files, the prefix headers are
+// written by the task of createBuildImplicitPchTask.
+std::vector<ImplicitPch> getImplicitPchs(
+	const std::vector<std::shared_ptr<IndexerCommandCxx>>& indexerCommands,
+	const FilePath& pchDirectoryPath);
+std::shared_ptr<IndexerCommandCxx> getWithImplicitPchInclude(
+	const IndexerCommandCxx& indexerCommand, const ImplicitPch& pch);
+std::shared_ptr<Task> createBuildImplicitPchTask(
+	const std::vector<ImplicitPch>& pchs,
+	const std::set<FilePath>& filesToIndex,
+	const FilePath& pchDirectoryPath,
+	std::shared_ptr<StorageProvider> storageProvider,
+	std::shared_ptr<DialogView> dialogView);
+
 std::shared_ptr<clang::tooling::JSONCompilationDatabase> loadCDB(
 	const FilePath& cdbPath, std::string* error = nullptr);
 bool containsIncludePchFlags(std::shared_ptr<clang::tooling::JSONCompilationDatabase> cdb);
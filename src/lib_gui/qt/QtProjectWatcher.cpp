@@ -0,0 +1,159 @@
+#include "QtProjectWatcher.h"
+
+#include <limits>
+#include <vector>
+
+#include <QFile>
+#include <QSet>
+
+#include "Application.h"
+#include "MessageRefresh.h"
+#include "MessageStatus.h"
+#include "Project.h"
+#include "logging.h"
+
+QtProjectWatcher::QtProjectWatcher(int debounceMs, QObject* parent): QObject(parent)
+{
+	m_debounceTimer.setSingleShot(true);
+	m_debounceTimer.setInterval(debounceMs);
+
+	connect(&m_debounceTimer, &QTimer::timeout, this, &QtProjectWatcher::refresh);
+	connect(
+		&m_watcher,
+		&QFileSystemWatcher::directoryChanged,
+		this,
+		&QtProjectWatcher::fileSystemChanged);
+	connect(
+		&m_watcher, &QFileSystemWatcher::fileChanged, this, &QtProjectWatcher::fileSystemChanged);
+}
+
+void QtProjectWatcher::fileSystemChanged(const QString& path)
+{
+	LOG_INFO(L"File system change detected: " + path.toStdWString());
+
+	// every further change restarts the timer, so a burst of saves leads to a single refresh
+	m_debounceTimer.start();
+}
+
+void QtProjectWatcher::refresh()
+{
+	// changes detected while indexing are refreshed once indexing has finished
+	if (m_isIndexing)
+	{
+		m_refreshPending = true;
+		return;
+	}
+
+	MessageRefresh().dispatch();
+}
+
+void QtProjectWatcher::handleMessage(MessageIndexingFinished* message)
+{
+	std::set<FilePath> filePaths;
+	if (std::shared_ptr<const Project> project = Application::getInstance()->getCurrentProject())
+	{
+		filePaths = project->getFilePathsToWatch();
+	}
+
+	m_onQtThread([=]() {
+		setWatchedFiles(filePaths);
+
+		m_isIndexing = false;
+		if (m_refreshPending)
+		{
+			m_refreshPending = false;
+			m_debounceTimer.start();
+		}
+	});
+}
+
+void QtProjectWatcher::handleMessage(MessageIndexingStarted* message)
+{
+	m_onQtThread([=]() { m_isIndexing = true; });
+}
+
+void QtProjectWatcher::setWatchedFiles(const std::set<FilePath>& filePaths)
+{
+	// directories report added, removed and renamed files, modifications in place are only
+	// reported for the files themselves
+	std::set<FilePath> directoryPaths;
+	std::set<FilePath> existingFilePaths;
+	for (const FilePath& filePath: filePaths)
+	{
+		if (filePath.exists())
+		{
+			existingFilePaths.insert(filePath);
+			directoryPaths.insert(filePath.getParentDirectory());
+		}
+	}
+
+	// directories go first, so that new files are still noticed if not every file fits the limit
+	std::vector<FilePath> paths(directoryPaths.begin(), directoryPaths.end());
+	paths.insert(paths.end(), existingFilePaths.begin(), existingFilePaths.end());
+
+	const size_t watchLimit = getWatchLimit();
+	size_t skippedPathCount = 0;
+	if (paths.size() > watchLimit)
+	{
+		skippedPathCount = paths.size() - watchLimit;
+		paths.resize(watchLimit);
+	}
+
+	QSet<QString> watchedPaths;
+	for (const QString& watchedPath: m_watcher.files() + m_watcher.directories())
+	{
+		watchedPaths.insert(watchedPath);
+	}
+
+	QStringList addedPaths;
+	for (const FilePath& path: paths)
+	{
+		const QString qPath = QString::fromStdWString(path.wstr());
+		if (!watchedPaths.remove(qPath))
+		{
+			addedPaths.append(qPath);
+		}
+	}
+
+	if (!watchedPaths.isEmpty())
+	{
+		m_watcher.removePaths(watchedPaths.values());
+	}
+
+	if (!addedPaths.isEmpty())
+	{
+		skippedPathCount += m_watcher.addPaths(addedPaths).size();
+	}
+
+	if (skippedPathCount)
+	{
+		LOG_WARNING(
+			L"Unable to watch " + std::to_wstring(skippedPathCount) +
+			L" paths, changes to them are not refreshed. The limit of watched paths per user may "
+			L"need to be raised (fs.inotify.max_user_watches on Linux).");
+	}
+
+	MessageStatus(
+		L"Watching " + std::to_wstring(m_watcher.files().size()) + L" files in " +
+		std::to_wstring(m_watcher.directories().size()) + L" directories for changes.",
+		skippedPathCount > 0)
+		.dispatch();
+}
+
+size_t QtProjectWatcher::getWatchLimit()
+{
+#ifdef Q_OS_LINUX
+	// the limit is shared by all processes of the user, so some watches are left to the others
+	QFile file(QStringLiteral("/proc/sys/fs/inotify/max_user_watches"));
+	if (file.open(QIODevice::ReadOnly))
+	{
+		bool ok = false;
+		const qulonglong maxUserWatches = file.readAll().trimmed().toULongLong(&ok);
+		if (ok)
+		{
+			return static_cast<size_t>(maxUserWatches * 3 / 4);
+		}
+	}
+#endif
+	return std::numeric_limits<size_t>::max();
+}
@@ -0,0 +1,50 @@
+#ifndef QT_PROJECT_WATCHER_H
+#define QT_PROJECT_WATCHER_H
+
+#include <set>
+
+#include <QFileSystemWatcher>
+#include <QObject>
+#include <QTimer>
+
+#include "FilePath.h"
+#include "MessageIndexingFinished.h"
+#include "MessageIndexingStarted.h"
+#include "MessageListener.h"
+#include "QtThreadedFunctor.h"
+
+// Watches the indexed files of the loaded project and the directories containing them and triggers
+// an incremental refresh once changes settle down. Used by the headless "watch" command to keep the
+// index fresh.
+class QtProjectWatcher
+	: public QObject
+	, public MessageListener<MessageIndexingFinished>
+	, public MessageListener<MessageIndexingStarted>
+{
+	Q_OBJECT
+
+public:
+	QtProjectWatcher(int debounceMs, QObject* parent = nullptr);
+	virtual ~QtProjectWatcher() = default;
+
+private slots:
+	void fileSystemChanged(const QString& path);
+	void refresh();
+
+private:
+	void handleMessage(MessageIndexingFinished* message) override;
+	void handleMessage(MessageIndexingStarted* message) override;
+
+	void setWatchedFiles(const std::set<FilePath>& filePaths);
+	static size_t getWatchLimit();
+
+	QFileSystemWatcher m_watcher;
+	QTimer m_debounceTimer;
+
+	bool m_isIndexing = false;
+	bool m_refreshPending = false;
+
+	QtThreadedLambdaFunctor m_onQtThread;
+};
+
+#endif	  // QT_PROJECT_WATCHER_H
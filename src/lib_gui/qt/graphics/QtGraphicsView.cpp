@@ -685,7 +685,7 @@ QImage QtGraphicsView::toQImage()
 
 	QPainter painter(&image);
 	painter.setRenderHint(QPainter::Antialiasing);
-	scene()->render(&painter);
+	renderScene(&painter);
 
 	{
 		QFont font = painter.font();
@@ -738,7 +738,7 @@ void QtGraphicsView::exportGraph()
 		svgGen.setDescription(QStringLiteral("Graph exported from Sourcetrail") + QChar(0x00AE));
 
 		QPainter painter(&svgGen);
-		scene()->render(&painter);
+		renderScene(&painter);
 
 		{
 			QFont font(QStringLiteral("Fira Sans, sans-serif"));
@@ -834,6 +834,13 @@ bool QtGraphicsView::moves() const
 	return m_up || m_down || m_left || m_right;
 }
 
+void QtGraphicsView::renderScene(QPainter* painter)
+{
+	emit sceneRenderStarted();
+	scene()->render(painter);
+	emit sceneRenderFinished();
+}
+
 void QtGraphicsView::setZoomFactor(float zoomFactor)
 {
 	m_zoomFactor = zoomFactor;
@@ -854,6 +861,8 @@ void QtGraphicsView::updateTransform()
 {
 	float zoomFactor = m_appZoomFactor * m_zoomFactor;
 	setTransform(QTransform(zoomFactor, 0, 0, zoomFactor, 0, 0));
+
+	emit zoomed();
 }
 
 void QtGraphicsView::handleMessage(MessageSaveAsImage* message)
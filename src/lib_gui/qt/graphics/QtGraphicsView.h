@@ -61,6 +61,11 @@ protected:
 signals:
 	void emptySpaceClicked();
 	void resized();
+	void zoomed();
+
+	// sent around rendering the whole scene for an image, which needs all items at full detail
+	void sceneRenderStarted();
+	void sceneRenderFinished();
 
 	void focusIn();
 	void focusOut();
@@ -95,6 +100,8 @@ private slots:
 private:
 	bool moves() const;
 
+	void renderScene(QPainter* painter);
+
 	void setZoomFactor(float zoomFactor);
 	void updateTransform();
 
@@ -18,6 +18,17 @@ QtLineItemBase::QtLineItemBase(QGraphicsItem* parent)
 
 QtLineItemBase::~QtLineItemBase() {}
 
+QRectF QtLineItemBase::boundingRect() const
+{
+	// The scene asks for the bounding rect whenever it culls or indexes the item, so the shape
+	// of the line is only computed once per update.
+	if (m_boundingRect.isNull())
+	{
+		m_boundingRect = QGraphicsLineItem::boundingRect();
+	}
+	return m_boundingRect;
+}
+
 void QtLineItemBase::updateLine(
 	const Vec4i& ownerRect,
 	const Vec4i& targetRect,
@@ -29,6 +40,7 @@ void QtLineItemBase::updateLine(
 {
 	prepareGeometryChange();
 	m_polygon.clear();
+	m_boundingRect = QRectF();
 
 	m_ownerRect = ownerRect;
 	m_targetRect = targetRect;
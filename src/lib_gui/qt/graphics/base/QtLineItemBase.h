@@ -20,6 +20,8 @@ public:
 	QtLineItemBase(QGraphicsItem* parent);
 	virtual ~QtLineItemBase();
 
+	virtual QRectF boundingRect() const;
+
 	void updateLine(
 		const Vec4i& ownerRect,
 		const Vec4i& targetRect,
@@ -61,6 +63,7 @@ private:
 	Vec4i m_targetParentRect;
 
 	mutable QPolygon m_polygon;
+	mutable QRectF m_boundingRect;
 };
 
 #endif	  // QT_LINE_ITEM_BASE_H
@@ -2,6 +2,7 @@
 
 #include <QGraphicsDropShadowEffect>
 #include <QPainter>
+#include <QStyleOptionGraphicsItem>
 
 QtRoundedRectItem::QtRoundedRectItem(QGraphicsItem* parent)
 	: QGraphicsRectItem(parent), m_radius(0.0f)
@@ -18,6 +19,13 @@ void QtRoundedRectItem::paint(QPainter* painter, const QStyleOptionGraphicsItem*
 
 	painter->setRenderHint(QPainter::Antialiasing);
 
+	// rounded corners are not visible when they are smaller than a pixel
+	if (m_radius * options->levelOfDetailFromTransform(painter->worldTransform()) < 1.0)
+	{
+		painter->drawRect(this->rect());
+		return;
+	}
+
 	painter->drawRoundedRect(this->rect(), m_radius, m_radius);
 }
 
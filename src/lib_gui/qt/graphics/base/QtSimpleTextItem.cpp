@@ -0,0 +1,32 @@
+#include "QtSimpleTextItem.h"
+
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+
+namespace
+{
+const qreal s_minReadableLevelOfDetail = 0.4;
+}
+
+QtSimpleTextItem::QtSimpleTextItem(QGraphicsItem* parent): QGraphicsSimpleTextItem(parent) {}
+
+QtSimpleTextItem::~QtSimpleTextItem() {}
+
+void QtSimpleTextItem::paint(
+	QPainter* painter, const QStyleOptionGraphicsItem* options, QWidget* widget)
+{
+	const qreal levelOfDetail = options->levelOfDetailFromTransform(painter->worldTransform());
+	if (levelOfDetail >= s_minReadableLevelOfDetail)
+	{
+		QGraphicsSimpleTextItem::paint(painter, options, widget);
+		return;
+	}
+
+	QRectF rect = boundingRect();
+	rect.adjust(0, rect.height() / 4, 0, -rect.height() / 4);
+
+	QColor color = brush().color();
+	color.setAlphaF(color.alphaF() / 2);
+
+	painter->fillRect(rect, color);
+}
@@ -0,0 +1,17 @@
+#ifndef QT_SIMPLE_TEXT_ITEM_H
+#define QT_SIMPLE_TEXT_ITEM_H
+
+#include <QGraphicsSimpleTextItem>
+
+// Paints its text as a plain bar when the view is zoomed out too far to read it, which is a lot
+// cheaper than rendering the glyphs.
+class QtSimpleTextItem: public QGraphicsSimpleTextItem
+{
+public:
+	QtSimpleTextItem(QGraphicsItem* parent);
+	virtual ~QtSimpleTextItem();
+
+	virtual void paint(QPainter* painter, const QStyleOptionGraphicsItem* options, QWidget* widget);
+};
+
+#endif	  // QT_SIMPLE_TEXT_ITEM_H
@@ -0,0 +1,7 @@
+#include "QtSkipPaintEffect.h"
+
+QtSkipPaintEffect::QtSkipPaintEffect(QObject* parent): QGraphicsEffect(parent) {}
+
+QtSkipPaintEffect::~QtSkipPaintEffect() {}
+
+void QtSkipPaintEffect::draw(QPainter* painter) {}
@@ -0,0 +1,18 @@
+#ifndef QT_SKIP_PAINT_EFFECT_H
+#define QT_SKIP_PAINT_EFFECT_H
+
+#include <QGraphicsEffect>
+
+// Skips painting the item it is set on, including all of its children. Unlike a hidden item, the
+// item stays visible to the scene, so it is still hovered, clicked and found at a position.
+class QtSkipPaintEffect: public QGraphicsEffect
+{
+public:
+	QtSkipPaintEffect(QObject* parent = nullptr);
+	virtual ~QtSkipPaintEffect();
+
+protected:
+	virtual void draw(QPainter* painter);
+};
+
+#endif	  // QT_SKIP_PAINT_EFFECT_H
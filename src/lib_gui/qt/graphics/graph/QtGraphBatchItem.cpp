@@ -0,0 +1,94 @@
+#include "QtGraphBatchItem.h"
+
+#include <QPainter>
+
+#include "Edge.h"
+#include "GraphViewStyle.h"
+#include "QtGraphEdge.h"
+#include "QtGraphNode.h"
+
+QtGraphBatchItem::QtGraphBatchItem(): QGraphicsItem(nullptr)
+{
+	// mouse events go to the items below, which are not painted but still interactive
+	setAcceptedMouseButtons(Qt::NoButton);
+}
+
+QtGraphBatchItem::~QtGraphBatchItem() {}
+
+void QtGraphBatchItem::addNodeRecursive(const QtGraphNode* node, size_t depth)
+{
+	if (!node->isVisible())
+	{
+		return;
+	}
+
+	const QRectF rect = node->mapRectToScene(node->rect());
+	const QColor color = node->getFillColor();
+
+	if (color.alpha() > 0 && !rect.isEmpty())
+	{
+		if (m_rects.size() <= depth)
+		{
+			m_rects.resize(depth + 1);
+		}
+
+		m_rects[depth][color.rgba()].push_back(rect);
+		m_boundingRect |= rect;
+	}
+
+	for (const QtGraphNode* subNode: node->getSubNodes())
+	{
+		addNodeRecursive(subNode, depth + 1);
+	}
+}
+
+void QtGraphBatchItem::addEdge(QtGraphEdge* edge)
+{
+	if (!edge->isVisible())
+	{
+		return;
+	}
+
+	const QtGraphNode* owner = edge->getOwner();
+	const QtGraphNode* target = edge->getTarget();
+
+	const Edge::EdgeType type =
+		(edge->getData() ? edge->getData()->getType() : Edge::EDGE_BUNDLED_EDGES);
+	const GraphViewStyle::EdgeStyle style = GraphViewStyle::getStyleForEdgeType(
+		type, edge->getIsActive(), false, edge->isTrailEdge(), edge->isAmbiguous());
+	const QColor color(style.color.c_str());
+
+	m_lines[color.rgba()].push_back(QLineF(
+		owner->mapRectToScene(owner->rect()).center(),
+		target->mapRectToScene(target->rect()).center()));
+}
+
+QRectF QtGraphBatchItem::boundingRect() const
+{
+	return m_boundingRect;
+}
+
+void QtGraphBatchItem::paint(
+	QPainter* painter, const QStyleOptionGraphicsItem* options, QWidget* widget)
+{
+	// antialiasing is not visible at this zoom level, but makes each primitive a lot more expensive
+	painter->setRenderHint(QPainter::Antialiasing, false);
+
+	painter->setPen(Qt::NoPen);
+	for (const std::map<QRgb, std::vector<QRectF>>& rectsByColor: m_rects)
+	{
+		for (const std::pair<const QRgb, std::vector<QRectF>>& rects: rectsByColor)
+		{
+			painter->setBrush(QColor::fromRgba(rects.first));
+			painter->drawRects(rects.second.data(), static_cast<int>(rects.second.size()));
+		}
+	}
+
+	painter->setBrush(Qt::NoBrush);
+	for (const std::pair<const QRgb, std::vector<QLineF>>& lines: m_lines)
+	{
+		// a cosmetic pen keeps the lines one pixel wide at any zoom level
+		painter->setPen(QPen(QColor::fromRgba(lines.first), 0));
+		painter->drawLines(lines.second.data(), static_cast<int>(lines.second.size()));
+	}
+}
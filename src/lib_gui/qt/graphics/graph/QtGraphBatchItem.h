@@ -0,0 +1,38 @@
+#ifndef QT_GRAPH_BATCH_ITEM_H
+#define QT_GRAPH_BATCH_ITEM_H
+
+#include <map>
+#include <vector>
+
+#include <QColor>
+#include <QGraphicsItem>
+#include <QLineF>
+
+class QtGraphEdge;
+class QtGraphNode;
+
+// Paints the nodes of a graph as plain rects and its edges as straight lines, batched by color.
+// The graph view paints it instead of the node and edge items when it is zoomed out too far to
+// read them.
+class QtGraphBatchItem: public QGraphicsItem
+{
+public:
+	QtGraphBatchItem();
+	virtual ~QtGraphBatchItem();
+
+	// fill the item before adding it to the scene, its geometry changes without notification
+	void addNodeRecursive(const QtGraphNode* node, size_t depth = 0);
+	void addEdge(QtGraphEdge* edge);
+
+	virtual QRectF boundingRect() const;
+	virtual void paint(QPainter* painter, const QStyleOptionGraphicsItem* options, QWidget* widget);
+
+private:
+	// rects by color for each nesting depth, so sub nodes are painted above their parents
+	std::vector<std::map<QRgb, std::vector<QRectF>>> m_rects;
+	std::map<QRgb, std::vector<QLineF>> m_lines;
+
+	QRectF m_boundingRect;
+};
+
+#endif	  // QT_GRAPH_BATCH_ITEM_H
@@ -16,6 +16,7 @@
 #include "QtGraphNodeComponent.h"
 #include "QtGraphNodeExpandToggle.h"
 #include "QtRoundedRectItem.h"
+#include "QtSimpleTextItem.h"
 #include "ResourcePaths.h"
 #include "utilityQt.h"
 #include "utilityString.h"
@@ -64,7 +65,7 @@ QtGraphNode::QtGraphNode(GraphFocusHandler* focusHandler): m_focusHandler(focusH
 	this->setPen(QPen(Qt::transparent));
 	this->setCursor(Qt::PointingHandCursor);
 
-	m_text = new QGraphicsSimpleTextItem(this);
+	m_text = new QtSimpleTextItem(this);
 	m_rect = new QtRoundedRectItem(this);
 	m_undefinedRect = new QtRoundedRectItem(this);
 	m_undefinedRect->hide();
@@ -174,6 +175,11 @@ Vec4i QtGraphNode::getBoundingRect() const
 	return Vec4i(pos.x, pos.y, pos.x + size.x, pos.y + size.y);
 }
 
+QColor QtGraphNode::getFillColor() const
+{
+	return m_rect->brush().color();
+}
+
 void QtGraphNode::addOutEdge(QtGraphEdge* edge)
 {
 	m_outEdges.push_back(edge);
@@ -599,7 +605,7 @@ void QtGraphNode::matchName(const std::wstring& query, std::vector<QtGraphNode*>
 		if (!m_matchText)
 		{
 			m_matchRect = new QtRoundedRectItem(this);
-			m_matchText = new QGraphicsSimpleTextItem(this);
+			m_matchText = new QtSimpleTextItem(this);
 		}
 
 		m_matchRect->show();
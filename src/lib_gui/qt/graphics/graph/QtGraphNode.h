@@ -58,6 +58,8 @@ public:
 
 	Vec4i getBoundingRect() const;
 
+	QColor getFillColor() const;
+
 	void addOutEdge(QtGraphEdge* edge);
 	void addInEdge(QtGraphEdge* edge);
 
@@ -338,6 +338,19 @@ void QtProjectWizardContentPreferences::populate(QGridLayout* layout, int& row)
 		layout,
 		row);
 
+	// skip indexed headers
+	m_skipIndexedHeaders = addCheckBox(
+		QStringLiteral("Skip Indexed<br />C/C++ Headers"),
+		QStringLiteral("Index each header only once per set of compiler flags"),
+		QStringLiteral(
+			"<p>Skip include guarded project headers that were already indexed by another "
+			"translation unit with the same compiler flags.</p>"
+			"<p>This speeds up indexing of header heavy projects, but template instantiations and "
+			"code enabled by macros that only occur in the skipped translation units are not "
+			"recorded.</p>"),
+		layout,
+		row);
+
 	addGap(layout, row);
 
 
@@ -540,6 +553,7 @@ void QtProjectWizardContentPreferences::load()
 		appSettings->getIndexerThreadCount());	  // index and value are the same
 	indexerThreadsChanges(m_threads->currentIndex());
 	m_multiProcessIndexing->setChecked(appSettings->getMultiProcessIndexingEnabled());
+	m_skipIndexedHeaders->setChecked(appSettings->getSkipIndexedHeadersEnabled());
 
 	if (m_javaPath)
 	{
@@ -617,6 +631,7 @@ void QtProjectWizardContentPreferences::save()
 
 	appSettings->setIndexerThreadCount(m_threads->currentIndex());	  // index and value are the same
 	appSettings->setMultiProcessIndexingEnabled(m_multiProcessIndexing->isChecked());
+	appSettings->setSkipIndexedHeadersEnabled(m_skipIndexedHeaders->isChecked());
 
 	if (m_javaPath)
 	{
@@ -134,6 +134,7 @@ private:
 	QLabel* m_threadsInfoLabel;
 
 	QCheckBox* m_multiProcessIndexing;
+	QCheckBox* m_skipIndexedHeaders;
 
 	std::shared_ptr<CombinedPathDetector> m_javaPathDetector;
 	std::shared_ptr<CombinedPathDetector> m_jreSystemLibraryPathsDetector;
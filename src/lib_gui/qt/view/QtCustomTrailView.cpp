@@ -9,6 +9,7 @@
 #include <QLabel>
 #include <QRadioButton>
 #include <QSlider>
+#include <QSpinBox>
 
 #include "ColorScheme.h"
 #include "MessageActivateTrail.h"
@@ -105,6 +106,7 @@ QtCustomTrailView::QtCustomTrailView(ViewLayout* viewLayout)
 			QOverload<QAbstractButton*>::of(&QButtonGroup::buttonClicked),
 			[this, searchBoxToContainer](QAbstractButton* button) {
 				searchBoxToContainer->setEnabled(button == m_optionTo);
+				m_pathCountBox->setEnabled(button == m_optionTo);
 			});
 
 		connect(
@@ -157,6 +159,18 @@ QtCustomTrailView::QtCustomTrailView(ViewLayout* viewLayout)
 			}
 		});
 
+		hLayout->addSpacing(15);
+		hLayout->addWidget(new QLabel(QStringLiteral("Max Paths:")));
+
+		m_pathCountBox = new QSpinBox();
+		m_pathCountBox->setObjectName(QStringLiteral("path_count_box"));
+		m_pathCountBox->setToolTip(
+			QStringLiteral("number of shortest paths shown between the start and target symbol"));
+		m_pathCountBox->setRange(0, 50);
+		m_pathCountBox->setSpecialValueText(QStringLiteral("all shortest"));
+		m_pathCountBox->setValue(0);
+		hLayout->addWidget(m_pathCountBox);
+
 		hLayout->addStretch();
 	}
 
@@ -337,6 +351,7 @@ QtCustomTrailView::QtCustomTrailView(ViewLayout* viewLayout)
 				edgeTypes,
 				m_nodeNonIndexed->isChecked(),
 				m_slider->value() == m_slider->maximum() ? 0 : m_slider->value(),
+				m_pathCountBox->value(),
 				m_horizontalButton->isChecked());
 
 			m_controllerProxy.executeAsTaskWithArgs(&CustomTrailController::activateTrail, message);
@@ -12,6 +12,7 @@ class QCheckBox;
 class QHBoxLayout;
 class QLabel;
 class QSlider;
+class QSpinBox;
 class QRadioButton;
 class QtSmartSearchBox;
 class QVBoxLayout;
@@ -70,6 +71,7 @@ private:
 	QRadioButton* m_optionTo;
 
 	QSlider* m_slider;
+	QSpinBox* m_pathCountBox;
 
 	QRadioButton* m_horizontalButton;
 	QRadioButton* m_verticalButton;
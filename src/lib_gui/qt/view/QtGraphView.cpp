@@ -23,6 +23,7 @@
 #include "MessageRefreshUI.h"
 #include "MessageScrollGraph.h"
 #include "MessageStatus.h"
+#include "QtGraphBatchItem.h"
 #include "QtGraphEdge.h"
 #include "QtGraphNodeAccess.h"
 #include "QtGraphNodeBundle.h"
@@ -35,6 +36,7 @@
 #include "QtGraphNodeText.h"
 #include "QtGraphicsView.h"
 #include "QtSelfRefreshIconButton.h"
+#include "QtSkipPaintEffect.h"
 #include "QtViewWidgetWrapper.h"
 #include "ResourcePaths.h"
 #include "utilityQt.h"
@@ -67,6 +69,9 @@ QtGraphView::QtGraphView(ViewLayout* viewLayout)
 
 	connect(view, &QtGraphicsView::emptySpaceClicked, this, &QtGraphView::clickedInEmptySpace);
 	connect(view, &QtGraphicsView::resized, this, &QtGraphView::resized);
+	connect(view, &QtGraphicsView::zoomed, this, &QtGraphView::zoomed);
+	connect(view, &QtGraphicsView::sceneRenderStarted, [this]() { setBatched(false); });
+	connect(view, &QtGraphicsView::sceneRenderFinished, this, &QtGraphView::zoomed);
 	connect(view, &QtGraphicsView::focusIn, [this]() { setNavigationFocus(true); });
 	connect(view, &QtGraphicsView::focusOut, [this]() { setNavigationFocus(false); });
 
@@ -410,6 +415,8 @@ void QtGraphView::rebuildGraph(
 			}
 		}
 
+		m_nodesByTokenId.clear();
+
 		// focus previously focused node
 		if (params.tokenIdToFocus)
 		{
@@ -429,7 +436,7 @@ void QtGraphView::rebuildGraph(
 		m_isIndexedList = params.isIndexedList;
 
 		if (params.animatedTransition && ApplicationSettings::getInstance()->getUseAnimations() &&
-			view->isVisible())
+			view->isVisible() && !m_isBatched)
 		{
 			createTransition();
 		}
@@ -470,6 +477,9 @@ void QtGraphView::clear()
 		m_matchedNodes.clear();
 
 		getView()->scene()->clear();
+
+		m_batchItem = nullptr;
+		m_isBatched = false;
 	});
 }
 
@@ -756,6 +766,16 @@ void QtGraphView::resized()
 	doResize();
 }
 
+void QtGraphView::zoomed()
+{
+	if (isTransitioning())
+	{
+		return;
+	}
+
+	updateBatching();
+}
+
 void QtGraphView::trailDepthChanged(int)
 {
 	if (m_trailDepthSlider->value() == m_trailDepthSlider->maximum())
@@ -961,7 +981,13 @@ void QtGraphView::switchToNewGraphData()
 	m_nodes.clear();
 	m_edges.clear();
 
+	// the new items are all shown
+	delete m_batchItem;
+	m_batchItem = nullptr;
+	m_isBatched = false;
+
 	doResize();
+	updateBatching();
 
 	if (m_scrollToTop || m_restoreScroll)
 	{
@@ -1021,6 +1047,59 @@ void QtGraphView::doResize()
 	getView()->setSceneRect(getSceneRect(m_oldNodes));
 }
 
+void QtGraphView::updateBatching()
+{
+	// below this zoom factor node names are painted as bars and the graph is only an overview
+	static const float BATCHED_ZOOM_FACTOR = 0.25f;
+
+	setBatched(getView()->getZoomFactor() < BATCHED_ZOOM_FACTOR);
+}
+
+void QtGraphView::setBatched(bool batched)
+{
+	if (batched == m_isBatched)
+	{
+		return;
+	}
+
+	m_isBatched = batched;
+
+	// The batch item is filled from the displayed items while they are shown. It is recreated each
+	// time, because nodes may have been moved or restyled in between.
+	delete m_batchItem;
+	m_batchItem = nullptr;
+
+	if (batched)
+	{
+		m_batchItem = new QtGraphBatchItem();
+
+		for (QtGraphNode* node: m_oldNodes)
+		{
+			m_batchItem->addNodeRecursive(node);
+		}
+
+		for (QtGraphEdge* edge: m_oldEdges)
+		{
+			m_batchItem->addEdge(edge);
+		}
+
+		getView()->scene()->addItem(m_batchItem);
+	}
+
+	// Painting the items is most of the cost of huge graphs, so it is skipped. The items are not
+	// hidden or made transparent, so they stay interactive and keep their own visibility. Removing
+	// the effect deletes it.
+	for (QtGraphNode* node: m_oldNodes)
+	{
+		node->setGraphicsEffect(batched ? new QtSkipPaintEffect() : nullptr);
+	}
+
+	for (QtGraphEdge* edge: m_oldEdges)
+	{
+		edge->setGraphicsEffect(batched ? new QtSkipPaintEffect() : nullptr);
+	}
+}
+
 QtGraphNode* QtGraphView::createNodeRecursive(
 	QGraphicsView* view,
 	QtGraphNode* parentNode,
@@ -1113,6 +1192,9 @@ QtGraphNode* QtGraphView::createNodeRecursive(
 		m_activeNodes.push_back(newNode);
 	}
 
+	// keep the first node of a token id, like QtGraphNode::findNodeRecursive does
+	m_nodesByTokenId.emplace(newNode->getTokenId(), newNode);
+
 	for (unsigned int i = 0; i < node->subNodes.size(); i++)
 	{
 		QtGraphNode* subNode = createNodeRecursive(
@@ -1142,11 +1224,14 @@ QtGraphEdge* QtGraphView::createEdge(
 		return nullptr;
 	}
 
-	QtGraphNode* owner = QtGraphNode::findNodeRecursive(m_nodes, edge->ownerId);
-	QtGraphNode* target = QtGraphNode::findNodeRecursive(m_nodes, edge->targetId);
+	auto ownerIt = m_nodesByTokenId.find(edge->ownerId);
+	auto targetIt = m_nodesByTokenId.find(edge->targetId);
 
-	if (owner != nullptr && target != nullptr)
+	if (ownerIt != m_nodesByTokenId.end() && targetIt != m_nodesByTokenId.end())
 	{
+		QtGraphNode* owner = ownerIt->second;
+		QtGraphNode* target = targetIt->second;
+
 		QtGraphEdge* qtEdge = new QtGraphEdge(
 			&m_focusHandler,
 			owner,
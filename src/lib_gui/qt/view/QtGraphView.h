@@ -1,6 +1,7 @@
 #ifndef QT_GRAPH_VIEW_H
 #define QT_GRAPH_VIEW_H
 
+#include <map>
 #include <set>
 
 #include <QGraphicsView>
@@ -21,6 +22,7 @@ class QMouseEvent;
 class QPushButton;
 class QSequentialAnimationGroup;
 class QSlider;
+class QtGraphBatchItem;
 class QtGraphEdge;
 class QtGraphicsView;
 class QtGraphNode;
@@ -88,6 +90,7 @@ private slots:
 
 	void scrolled(int);
 	void resized();
+	void zoomed();
 
 	void trailDepthChanged(int);
 	void trailDepthUpdated();
@@ -114,6 +117,9 @@ private:
 
 	void doResize();
 
+	void updateBatching();
+	void setBatched(bool batched);
+
 	QtGraphNode* createNodeRecursive(
 		QGraphicsView* view,
 		QtGraphNode* parentNode,
@@ -160,6 +166,9 @@ private:
 	std::list<QtGraphNode*> m_nodes;
 	std::list<QtGraphNode*> m_oldNodes;
 
+	// nodes by token id for connecting the edges while the graph gets built
+	std::map<Id, QtGraphNode*> m_nodesByTokenId;
+
 	std::vector<QtGraphNode*> m_activeNodes;
 	QtGraphNode* m_oldActiveNode = nullptr;
 
@@ -190,6 +199,10 @@ private:
 
 	std::vector<QRectF> m_virtualNodeRects;
 
+	// paints the displayed graph instead of its items when zoomed out far
+	QtGraphBatchItem* m_batchItem = nullptr;
+	bool m_isBatched = false;
+
 	// Name matches
 	std::vector<QtGraphNode*> m_matchedNodes;
 };
@@ -98,5 +98,38 @@ TEST_CASE("command line")
 		REQUIRE(processes == true);
 	}
 
+	SECTION("command watch debounce option")
+	{
+		std::vector<std::string> args({"watch", "--debounce", "250", "missing.srctrlprj"});
+
+		commandline::CommandLineParser parser("2");
+		parser.preparse(args);
+		parser.parse();
+
+		REQUIRE(parser.runWithoutGUI());
+		REQUIRE(!parser.exitApplication());
+		REQUIRE(parser.getWatchRequested());
+		REQUIRE(parser.getWatchDebounceMs() == 250);
+		REQUIRE(parser.getRefreshMode() == REFRESH_UPDATED_FILES);
+	}
+
+	SECTION("command metrics options")
+	{
+		std::vector<std::string> args(
+			{"metrics", "--calls", "--top", "5", "-o", "metrics.json", "missing.srctrlprj"});
+
+		commandline::CommandLineParser parser("2");
+		parser.preparse(args);
+		parser.parse();
+
+		REQUIRE(parser.runWithoutGUI());
+		REQUIRE(!parser.exitApplication());
+		REQUIRE(parser.getMetricsRequested());
+		REQUIRE(parser.getMetricsTopCount() == 5);
+		REQUIRE(parser.getMetricsCallsOnly());
+		REQUIRE(parser.getMetricsOutputFilePath().wstr() == L"metrics.json");
+		REQUIRE(!parser.getWatchRequested());
+	}
+
 	ApplicationSettings::getInstance()->load(appSettingsPath);
 }
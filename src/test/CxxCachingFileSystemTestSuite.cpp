@@ -0,0 +1,138 @@
+#include "catch.hpp"
+
+#include "language_packages.h"
+
+#if BUILD_CXX_LANGUAGE_PACKAGE
+
+#	include <llvm/Support/MemoryBuffer.h>
+
+#	include "CxxCachingFileSystem.h"
+
+namespace
+{
+// counts the lookups that reach the file system below the cache
+class CountingFileSystem: public llvm::vfs::ProxyFileSystem
+{
+public:
+	CountingFileSystem(llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem)
+		: llvm::vfs::ProxyFileSystem(fileSystem)
+	{
+	}
+
+	llvm::ErrorOr<llvm::vfs::Status> status(const llvm::Twine& path) override
+	{
+		statusCount++;
+		return ProxyFileSystem::status(path);
+	}
+
+	llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>> openFileForRead(
+		const llvm::Twine& path) override
+	{
+		openCount++;
+		return ProxyFileSystem::openFileForRead(path);
+	}
+
+	size_t statusCount = 0;
+	size_t openCount = 0;
+};
+
+void addFile(
+	llvm::vfs::InMemoryFileSystem& fileSystem, const std::string& path, const std::string& content)
+{
+	fileSystem.addFile(path, 0, llvm::MemoryBuffer::getMemBufferCopy(content));
+}
+
+std::string readFile(llvm::vfs::FileSystem& fileSystem, const std::string& path)
+{
+	llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>> file = fileSystem.openFileForRead(path);
+	REQUIRE(file);
+
+	llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer = (*file)->getBuffer(path);
+	REQUIRE(buffer);
+	return (*buffer)->getBuffer().str();
+}
+}	 // namespace
+
+TEST_CASE("caching file system reuses status of existing files")
+{
+	llvm::IntrusiveRefCntPtr<llvm::vfs::InMemoryFileSystem> memoryFileSystem =
+		new llvm::vfs::InMemoryFileSystem();
+	addFile(*memoryFileSystem, "/include/a.h", "int a;");
+
+	llvm::IntrusiveRefCntPtr<CountingFileSystem> countingFileSystem = new CountingFileSystem(
+		memoryFileSystem);
+	CxxCachingFileSystem fileSystem(countingFileSystem, 1024);
+
+	REQUIRE(fileSystem.status("/include/a.h"));
+	fileSystem.clearFailedLookups();
+	llvm::ErrorOr<llvm::vfs::Status> status = fileSystem.status("/include/a.h");
+
+	REQUIRE(status);
+	REQUIRE(status->getSize() == 6);
+	REQUIRE(countingFileSystem->statusCount == 1);
+}
+
+TEST_CASE("caching file system caches content of files opened twice")
+{
+	llvm::IntrusiveRefCntPtr<llvm::vfs::InMemoryFileSystem> memoryFileSystem =
+		new llvm::vfs::InMemoryFileSystem();
+	addFile(*memoryFileSystem, "/include/a.h", "int a;");
+
+	llvm::IntrusiveRefCntPtr<CountingFileSystem> countingFileSystem = new CountingFileSystem(
+		memoryFileSystem);
+	CxxCachingFileSystem fileSystem(countingFileSystem, 1024);
+
+	REQUIRE(readFile(fileSystem, "/include/a.h") == "int a;");
+	REQUIRE(fileSystem.getCachedByteSize() == 0);
+
+	REQUIRE(readFile(fileSystem, "/include/a.h") == "int a;");
+	REQUIRE(readFile(fileSystem, "/include/a.h") == "int a;");
+
+	REQUIRE(countingFileSystem->openCount == 2);
+	REQUIRE(fileSystem.getCachedByteSize() == 6);
+}
+
+TEST_CASE("caching file system does not cache content beyond its maximum size")
+{
+	llvm::IntrusiveRefCntPtr<llvm::vfs::InMemoryFileSystem> memoryFileSystem =
+		new llvm::vfs::InMemoryFileSystem();
+	addFile(*memoryFileSystem, "/include/a.h", "int a;");
+	addFile(*memoryFileSystem, "/include/b.h", "int b;");
+
+	llvm::IntrusiveRefCntPtr<CountingFileSystem> countingFileSystem = new CountingFileSystem(
+		memoryFileSystem);
+	CxxCachingFileSystem fileSystem(countingFileSystem, 10);
+
+	for (size_t i = 0; i < 3; i++)
+	{
+		REQUIRE(readFile(fileSystem, "/include/a.h") == "int a;");
+		REQUIRE(readFile(fileSystem, "/include/b.h") == "int b;");
+	}
+
+	REQUIRE(fileSystem.getCachedByteSize() == 6);
+	REQUIRE(countingFileSystem->openCount == 2 + 3);
+}
+
+TEST_CASE("caching file system forgets missing files for the next translation unit")
+{
+	llvm::IntrusiveRefCntPtr<llvm::vfs::InMemoryFileSystem> memoryFileSystem =
+		new llvm::vfs::InMemoryFileSystem();
+
+	llvm::IntrusiveRefCntPtr<CountingFileSystem> countingFileSystem = new CountingFileSystem(
+		memoryFileSystem);
+	CxxCachingFileSystem fileSystem(countingFileSystem, 1024);
+
+	REQUIRE(!fileSystem.status("/include/generated.h"));
+	REQUIRE(!fileSystem.openFileForRead("/include/generated.h"));
+	REQUIRE(countingFileSystem->statusCount == 1);
+	REQUIRE(countingFileSystem->openCount == 0);
+
+	addFile(*memoryFileSystem, "/include/generated.h", "int g;");
+	REQUIRE(!fileSystem.status("/include/generated.h"));
+
+	fileSystem.clearFailedLookups();
+	REQUIRE(fileSystem.status("/include/generated.h"));
+	REQUIRE(readFile(fileSystem, "/include/generated.h") == "int g;");
+}
+
+#endif	  // BUILD_CXX_LANGUAGE_PACKAGE
@@ -0,0 +1,367 @@
+#include "catch.hpp"
+
+#include "language_packages.h"
+
+#if BUILD_CXX_LANGUAGE_PACKAGE
+
+#	include <fstream>
+
+#	include <boost/filesystem.hpp>
+
+#	include "Blackboard.h"
+#	include "CxxImplicitPchPlanner.h"
+#	include "CxxParser.h"
+#	include "DialogView.h"
+#	include "FileSystem.h"
+#	include "IndexerCommandCxx.h"
+#	include "IndexerStateInfo.h"
+#	include "IntermediateStorage.h"
+#	include "ParserClientImpl.h"
+#	include "StorageProvider.h"
+#	include "Task.h"
+#	include "utilitySourceGroupCxx.h"
+
+#	include "TestFileRegister.h"
+
+namespace
+{
+CxxImplicitPchPlanner::Include include(const std::string& spelling, const std::wstring& filePath)
+{
+	CxxImplicitPchPlanner::Include include;
+	include.spelling = spelling;
+	include.filePath = FilePath(filePath);
+	return include;
+}
+
+std::vector<CxxImplicitPchPlanner::Include> includes(const std::vector<std::string>& spellings)
+{
+	std::vector<CxxImplicitPchPlanner::Include> includes;
+	for (const std::string& spelling: spellings)
+	{
+		includes.push_back(include(
+			spelling, L"/usr/include/" + std::wstring(spelling.begin() + 1, spelling.end() - 1)));
+	}
+	return includes;
+}
+
+bool isGuarded(const FilePath& filePath)
+{
+	return filePath.fileName() != L"unguarded.h";
+}
+
+const FilePath s_pchDirectoryPath(L"data/CxxImplicitPchPlannerTestSuite/pch/");
+
+void writeFile(const FilePath& filePath, const std::string& content)
+{
+	std::ofstream fileStream;
+	fileStream.open(filePath.str());
+	fileStream << content;
+	fileStream.close();
+}
+
+// changes the modification time like "touch" without changing the content
+void touchFile(const FilePath& filePath)
+{
+	boost::filesystem::last_write_time(
+		filePath.getPath(), boost::filesystem::last_write_time(filePath.getPath()) + 10);
+}
+
+void cleanup()
+{
+	if (s_pchDirectoryPath.recheckExists())
+	{
+		for (const FilePath& filePath: FileSystem::getFilePathsFromDirectory(s_pchDirectoryPath))
+		{
+			FileSystem::remove(filePath);
+		}
+		FileSystem::remove(s_pchDirectoryPath);
+	}
+	FileSystem::createDirectory(s_pchDirectoryPath);
+}
+}	 // namespace
+
+TEST_CASE("implicit pch planner finds leading directives")
+{
+	const std::vector<std::string> directives = CxxImplicitPchPlanner::getLeadingDirectives(
+		{"// line comment",
+		 "",
+		 "/* block comment",
+		 "   spanning lines */",
+		 "#include <a.h>",
+		 "  #  include \"b.h\" // trailing comment",
+		 "/* comment */ #define A",
+		 "int a;",
+		 "#include <c.h>"});
+
+	REQUIRE(directives.size() == 3);
+	REQUIRE(directives[0] == "include <a.h>");
+	REQUIRE(directives[1] == "include \"b.h\" // trailing comment");
+	REQUIRE(directives[2] == "define A");
+}
+
+TEST_CASE("implicit pch planner stops leading directives at code after comment")
+{
+	const std::vector<std::string> directives = CxxImplicitPchPlanner::getLeadingDirectives(
+		{"#include <a.h>", "/* comment */ int a;", "#include <b.h>"});
+
+	REQUIRE(directives.size() == 1);
+	REQUIRE(directives[0] == "include <a.h>");
+}
+
+TEST_CASE("implicit pch planner detects include guards")
+{
+	REQUIRE(CxxImplicitPchPlanner::isIncludeGuarded({"pragma once"}));
+	REQUIRE(CxxImplicitPchPlanner::isIncludeGuarded({"ifndef A_H", "define A_H"}));
+	REQUIRE(CxxImplicitPchPlanner::isIncludeGuarded({"ifndef A_H", "define A_H 1"}));
+
+	REQUIRE(!CxxImplicitPchPlanner::isIncludeGuarded({}));
+	REQUIRE(!CxxImplicitPchPlanner::isIncludeGuarded({"pragma pack(1)"}));
+	REQUIRE(!CxxImplicitPchPlanner::isIncludeGuarded({"ifndef A_H", "define B_H"}));
+	REQUIRE(!CxxImplicitPchPlanner::isIncludeGuarded({"ifndef A_H"}));
+	REQUIRE(!CxxImplicitPchPlanner::isIncludeGuarded({"include <a.h>", "pragma once"}));
+}
+
+TEST_CASE("implicit pch planner resolves leading includes")
+{
+	const FilePath sourceDirectoryPath(L"data/CxxImplicitPchPlannerTestSuite/");
+	const FilePath searchDirectoryPath(L"data/CxxImplicitPchPlannerTestSuite/include/");
+
+	const std::vector<CxxImplicitPchPlanner::Include> leadingIncludes =
+		CxxImplicitPchPlanner::getLeadingIncludes(
+			{"include \"local.h\"",
+			 "include <system.h> // comment",
+			 "include <missing.h>",
+			 "include <code.h> int a;",
+			 "include <after.h>"},
+			sourceDirectoryPath,
+			{searchDirectoryPath});
+
+	REQUIRE(leadingIncludes.size() == 3);
+
+	const FilePath localFilePath = sourceDirectoryPath.getConcatenated(L"local.h").makeAbsolute();
+	REQUIRE(leadingIncludes[0].spelling == '"' + localFilePath.str() + '"');
+	REQUIRE(leadingIncludes[0].filePath == localFilePath);
+
+	REQUIRE(leadingIncludes[1].spelling == "<system.h>");
+	REQUIRE(
+		leadingIncludes[1].filePath ==
+		searchDirectoryPath.getConcatenated(L"system.h").makeAbsolute());
+
+	REQUIRE(leadingIncludes[2].spelling == "<missing.h>");
+	REQUIRE(leadingIncludes[2].filePath.empty());
+}
+
+TEST_CASE("implicit pch planner groups translation units with shared include prefix")
+{
+	CxxImplicitPchPlanner planner(3);
+	planner.addTranslationUnit(L"c++", includes({"<a.h>", "<b.h>", "<c.h>"}));
+	planner.addTranslationUnit(L"c++", includes({"<x.h>"}));
+	planner.addTranslationUnit(L"c++", includes({"<a.h>", "<b.h>"}));
+	planner.addTranslationUnit(L"c++", includes({"<a.h>", "<b.h>", "<d.h>"}));
+
+	const std::vector<CxxImplicitPchPlanner::Group> groups = planner.getGroups(isGuarded);
+
+	REQUIRE(groups.size() == 1);
+	REQUIRE(groups[0].prefix.size() == 2);
+	REQUIRE(groups[0].prefix[0].spelling == "<a.h>");
+	REQUIRE(groups[0].prefix[1].spelling == "<b.h>");
+	REQUIRE(groups[0].translationUnitIndices == std::vector<size_t>({0, 2, 3}));
+	REQUIRE(
+		CxxImplicitPchPlanner::getPrefixHeaderContent(groups[0].prefix) ==
+		"#include <a.h>\n#include <b.h>\n");
+}
+
+TEST_CASE("implicit pch planner skips groups below minimum translation unit count")
+{
+	CxxImplicitPchPlanner planner(3);
+	planner.addTranslationUnit(L"c++", includes({"<a.h>"}));
+	planner.addTranslationUnit(L"c++", includes({"<a.h>"}));
+	planner.addTranslationUnit(L"c++", {});
+
+	REQUIRE(planner.getGroups(isGuarded).empty());
+}
+
+TEST_CASE("implicit pch planner does not group translation units with different keys")
+{
+	CxxImplicitPchPlanner planner(2);
+	planner.addTranslationUnit(L"c++", includes({"<a.h>"}));
+	planner.addTranslationUnit(L"c", includes({"<a.h>"}));
+	planner.addTranslationUnit(L"c++", includes({"<a.h>"}));
+	planner.addTranslationUnit(L"c", includes({"<b.h>"}));
+
+	const std::vector<CxxImplicitPchPlanner::Group> groups = planner.getGroups(isGuarded);
+
+	REQUIRE(groups.size() == 1);
+	REQUIRE(groups[0].translationUnitIndices == std::vector<size_t>({0, 2}));
+}
+
+TEST_CASE("implicit pch planner ends prefix before header without include guard")
+{
+	CxxImplicitPchPlanner planner(2);
+	planner.addTranslationUnit(
+		L"c++",
+		{include("<a.h>", L""), include("<b.h>", L"/b.h"), include("<u.h>", L"/unguarded.h")});
+	planner.addTranslationUnit(
+		L"c++",
+		{include("<a.h>", L""), include("<b.h>", L"/b.h"), include("<u.h>", L"/unguarded.h")});
+	planner.addTranslationUnit(L"c", {include("<u.h>", L"/unguarded.h")});
+	planner.addTranslationUnit(L"c", {include("<u.h>", L"/unguarded.h")});
+
+	const std::vector<CxxImplicitPchPlanner::Group> groups = planner.getGroups(isGuarded);
+
+	REQUIRE(groups.size() == 1);
+	REQUIRE(groups[0].prefix.size() == 2);
+	REQUIRE(groups[0].prefix[1].spelling == "<b.h>");
+}
+
+TEST_CASE("implicit pch planner rebuilds precompiled header after prefix header was edited")
+{
+	cleanup();
+	{
+		const FilePath prefixHeaderFilePath = s_pchDirectoryPath.getConcatenated(L"prefix.h");
+		const FilePath pchOutputFilePath = s_pchDirectoryPath.getConcatenated(L"prefix.h.pch");
+		writeFile(prefixHeaderFilePath, "#include <a.h>\n");
+		writeFile(pchOutputFilePath, "pch");
+
+		REQUIRE(!CxxImplicitPchPlanner::isPchUpToDate(pchOutputFilePath));
+
+		CxxImplicitPchPlanner::writePchInputs(pchOutputFilePath, {prefixHeaderFilePath});
+		REQUIRE(CxxImplicitPchPlanner::isPchUpToDate(pchOutputFilePath));
+
+		// same size and usually within the same second as the first version
+		writeFile(prefixHeaderFilePath, "#include <b.h>\n");
+		REQUIRE(!CxxImplicitPchPlanner::isPchUpToDate(pchOutputFilePath));
+
+		CxxImplicitPchPlanner::writePchInputs(pchOutputFilePath, {prefixHeaderFilePath});
+		REQUIRE(CxxImplicitPchPlanner::isPchUpToDate(pchOutputFilePath));
+
+		FileSystem::remove(prefixHeaderFilePath);
+		REQUIRE(!CxxImplicitPchPlanner::isPchUpToDate(pchOutputFilePath));
+	}
+	cleanup();
+}
+
+TEST_CASE("implicit pch planner rebuilds precompiled header after input file was touched")
+{
+	cleanup();
+	{
+		const FilePath headerFilePath = s_pchDirectoryPath.getConcatenated(L"header.h");
+		const FilePath pchOutputFilePath = s_pchDirectoryPath.getConcatenated(L"prefix.h.pch");
+		writeFile(headerFilePath, "#pragma once\n");
+		writeFile(pchOutputFilePath, "pch");
+
+		CxxImplicitPchPlanner::writePchInputs(pchOutputFilePath, {headerFilePath});
+		REQUIRE(CxxImplicitPchPlanner::isPchUpToDate(pchOutputFilePath));
+
+		// clang rejects the precompiled header even though the content is the same
+		touchFile(headerFilePath);
+		REQUIRE(!CxxImplicitPchPlanner::isPchUpToDate(pchOutputFilePath));
+	}
+	cleanup();
+}
+
+TEST_CASE("implicit precompiled header is rebuilt for indexing after a header was touched")
+{
+	cleanup();
+	const FilePath sourceDirectoryPath = FilePath(L"data/CxxImplicitPchPlannerTestSuite/touched/")
+											 .makeAbsolute();
+	FileSystem::createDirectory(sourceDirectoryPath);
+	{
+		const FilePath headerFilePath = sourceDirectoryPath.getConcatenated(L"header.h");
+		writeFile(headerFilePath, "#pragma once\nint a;\n");
+
+		std::vector<std::shared_ptr<IndexerCommandCxx>> indexerCommands;
+		std::set<FilePath> sourceFilePaths;
+		for (const std::wstring fileName: {L"a.cpp", L"b.cpp", L"c.cpp", L"d.cpp"})
+		{
+			const FilePath sourceFilePath = sourceDirectoryPath.getConcatenated(fileName);
+			writeFile(sourceFilePath, "#include \"header.h\"\nint f() { return a; }\n");
+			sourceFilePaths.insert(sourceFilePath);
+
+			indexerCommands.push_back(std::make_shared<IndexerCommandCxx>(
+				sourceFilePath,
+				std::set<FilePath> {sourceDirectoryPath},
+				std::set<FilePathFilter>(),
+				std::set<FilePathFilter>(),
+				sourceDirectoryPath,
+				std::vector<std::wstring> {L"-std=c++1z", sourceFilePath.wstr()}));
+		}
+
+		const std::vector<utility::ImplicitPch> pchs = utility::getImplicitPchs(
+			indexerCommands, s_pchDirectoryPath.makeAbsolute());
+		REQUIRE(pchs.size() == 1);
+
+		// builds or reuses the precompiled header and indexes all files with it
+		auto index = [&]() {
+			std::shared_ptr<StorageProvider> storageProvider = std::make_shared<StorageProvider>();
+			utility::createBuildImplicitPchTask(
+				pchs,
+				sourceFilePaths,
+				s_pchDirectoryPath.makeAbsolute(),
+				storageProvider,
+				std::make_shared<DialogView>(DialogView::UseCase::INDEXING, nullptr))
+				->update(std::make_shared<Blackboard>());
+
+			size_t fatalErrorCount = 0;
+			for (const std::shared_ptr<IndexerCommandCxx>& indexerCommand: indexerCommands)
+			{
+				std::shared_ptr<IntermediateStorage> storage =
+					std::make_shared<IntermediateStorage>();
+				CxxParser parser(
+					std::make_shared<ParserClientImpl>(storage.get()),
+					std::make_shared<TestFileRegister>(),
+					std::make_shared<IndexerStateInfo>());
+				parser.buildIndex(
+					utility::getWithImplicitPchInclude(*indexerCommand, pchs.front()));
+
+				for (const StorageError& error: storage->getErrors())
+				{
+					fatalErrorCount += error.fatal ? 1 : 0;
+				}
+			}
+			return fatalErrorCount;
+		};
+
+		REQUIRE(index() == 0);
+		REQUIRE(CxxImplicitPchPlanner::isPchUpToDate(
+			FilePath(pchs.front().inputFilePath.wstr() + L".pch")));
+
+		touchFile(headerFilePath);
+		REQUIRE(index() == 0);
+	}
+	for (const FilePath& filePath: FileSystem::getFilePathsFromDirectory(sourceDirectoryPath))
+	{
+		FileSystem::remove(filePath);
+	}
+	FileSystem::remove(sourceDirectoryPath);
+	cleanup();
+}
+
+TEST_CASE("implicit pch planner removes precompiled headers of removed groups")
+{
+	cleanup();
+	{
+		const FilePath usedFilePath = s_pchDirectoryPath.getConcatenated(L"used.h");
+		const FilePath unusedFilePath = s_pchDirectoryPath.getConcatenated(L"unused.h");
+		for (const FilePath& filePath: {usedFilePath, unusedFilePath})
+		{
+			writeFile(filePath, "#include <a.h>\n");
+			writeFile(FilePath(filePath.wstr() + L".pch"), "pch");
+			CxxImplicitPchPlanner::writePchInputs(FilePath(filePath.wstr() + L".pch"), {filePath});
+		}
+
+		// an up to date precompiled header is removed as well if its group is gone
+		REQUIRE(CxxImplicitPchPlanner::isPchUpToDate(FilePath(unusedFilePath.wstr() + L".pch")));
+
+		CxxImplicitPchPlanner::removeUnusedPchs(s_pchDirectoryPath, {usedFilePath});
+
+		REQUIRE(FileSystem::getFilePathsFromDirectory(s_pchDirectoryPath).size() == 3);
+		REQUIRE(CxxImplicitPchPlanner::isPchUpToDate(FilePath(usedFilePath.wstr() + L".pch")));
+		REQUIRE(!unusedFilePath.recheckExists());
+		REQUIRE(!FilePath(unusedFilePath.wstr() + L".pch").recheckExists());
+		REQUIRE(!FilePath(unusedFilePath.wstr() + L".pch.inputs").recheckExists());
+	}
+	cleanup();
+}
+
+#endif	  // BUILD_CXX_LANGUAGE_PACKAGE
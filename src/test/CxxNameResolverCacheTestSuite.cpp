@@ -0,0 +1,133 @@
+#include "catch.hpp"
+
+#include "language_packages.h"
+
+#if BUILD_CXX_LANGUAGE_PACKAGE
+
+#	include <clang/Frontend/ASTUnit.h>
+#	include <clang/Tooling/Tooling.h>
+
+#	include "CxxDeclName.h"
+#	include "CxxDeclNameResolver.h"
+#	include "CxxNameResolverCache.h"
+#	include "CxxTypeNameResolver.h"
+
+namespace
+{
+template <typename T>
+const T* findDecl(const clang::DeclContext* declContext, const std::string& name)
+{
+	for (const clang::NamedDecl* decl:
+		 declContext->lookup(&declContext->getParentASTContext().Idents.get(name)))
+	{
+		if (const T* typedDecl = clang::dyn_cast<T>(decl))
+		{
+			return typedDecl;
+		}
+	}
+	return nullptr;
+}
+
+std::wstring getQualifiedName(const std::unique_ptr<CxxDeclName>& name)
+{
+	return name ? name->toNameHierarchy().getQualifiedName() : L"";
+}
+
+std::wstring getQualifiedName(const std::unique_ptr<CxxTypeName>& name)
+{
+	return name ? name->toNameHierarchy().getQualifiedName() : L"";
+}
+}	 // namespace
+
+TEST_CASE("name resolver cache shares context name between members")
+{
+	std::unique_ptr<clang::ASTUnit> ast = clang::tooling::buildASTFromCode(
+		"namespace ns { class A { void f(); void g(); }; }");
+	const clang::NamespaceDecl* ns = findDecl<clang::NamespaceDecl>(
+		ast->getASTContext().getTranslationUnitDecl(), "ns");
+	REQUIRE(ns);
+	const clang::CXXRecordDecl* a = findDecl<clang::CXXRecordDecl>(ns, "A");
+	REQUIRE(a);
+	const clang::CXXMethodDecl* f = findDecl<clang::CXXMethodDecl>(a, "f");
+	const clang::CXXMethodDecl* g = findDecl<clang::CXXMethodDecl>(a, "g");
+	REQUIRE(f);
+	REQUIRE(g);
+
+	CxxNameResolverCache cache;
+	std::unique_ptr<CxxDeclName> fName = CxxDeclNameResolver(nullptr, &cache).getName(f);
+	std::unique_ptr<CxxDeclName> gName = CxxDeclNameResolver(nullptr, &cache).getName(g);
+
+	REQUIRE(getQualifiedName(fName) == L"ns::A::f");
+	REQUIRE(getQualifiedName(gName) == L"ns::A::g");
+	REQUIRE(fName->getParent());
+	REQUIRE(fName->getParent() == gName->getParent());
+
+	std::shared_ptr<CxxName> contextName;
+	REQUIRE(cache.getContextName(a, contextName));
+	REQUIRE(contextName == fName->getParent());
+}
+
+TEST_CASE("name resolver cache returns stored context name")
+{
+	std::unique_ptr<clang::ASTUnit> ast = clang::tooling::buildASTFromCode(
+		"class A { void f(); };");
+	const clang::CXXRecordDecl* a = findDecl<clang::CXXRecordDecl>(
+		ast->getASTContext().getTranslationUnitDecl(), "A");
+	REQUIRE(a);
+	const clang::CXXMethodDecl* f = findDecl<clang::CXXMethodDecl>(a, "f");
+	REQUIRE(f);
+
+	CxxNameResolverCache cache;
+	cache.addContextName(a, std::make_shared<CxxDeclName>(L"Cached"));
+
+	REQUIRE(getQualifiedName(CxxDeclNameResolver(nullptr, &cache).getName(f)) == L"Cached::f");
+	REQUIRE(getQualifiedName(CxxDeclNameResolver(nullptr).getName(f)) == L"A::f");
+}
+
+TEST_CASE("name resolver cache returns stored declaration name of types")
+{
+	std::unique_ptr<clang::ASTUnit> ast = clang::tooling::buildASTFromCode(
+		"class B {}; B b; const B* c;");
+	const clang::TranslationUnitDecl* translationUnit =
+		ast->getASTContext().getTranslationUnitDecl();
+	const clang::CXXRecordDecl* bClass = findDecl<clang::CXXRecordDecl>(translationUnit, "B");
+	const clang::VarDecl* b = findDecl<clang::VarDecl>(translationUnit, "b");
+	const clang::VarDecl* c = findDecl<clang::VarDecl>(translationUnit, "c");
+	REQUIRE(bClass);
+	REQUIRE(b);
+	REQUIRE(c);
+
+	CxxNameResolverCache cache;
+	REQUIRE(getQualifiedName(CxxTypeNameResolver(nullptr, &cache).getName(b->getType())) == L"B");
+	REQUIRE(cache.getDeclName(bClass));
+
+	cache.addDeclName(bClass, std::make_shared<CxxDeclName>(L"Cached"));
+	REQUIRE(cache.getDeclName(bClass)->getName() == L"B");
+
+	CxxNameResolverCache otherCache;
+	otherCache.addDeclName(bClass, std::make_shared<CxxDeclName>(L"Cached"));
+	REQUIRE(
+		getQualifiedName(CxxTypeNameResolver(nullptr, &otherCache).getName(c->getType())) ==
+		L"Cached");
+}
+
+TEST_CASE("name resolver cache is not used while a context is ignored")
+{
+	std::unique_ptr<clang::ASTUnit> ast = clang::tooling::buildASTFromCode(
+		"class A { void f(); };");
+	const clang::CXXRecordDecl* a = findDecl<clang::CXXRecordDecl>(
+		ast->getASTContext().getTranslationUnitDecl(), "A");
+	REQUIRE(a);
+	const clang::CXXMethodDecl* f = findDecl<clang::CXXMethodDecl>(a, "f");
+	REQUIRE(f);
+
+	CxxNameResolverCache cache;
+	cache.addContextName(a, std::make_shared<CxxDeclName>(L"Cached"));
+
+	CxxDeclNameResolver resolver(nullptr, &cache);
+	resolver.ignoreContextDecl(f);
+
+	REQUIRE(getQualifiedName(resolver.getName(f)) == L"A::f");
+}
+
+#endif	  // BUILD_CXX_LANGUAGE_PACKAGE
@@ -4,6 +4,8 @@
 
 #if BUILD_CXX_LANGUAGE_PACKAGE
 
+#	include <algorithm>
+
 #	include "TextAccess.h"
 #	include "utility.h"
 #	include "utilityString.h"
@@ -32,6 +34,35 @@ std::shared_ptr<TestStorage> parseCode(std::string code, std::vector<std::wstrin
 
 	return TestStorage::create(storage);
 }
+
+std::shared_ptr<TestStorage> parseFile(
+	const FilePath& sourceFilePath, std::shared_ptr<IndexerStateInfo> indexerStateInfo)
+{
+	std::shared_ptr<IndexerCommandCxx> indexerCommand = std::make_shared<IndexerCommandCxx>(
+		sourceFilePath,
+		std::set<FilePath> {FilePath(L"data/CxxParserTestSuite/")},
+		std::set<FilePathFilter>(),
+		std::set<FilePathFilter>(),
+		FilePath(L"."),
+		std::vector<std::wstring> {
+			L"--target=x86_64-pc-windows-msvc", L"-std=c++1z", sourceFilePath.wstr()});
+
+	std::shared_ptr<IntermediateStorage> storage = std::make_shared<IntermediateStorage>();
+	CxxParser parser(
+		std::make_shared<ParserClientImpl>(storage.get()),
+		std::make_shared<TestFileRegister>(),
+		indexerStateInfo);
+	parser.buildIndex(indexerCommand);
+
+	return TestStorage::create(storage);
+}
+
+size_t countLocatedSymbols(const std::vector<std::wstring>& symbols, const std::wstring& name)
+{
+	return std::count_if(symbols.begin(), symbols.end(), [&name](const std::wstring& symbol) {
+		return utility::isPrefix(name + L" <", symbol);
+	});
+}
 }	 // namespace
 
 TEST_CASE("cxx parser finds global variable declaration")
@@ -3989,6 +4020,32 @@ TEST_CASE("cxx parser parses multiple files")
 	REQUIRE(testStorage->includes.size() == 1);
 }
 
+TEST_CASE("cxx parser records symbols of skipped headers only once")
+{
+	std::shared_ptr<IndexerStateInfo> firstStateInfo = std::make_shared<IndexerStateInfo>();
+	std::shared_ptr<TestStorage> firstStorage = parseFile(
+		FilePath(L"data/CxxParserTestSuite/guarded_a.cpp"), firstStateInfo);
+
+	REQUIRE(firstStateInfo->guardedHeaderFilePaths.size() == 1);
+
+	std::shared_ptr<IndexerStateInfo> secondStateInfo = std::make_shared<IndexerStateInfo>();
+	secondStateInfo->skippedHeaderFilePaths = firstStateInfo->guardedHeaderFilePaths;
+	std::shared_ptr<TestStorage> secondStorage = parseFile(
+		FilePath(L"data/CxxParserTestSuite/guarded_b.cpp"), secondStateInfo);
+
+	REQUIRE(firstStorage->errors.size() == 0);
+	REQUIRE(secondStorage->errors.size() == 0);
+
+	// the header declarations are only recorded by the first translation unit
+	REQUIRE(countLocatedSymbols(firstStorage->classes, L"Guarded") == 1);
+	REQUIRE(countLocatedSymbols(secondStorage->classes, L"Guarded") == 0);
+	REQUIRE(countLocatedSymbols(firstStorage->methods, L"public void Guarded::method()") == 1);
+	REQUIRE(countLocatedSymbols(secondStorage->methods, L"public void Guarded::method()") == 0);
+
+	// the skipped header is still stored and references into it are still recorded
+	REQUIRE(secondStorage->files.size() == 2);
+	REQUIRE(secondStorage->calls.size() == 1);
+}
 
 TEST_CASE("cxx parser finds braces of class decl")
 {
@@ -0,0 +1,35 @@
+#include "catch.hpp"
+
+#include "FilePathFilter.h"
+#include "FileRegister.h"
+
+TEST_CASE("file register shares lookups with register of next source file")
+{
+	const std::set<FilePath> indexedPaths = {FilePath(L"./data/FileSystemTestSuite/src")};
+	const std::set<FilePathFilter> excludeFilters = {FilePathFilter(L"**/test.h")};
+
+	const FilePath updatePath(L"./data/FileSystemTestSuite/update.c");
+	const FilePath srcCppPath(L"./data/FileSystemTestSuite/src/test.cpp");
+	const FilePath srcTestPath(L"./data/FileSystemTestSuite/src/test.h");
+
+	FileRegister first(updatePath, indexedPaths, excludeFilters);
+	REQUIRE(first.hasFilePath(updatePath));
+	REQUIRE(first.hasFilePath(srcCppPath));
+	REQUIRE(!first.hasFilePath(srcTestPath));
+
+	REQUIRE(first.hasSameIndexedPaths(indexedPaths, excludeFilters));
+	REQUIRE(!first.hasSameIndexedPaths(indexedPaths, {}));
+	REQUIRE(!first.hasSameIndexedPaths({}, excludeFilters));
+
+	// the previous source file is not part of the indexed paths
+	FileRegister second(srcCppPath, first);
+	REQUIRE(second.hasFilePath(srcCppPath));
+	REQUIRE(!second.hasFilePath(updatePath));
+	REQUIRE(!second.hasFilePath(srcTestPath));
+	REQUIRE(second.hasSameIndexedPaths(indexedPaths, excludeFilters));
+
+	// excluded source files are not part of the register
+	FileRegister third(srcTestPath, second);
+	REQUIRE(!third.hasFilePath(srcTestPath));
+	REQUIRE(third.hasFilePath(srcCppPath));
+}
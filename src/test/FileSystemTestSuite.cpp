@@ -2,9 +2,14 @@
 
 #include <algorithm>
 #include <fstream>
+#include <set>
 #include <string>
 #include <vector>
 
+#ifndef _WIN32
+#	include <sys/stat.h>
+#endif
+
 #include "FileSystem.h"
 #include "utility.h"
 
@@ -132,6 +137,80 @@ TEST_CASE("find file infos with symlinks")
 #endif
 }
 
+TEST_CASE("find file infos in large directory tree")
+{
+#ifndef _WIN32
+	const FilePath rootPath(L"./data/FileSystemTestSuite/large");
+	for (int i = 0; i < 20; i++)
+	{
+		const FilePath directoryPath = rootPath.getConcatenated(L"dir" + std::to_wstring(i));
+		FileSystem::createDirectory(directoryPath);
+		for (int j = 0; j < 250; j++)
+		{
+			std::ofstream file;
+			file.open(directoryPath.getConcatenated(L"file" + std::to_wstring(j) + L".cpp").str());
+			file.close();
+			file.open(directoryPath.getConcatenated(L"file" + std::to_wstring(j) + L".txt").str());
+			file.close();
+		}
+	}
+
+	const std::vector<FileInfo> files = FileSystem::getFileInfosFromPaths(
+		{rootPath}, {L".CPP"}, true);
+
+	// the parallel scan finds the same files as the sequential directory iteration
+	std::set<std::wstring> scannedPaths;
+	for (const FileInfo& info: files)
+	{
+		scannedPaths.insert(info.path.wstr());
+	}
+	std::set<std::wstring> iteratedPaths;
+	for (const FilePath& filePath: FileSystem::getFilePathsFromDirectory(rootPath, {L".cpp"}))
+	{
+		iteratedPaths.insert(filePath.wstr());
+	}
+
+	for (const FilePath& filePath: FileSystem::getFilePathsFromDirectory(rootPath))
+	{
+		FileSystem::remove(filePath);
+	}
+	for (const FilePath& directoryPath: FileSystem::getDirectSubDirectories(rootPath))
+	{
+		FileSystem::remove(directoryPath);
+	}
+	FileSystem::remove(rootPath);
+
+	REQUIRE(files.size() == 5000);
+	REQUIRE(scannedPaths == iteratedPaths);
+	REQUIRE(isInFileInfos(files, L"./data/FileSystemTestSuite/large/dir7/file42.cpp"));
+	REQUIRE(files.front().lastWriteTime.isValid());
+#endif
+}
+
+TEST_CASE("find file infos skips special files")
+{
+#ifndef _WIN32
+	const FilePath rootPath(L"./data/FileSystemTestSuite/special");
+	FileSystem::createDirectory(rootPath);
+	const FilePath fifoPath = rootPath.getConcatenated(L"fifo.cpp");
+	const FilePath filePath = rootPath.getConcatenated(L"file.cpp");
+	REQUIRE(mkfifo(fifoPath.str().c_str(), 0600) == 0);
+	std::ofstream file;
+	file.open(filePath.str());
+	file.close();
+
+	const std::vector<FileInfo> files = FileSystem::getFileInfosFromPaths(
+		{rootPath}, {L".cpp"}, true);
+
+	FileSystem::remove(fifoPath);
+	FileSystem::remove(filePath);
+	FileSystem::remove(rootPath);
+
+	REQUIRE(files.size() == 1);
+	REQUIRE(isInFileInfos(files, filePath.wstr()));
+#endif
+}
+
 TEST_CASE("find symlinked directories")
 {
 #ifndef _WIN32
@@ -0,0 +1,172 @@
+#include "catch.hpp"
+
+#include "Graph.h"
+#include "GraphController.h"
+#include "GraphViewStyle.h"
+#include "GraphViewStyleImpl.h"
+
+namespace
+{
+class TestGraphViewStyleImpl: public GraphViewStyleImpl
+{
+public:
+	float getCharWidth(const std::string& fontName, size_t fontSize) override
+	{
+		return fontSize * 0.5f;
+	}
+
+	float getCharHeight(const std::string& fontName, size_t fontSize) override
+	{
+		return static_cast<float>(fontSize);
+	}
+
+	float getGraphViewZoomDifferenceForPlatform() override
+	{
+		return 1.0f;
+	}
+};
+
+void requireEqualLayout(const DummyNode* node, const DummyNode* otherNode)
+{
+	REQUIRE(node->name == otherNode->name);
+	REQUIRE(node->visible == otherNode->visible);
+	REQUIRE(node->position == otherNode->position);
+	REQUIRE(node->size == otherNode->size);
+	REQUIRE(node->subNodes.size() == otherNode->subNodes.size());
+
+	for (size_t i = 0; i < node->subNodes.size(); i++)
+	{
+		requireEqualLayout(node->subNodes[i].get(), otherNode->subNodes[i].get());
+	}
+}
+}	 // namespace
+
+// Lays out the nesting of a fixed graph without view and storage. Class "A" contains method "f" and
+// the nested classes "B" and "D", where "B" contains the nested class "E". Class "C" is a second
+// top level node.
+class GraphControllerTestAccess
+{
+public:
+	GraphControllerTestAccess(): m_controller(nullptr)
+	{
+		GraphViewStyle::setImpl(std::make_shared<TestGraphViewStyleImpl>());
+		GraphViewStyle::loadStyleSettings();
+
+		m_graph = std::make_shared<Graph>();
+		Node* a = createNode(1, NODE_CLASS, L"A");
+		Node* b = createNode(2, NODE_CLASS, L"B");
+		Node* c = createNode(3, NODE_CLASS, L"C");
+		Node* d = createNode(4, NODE_CLASS, L"D");
+		Node* e = createNode(5, NODE_CLASS, L"E");
+		Node* f = createNode(6, NODE_METHOD, L"f");
+		Node* g = createNode(7, NODE_FIELD, L"g");
+		Node* h = createNode(8, NODE_METHOD, L"withLongerName");
+
+		createMember(a, f);
+		createMember(a, b);
+		createMember(a, d);
+		createMember(b, e);
+		createMember(b, g);
+		createMember(d, h);
+		createMember(e, createNode(9, NODE_FIELD, L"i"));
+
+		m_controller.m_graph = m_graph;
+		for (Node* node: {a, c})
+		{
+			utility::append(
+				m_controller.m_dummyNodes,
+				m_controller.createDummyNodeTopDown(node, node->getId()));
+		}
+
+		setExpanded(1, true);
+		setExpanded(4, true);
+		m_controller.setActiveAndVisibility({1, 3});
+		m_controller.layoutNesting();
+	}
+
+	void setExpanded(Id nodeId, bool expanded)
+	{
+		m_controller.getDummyGraphNodeById(nodeId)->expanded = expanded;
+	}
+
+	// the same steps as expanding a node in the graph view, with either layout
+	void expand(Id nodeId, bool layoutAllNodes)
+	{
+		setExpanded(nodeId, true);
+		m_controller.setActiveAndVisibility({1, 3});
+
+		if (layoutAllNodes)
+		{
+			m_controller.layoutNesting();
+		}
+		else
+		{
+			m_controller.layoutNestingOfNode(m_controller.getDummyGraphNodeById(nodeId).get());
+		}
+	}
+
+	const std::vector<std::shared_ptr<DummyNode>>& getDummyNodes() const
+	{
+		return m_controller.m_dummyNodes;
+	}
+
+	const DummyNode* getDummyNode(Id nodeId) const
+	{
+		return m_controller.getDummyGraphNodeById(nodeId).get();
+	}
+
+private:
+	Node* createNode(Id nodeId, NodeKind kind, const std::wstring& name)
+	{
+		return m_graph->createNode(
+			nodeId, NodeType(kind), NameHierarchy(name, NAME_DELIMITER_CXX), DEFINITION_EXPLICIT);
+	}
+
+	void createMember(Node* parent, Node* child)
+	{
+		m_graph->createEdge(m_nextEdgeId++, Edge::EDGE_MEMBER, parent, child);
+		parent->setChildCount(parent->getChildCount() + 1);
+	}
+
+	GraphController m_controller;
+	std::shared_ptr<Graph> m_graph;
+	Id m_nextEdgeId = 100;
+};
+
+TEST_CASE("graph controller lays out nesting of expanded node like the whole graph")
+{
+	GraphControllerTestAccess partialLayout;
+	GraphControllerTestAccess fullLayout;
+
+	const Vec2i collapsedSize = partialLayout.getDummyNode(2)->size;
+
+	partialLayout.expand(2, false);
+	fullLayout.expand(2, true);
+
+	REQUIRE(partialLayout.getDummyNode(2)->size != collapsedSize);
+	REQUIRE(partialLayout.getDummyNodes().size() == fullLayout.getDummyNodes().size());
+	for (size_t i = 0; i < partialLayout.getDummyNodes().size(); i++)
+	{
+		requireEqualLayout(
+			partialLayout.getDummyNodes()[i].get(), fullLayout.getDummyNodes()[i].get());
+	}
+}
+
+TEST_CASE("graph controller lays out nesting of deeply expanded node like the whole graph")
+{
+	GraphControllerTestAccess partialLayout;
+	GraphControllerTestAccess fullLayout;
+
+	partialLayout.expand(2, false);
+	fullLayout.expand(2, true);
+
+	partialLayout.expand(5, false);
+	fullLayout.expand(5, true);
+
+	REQUIRE(partialLayout.getDummyNode(5)->size.x > 0);
+	for (size_t i = 0; i < partialLayout.getDummyNodes().size(); i++)
+	{
+		requireEqualLayout(
+			partialLayout.getDummyNodes()[i].get(), fullLayout.getDummyNodes()[i].get());
+	}
+}
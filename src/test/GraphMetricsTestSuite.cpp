@@ -0,0 +1,170 @@
+#include "catch.hpp"
+
+#include <random>
+#include <set>
+
+#include "AdjacencyCache.h"
+#include "GraphMetrics.h"
+
+namespace
+{
+class TestIndex
+{
+public:
+	TestIndex(size_t nodeCount)
+	{
+		for (size_t i = 0; i < nodeCount; i++)
+		{
+			cache.addNode(i + 1, NODE_FUNCTION);
+		}
+	}
+
+	void addEdge(size_t sourceIndex, size_t targetIndex, Edge::EdgeType type = Edge::EDGE_CALL)
+	{
+		m_edgeCount++;
+		cache.addEdge(1000000000 + m_edgeCount, type, sourceIndex + 1, targetIndex + 1);
+	}
+
+	size_t countReachableNodes(uint32_t nodeIndex) const
+	{
+		std::set<uint32_t> reachedNodes;
+		std::vector<uint32_t> nodesToVisit(1, nodeIndex);
+		while (nodesToVisit.size())
+		{
+			const uint32_t index = nodesToVisit.back();
+			nodesToVisit.pop_back();
+
+			for (const AdjacencyCache::Neighbor& neighbor: cache.getOutgoing(index))
+			{
+				if (reachedNodes.insert(neighbor.nodeIndex).second)
+				{
+					nodesToVisit.push_back(neighbor.nodeIndex);
+				}
+			}
+		}
+
+		reachedNodes.erase(nodeIndex);
+		return reachedNodes.size();
+	}
+
+	AdjacencyCache cache;
+
+private:
+	size_t m_edgeCount = 0;
+};
+}	 // namespace
+
+TEST_CASE("graph metrics count fan in and fan out of followed edges")
+{
+	TestIndex index(3);
+	index.addEdge(0, 1);
+	index.addEdge(0, 2);
+	index.addEdge(1, 2);
+	index.addEdge(1, 1);
+	index.addEdge(2, 0, Edge::EDGE_MEMBER);
+	index.cache.finishSetup();
+
+	GraphMetrics metrics(index.cache, Edge::EDGE_CALL, 2);
+
+	REQUIRE(metrics.getEdgeCount() == 3);
+	REQUIRE(metrics.getFanOut(0) == 2);
+	REQUIRE(metrics.getFanIn(0) == 0);
+	REQUIRE(metrics.getFanOut(1) == 1);
+	REQUIRE(metrics.getFanIn(1) == 1);
+	REQUIRE(metrics.getFanIn(2) == 2);
+}
+
+TEST_CASE("graph metrics find strongly connected components")
+{
+	TestIndex index(5);
+	index.addEdge(0, 1);
+	index.addEdge(1, 2);
+	index.addEdge(2, 0);
+	index.addEdge(2, 3);
+	index.addEdge(3, 4);
+	index.addEdge(4, 3);
+	index.cache.finishSetup();
+
+	GraphMetrics metrics(index.cache, Edge::EDGE_CALL, 1);
+
+	REQUIRE(metrics.getComponentCount() == 2);
+	REQUIRE(metrics.getComponentIndex(0) == metrics.getComponentIndex(2));
+	REQUIRE(metrics.getComponentIndex(3) < metrics.getComponentIndex(0));
+
+	const std::vector<std::vector<uint32_t>> components = metrics.getCyclicComponents();
+	REQUIRE(components.size() == 2);
+	REQUIRE(components[0] == std::vector<uint32_t>({0, 1, 2}));
+	REQUIRE(components[1] == std::vector<uint32_t>({3, 4}));
+}
+
+TEST_CASE("graph metrics rank called nodes higher")
+{
+	TestIndex index(5);
+	for (size_t i = 1; i < 5; i++)
+	{
+		index.addEdge(i, 0);
+	}
+	index.addEdge(0, 1);
+	index.cache.finishSetup();
+
+	GraphMetrics metrics(index.cache, Edge::EDGE_CALL, 4);
+	const std::vector<double> ranks = metrics.computePageRanks(0.85, 1e-12, 100);
+
+	double rankSum = 0.0;
+	for (double rank: ranks)
+	{
+		rankSum += rank;
+	}
+
+	REQUIRE(rankSum == Approx(1.0));
+	REQUIRE(ranks[0] > ranks[1]);
+	REQUIRE(ranks[1] > ranks[2]);
+	REQUIRE(ranks[2] == Approx(ranks[4]));
+}
+
+TEST_CASE("graph metrics count reachable nodes")
+{
+	const size_t nodeCount = 500;
+
+	TestIndex index(nodeCount);
+	std::mt19937 random(42);
+	std::uniform_int_distribution<size_t> distribution(0, nodeCount - 1);
+	for (size_t i = 0; i < nodeCount * 2; i++)
+	{
+		index.addEdge(distribution(random), distribution(random));
+	}
+	index.cache.finishSetup();
+
+	GraphMetrics metrics(index.cache, Edge::EDGE_CALL, 4);
+
+	bool exact = false;
+	const std::vector<size_t> counts = metrics.computeReachableNodeCounts(&exact);
+
+	REQUIRE(exact);
+	for (uint32_t i = 0; i < nodeCount; i++)
+	{
+		REQUIRE(counts[i] == index.countReachableNodes(i));
+	}
+}
+
+TEST_CASE("graph metrics estimate reachable nodes of large graphs")
+{
+	const size_t nodeCount = 600000;
+
+	TestIndex index(nodeCount);
+	for (size_t i = 0; i + 1 < nodeCount; i++)
+	{
+		index.addEdge(i, i + 1);
+	}
+	index.cache.finishSetup();
+
+	GraphMetrics metrics(index.cache, Edge::EDGE_CALL, 4);
+
+	bool exact = true;
+	const std::vector<size_t> counts = metrics.computeReachableNodeCounts(&exact);
+
+	REQUIRE(!exact);
+	REQUIRE(counts[0] == Approx(nodeCount - 1).epsilon(0.4));
+	REQUIRE(counts[nodeCount / 2] == Approx(nodeCount / 2).epsilon(0.4));
+	REQUIRE(counts[nodeCount - 1] == 0);
+}
@@ -0,0 +1,421 @@
+#include "catch.hpp"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <random>
+
+#include "HierarchyCache.h"
+#include "utility.h"
+
+namespace
+{
+// the node based implementation that HierarchyCache replaced, kept to compare query results
+class ReferenceHierarchyCache
+{
+public:
+	void createConnection(
+		Id edgeId, Id fromId, Id toId, bool sourceVisible, bool sourceImplicit, bool targetImplicit)
+	{
+		if (fromId == toId)
+		{
+			return;
+		}
+
+		Node* from = createNode(fromId);
+		Node* to = createNode(toId);
+
+		from->children.push_back(to);
+		to->parent = from;
+
+		from->isVisible = sourceVisible;
+		from->isImplicit = sourceImplicit;
+
+		to->edgeId = edgeId;
+		to->isImplicit = targetImplicit;
+	}
+
+	void createInheritance(Id edgeId, Id fromId, Id toId)
+	{
+		if (fromId == toId)
+		{
+			return;
+		}
+
+		createNode(fromId)->bases.push_back({createNode(toId), edgeId});
+	}
+
+	Id getLastVisibleParentNodeId(Id nodeId) const
+	{
+		const Node* parent = getNode(nodeId);
+		while (parent && parent->isVisible)
+		{
+			nodeId = parent->nodeId;
+			parent = parent->parent;
+		}
+		return nodeId;
+	}
+
+	size_t getIndexOfLastVisibleParentNode(Id nodeId) const
+	{
+		size_t idx = 0;
+		bool visible = false;
+		for (const Node* node = getNode(nodeId); node; node = node->parent)
+		{
+			if (node->isVisible && !idx)
+			{
+				visible = true;
+			}
+			else if (visible)
+			{
+				idx++;
+			}
+		}
+		return idx;
+	}
+
+	void addAllVisibleParentIdsForNodeId(
+		Id nodeId, std::set<Id>* nodeIds, std::set<Id>* edgeIds) const
+	{
+		Id edgeId = 0;
+		for (const Node* node = getNode(nodeId); node && node->isVisible; node = node->parent)
+		{
+			if (edgeId)
+			{
+				edgeIds->insert(edgeId);
+			}
+			nodeIds->insert(node->nodeId);
+			edgeId = node->edgeId;
+		}
+	}
+
+	void addAllChildIdsForNodeId(Id nodeId, std::set<Id>* nodeIds, std::set<Id>* edgeIds) const
+	{
+		const Node* node = getNode(nodeId);
+		if (node && node->isVisible)
+		{
+			addChildIdsRecursive(node, nodeIds, edgeIds);
+		}
+	}
+
+	void addFirstChildIdsForNodeId(
+		Id nodeId, std::vector<Id>* nodeIds, std::vector<Id>* edgeIds) const
+	{
+		if (const Node* node = getNode(nodeId))
+		{
+			for (const Node* child: node->children)
+			{
+				if (node->isImplicit || !child->isImplicit)
+				{
+					nodeIds->push_back(child->nodeId);
+					edgeIds->push_back(child->edgeId);
+				}
+			}
+		}
+	}
+
+	size_t getFirstChildIdsCountForNodeId(Id nodeId) const
+	{
+		std::vector<Id> nodeIds;
+		std::vector<Id> edgeIds;
+		addFirstChildIdsForNodeId(nodeId, &nodeIds, &edgeIds);
+		return nodeIds.size();
+	}
+
+	bool isChildOfVisibleNodeOrInvisible(Id nodeId) const
+	{
+		const Node* node = getNode(nodeId);
+		return node && (!node->isVisible || (node->parent && node->parent->isVisible));
+	}
+
+	bool nodeHasChildren(Id nodeId) const
+	{
+		const Node* node = getNode(nodeId);
+		return node && !node->children.empty();
+	}
+
+	bool nodeIsVisible(Id nodeId) const
+	{
+		const Node* node = getNode(nodeId);
+		return node && node->isVisible;
+	}
+
+	bool nodeIsImplicit(Id nodeId) const
+	{
+		const Node* node = getNode(nodeId);
+		return node && node->isImplicit;
+	}
+
+	std::vector<std::tuple<Id, Id, std::vector<Id>>> getInheritanceEdgesForNodeId(
+		Id nodeId, const std::set<Id>& nodeIds) const
+	{
+		std::vector<std::tuple<Id, Id, std::vector<Id>>> inheritanceEdges;
+		if (const Node* node = getNode(nodeId))
+		{
+			addInheritanceEdgesRecursive(node, nodeId, {}, nodeIds, &inheritanceEdges);
+		}
+		return inheritanceEdges;
+	}
+
+private:
+	struct Node
+	{
+		Id nodeId = 0;
+		Id edgeId = 0;
+		Node* parent = nullptr;
+		std::vector<std::pair<Node*, Id>> bases;
+		std::vector<Node*> children;
+		bool isVisible = true;
+		bool isImplicit = false;
+	};
+
+	static void addChildIdsRecursive(const Node* node, std::set<Id>* nodeIds, std::set<Id>* edgeIds)
+	{
+		for (const Node* child: node->children)
+		{
+			nodeIds->insert(child->nodeId);
+			edgeIds->insert(child->edgeId);
+			addChildIdsRecursive(child, nodeIds, edgeIds);
+		}
+	}
+
+	static void addInheritanceEdgesRecursive(
+		const Node* node,
+		Id startId,
+		const std::set<Id>& inheritanceEdgeIds,
+		const std::set<Id>& nodeIds,
+		std::vector<std::tuple<Id, Id, std::vector<Id>>>* inheritanceEdges)
+	{
+		for (const std::pair<Node*, Id>& base: node->bases)
+		{
+			if (inheritanceEdgeIds.find(base.second) != inheritanceEdgeIds.end())
+			{
+				continue;
+			}
+
+			std::set<Id> inheritanceEdgeIds2 = inheritanceEdgeIds;
+			inheritanceEdgeIds2.insert(base.second);
+
+			if (nodeIds.find(base.first->nodeId) != nodeIds.end())
+			{
+				inheritanceEdges->push_back(
+					{startId, base.first->nodeId, utility::toVector(inheritanceEdgeIds2)});
+			}
+
+			addInheritanceEdgesRecursive(
+				base.first, startId, inheritanceEdgeIds2, nodeIds, inheritanceEdges);
+		}
+	}
+
+	const Node* getNode(Id nodeId) const
+	{
+		auto it = m_nodes.find(nodeId);
+		return it != m_nodes.end() ? it->second.get() : nullptr;
+	}
+
+	Node* createNode(Id nodeId)
+	{
+		std::unique_ptr<Node>& node = m_nodes[nodeId];
+		if (!node)
+		{
+			node = std::make_unique<Node>();
+			node->nodeId = nodeId;
+		}
+		return node.get();
+	}
+
+	std::map<Id, std::unique_ptr<Node>> m_nodes;
+};
+
+struct Connection
+{
+	Id edgeId;
+	Id fromId;
+	Id toId;
+	bool sourceVisible;
+	bool sourceImplicit;
+	bool targetImplicit;
+};
+
+struct Inheritance
+{
+	Id edgeId;
+	Id fromId;
+	Id toId;
+};
+
+void requireEqualQueryResults(
+	const HierarchyCache& cache,
+	const ReferenceHierarchyCache& reference,
+	Id maxNodeId,
+	unsigned int seed)
+{
+	std::mt19937 random(seed);
+
+	// ids above the largest node id are unknown to both caches
+	for (Id nodeId = 0; nodeId <= maxNodeId + 2; nodeId++)
+	{
+		REQUIRE(
+			cache.getLastVisibleParentNodeId(nodeId) ==
+			reference.getLastVisibleParentNodeId(nodeId));
+		REQUIRE(
+			cache.getIndexOfLastVisibleParentNode(nodeId) ==
+			reference.getIndexOfLastVisibleParentNode(nodeId));
+		REQUIRE(
+			cache.isChildOfVisibleNodeOrInvisible(nodeId) ==
+			reference.isChildOfVisibleNodeOrInvisible(nodeId));
+		REQUIRE(cache.nodeHasChildren(nodeId) == reference.nodeHasChildren(nodeId));
+		REQUIRE(cache.nodeIsVisible(nodeId) == reference.nodeIsVisible(nodeId));
+		REQUIRE(cache.nodeIsImplicit(nodeId) == reference.nodeIsImplicit(nodeId));
+		REQUIRE(
+			cache.getFirstChildIdsCountForNodeId(nodeId) ==
+			reference.getFirstChildIdsCountForNodeId(nodeId));
+
+		std::set<Id> nodeIds;
+		std::set<Id> edgeIds;
+		std::set<Id> referenceNodeIds;
+		std::set<Id> referenceEdgeIds;
+		cache.addAllVisibleParentIdsForNodeId(nodeId, &nodeIds, &edgeIds);
+		reference.addAllVisibleParentIdsForNodeId(nodeId, &referenceNodeIds, &referenceEdgeIds);
+		REQUIRE(nodeIds == referenceNodeIds);
+		REQUIRE(edgeIds == referenceEdgeIds);
+
+		cache.addAllChildIdsForNodeId(nodeId, &nodeIds, &edgeIds);
+		reference.addAllChildIdsForNodeId(nodeId, &referenceNodeIds, &referenceEdgeIds);
+		REQUIRE(nodeIds == referenceNodeIds);
+		REQUIRE(edgeIds == referenceEdgeIds);
+
+		std::vector<Id> childIds;
+		std::vector<Id> childEdgeIds;
+		std::vector<Id> referenceChildIds;
+		std::vector<Id> referenceChildEdgeIds;
+		cache.addFirstChildIdsForNodeId(nodeId, &childIds, &childEdgeIds);
+		reference.addFirstChildIdsForNodeId(nodeId, &referenceChildIds, &referenceChildEdgeIds);
+		REQUIRE(childIds == referenceChildIds);
+		REQUIRE(childEdgeIds == referenceChildEdgeIds);
+
+		std::set<Id> visibleNodeIds;
+		for (Id id = 1; id <= maxNodeId; id++)
+		{
+			if (std::bernoulli_distribution(0.5)(random))
+			{
+				visibleNodeIds.insert(id);
+			}
+		}
+		REQUIRE(
+			cache.getInheritanceEdgesForNodeId(nodeId, visibleNodeIds) ==
+			reference.getInheritanceEdgesForNodeId(nodeId, visibleNodeIds));
+	}
+}
+
+void requireEqualToReference(size_t nodeCount, unsigned int seed)
+{
+	std::mt19937 random(seed);
+	std::bernoulli_distribution coin(0.5);
+	std::bernoulli_distribution rarely(0.1);
+
+	// members always have a smaller parent id, so the member hierarchy is free of cycles, a few
+	// nodes are listed under a second parent
+	std::vector<Connection> connections;
+	Id edgeId = nodeCount + 1;
+	for (Id nodeId = 2; nodeId <= nodeCount; nodeId++)
+	{
+		const size_t parentCount = rarely(random) ? 2 : 1;
+		for (size_t i = 0; i < parentCount; i++)
+		{
+			const Id parentId = std::uniform_int_distribution<Id>(
+				nodeId > 8 ? nodeId - 8 : 1, nodeId - 1)(random);
+			connections.push_back(
+				{edgeId++, parentId, nodeId, !rarely(random), rarely(random), rarely(random)});
+		}
+	}
+
+	// bases always have a smaller id as well, some inheritance edges are added twice
+	std::vector<Inheritance> inheritances;
+	for (Id nodeId = 2; nodeId <= nodeCount; nodeId++)
+	{
+		if (coin(random))
+		{
+			const Id baseId = std::uniform_int_distribution<Id>(
+				nodeId > 4 ? nodeId - 4 : 1, nodeId - 1)(random);
+			inheritances.push_back({edgeId++, nodeId, baseId});
+			if (rarely(random))
+			{
+				inheritances.push_back(inheritances.back());
+			}
+		}
+	}
+	connections.push_back({edgeId++, 1, 1, true, false, false});
+	inheritances.push_back({edgeId++, 1, 1});
+
+	std::shuffle(connections.begin(), connections.end(), random);
+	std::shuffle(inheritances.begin(), inheritances.end(), random);
+
+	HierarchyCache cache;
+	ReferenceHierarchyCache reference;
+
+	// both kinds of edges arrive interleaved, like they are read from storage
+	size_t connectionIndex = 0;
+	size_t inheritanceIndex = 0;
+	while (connectionIndex < connections.size() || inheritanceIndex < inheritances.size())
+	{
+		if (inheritanceIndex == inheritances.size() ||
+			(connectionIndex < connections.size() && coin(random)))
+		{
+			const Connection& c = connections[connectionIndex++];
+			cache.createConnection(
+				c.edgeId, c.fromId, c.toId, c.sourceVisible, c.sourceImplicit, c.targetImplicit);
+			reference.createConnection(
+				c.edgeId, c.fromId, c.toId, c.sourceVisible, c.sourceImplicit, c.targetImplicit);
+		}
+		else
+		{
+			const Inheritance& i = inheritances[inheritanceIndex++];
+			cache.createInheritance(i.edgeId, i.fromId, i.toId);
+			reference.createInheritance(i.edgeId, i.fromId, i.toId);
+		}
+	}
+	cache.finishSetup();
+
+	requireEqualQueryResults(cache, reference, nodeCount, seed);
+}
+}	 // namespace
+
+TEST_CASE("hierarchy cache answers queries of empty cache")
+{
+	HierarchyCache cache;
+	cache.finishSetup();
+
+	REQUIRE(cache.getLastVisibleParentNodeId(1) == 1);
+	REQUIRE(cache.getIndexOfLastVisibleParentNode(1) == 0);
+	REQUIRE(!cache.nodeHasChildren(1));
+	REQUIRE(!cache.nodeIsVisible(1));
+	REQUIRE(!cache.isChildOfVisibleNodeOrInvisible(1));
+	REQUIRE(cache.getInheritanceEdgesForNodeId(1, {1}).empty());
+}
+
+TEST_CASE("hierarchy cache matches node based implementation for random hierarchies")
+{
+	for (unsigned int seed = 1; seed <= 20; seed++)
+	{
+		requireEqualToReference(60, seed);
+	}
+}
+
+TEST_CASE("hierarchy cache matches node based implementation after clear")
+{
+	HierarchyCache cache;
+	cache.createConnection(10, 1, 2, false, false, false);
+	cache.createInheritance(11, 2, 1);
+	cache.finishSetup();
+	cache.clear();
+
+	ReferenceHierarchyCache reference;
+	cache.createConnection(12, 3, 4, true, false, true);
+	reference.createConnection(12, 3, 4, true, false, true);
+	cache.createInheritance(13, 4, 3);
+	reference.createInheritance(13, 4, 3);
+	cache.finishSetup();
+
+	requireEqualQueryResults(cache, reference, 4, 0);
+}
@@ -0,0 +1,55 @@
+#include "catch.hpp"
+
+#include <string>
+
+#include "LruCache.h"
+
+TEST_CASE("lru cache returns stored values")
+{
+	LruCache<int, std::string> cache(2);
+	cache.setValue(1, "one");
+	cache.setValue(2, "two");
+
+	std::string value;
+	REQUIRE(cache.getValue(1, &value));
+	REQUIRE(value == "one");
+	REQUIRE(cache.getValue(2, &value));
+	REQUIRE(value == "two");
+	REQUIRE(!cache.getValue(3, &value));
+}
+
+TEST_CASE("lru cache drops least recently used value")
+{
+	LruCache<int, std::string> cache(2);
+	cache.setValue(1, "one");
+	cache.setValue(2, "two");
+
+	std::string value;
+	REQUIRE(cache.getValue(1, &value));
+
+	cache.setValue(3, "three");
+
+	REQUIRE(cache.size() == 2);
+	REQUIRE(cache.getValue(1, &value));
+	REQUIRE(!cache.getValue(2, &value));
+	REQUIRE(cache.getValue(3, &value));
+}
+
+TEST_CASE("lru cache replaces value of existing key")
+{
+	LruCache<int, std::string> cache(2);
+	cache.setValue(1, "one");
+	cache.setValue(2, "two");
+	cache.setValue(1, "uno");
+	cache.setValue(3, "three");
+
+	std::string value;
+	REQUIRE(cache.size() == 2);
+	REQUIRE(cache.getValue(1, &value));
+	REQUIRE(value == "uno");
+	REQUIRE(!cache.getValue(2, &value));
+
+	cache.clear();
+	REQUIRE(cache.size() == 0);
+	REQUIRE(!cache.getValue(1, &value));
+}
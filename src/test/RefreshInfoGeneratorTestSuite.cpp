@@ -336,6 +336,37 @@ TEST_CASE("refresh info for updated files is empty for empty storage and empty s
 	cleanup();
 }
 
+TEST_CASE("refresh info for updated files ignores touched indexed file with unchanged content")
+{
+	cleanup();
+	{
+		const FilePath sourceFilePath = m_sourceFolder.getConcatenated(L"main.cpp");
+
+		std::vector<std::shared_ptr<SourceGroup>> sourceGroups;
+		sourceGroups.push_back(
+			std::shared_ptr<SourceGroupTest>(new SourceGroupTest({sourceFilePath})));
+
+		std::shared_ptr<PersistentStorage> storage = std::make_shared<PersistentStorage>(
+			m_indexDbPath, m_bookmarkDbPath);
+		storage->setup();
+
+		// the file is written before it is stored, so only its modification time differs
+		addFileToFileSystem(sourceFilePath);
+		addVeryOldFileToStorage(sourceFilePath, true, true, storage);
+
+		storage->buildCaches();
+
+		const RefreshInfo refreshInfo = RefreshInfoGenerator::getRefreshInfoForUpdatedFiles(
+			sourceGroups, storage);
+
+		REQUIRE(REFRESH_UPDATED_FILES == refreshInfo.mode);
+		REQUIRE(0 == refreshInfo.nonIndexedFilesToClear.size());
+		REQUIRE(0 == refreshInfo.filesToClear.size());
+		REQUIRE(0 == refreshInfo.filesToIndex.size());
+	}
+	cleanup();
+}
+
 // Now we will test how the refresh info generator reacts to different situations when generating
 // refresh info for updated files. A file can have different states in the following dimensions:
 //	file may be known by the storage					unknown / nonindexed / indexed
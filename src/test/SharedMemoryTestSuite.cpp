@@ -3,6 +3,7 @@
 #include <memory>
 #include <thread>
 
+#include "InterprocessIndexingStatusManager.h"
 #include "SharedMemory.h"
 
 TEST_CASE("shared memory")
@@ -96,3 +97,35 @@ TEST_CASE("shared memory")
 		}
 	}
 }
+
+TEST_CASE("indexing status manager shares command queue stopped flag between processes")
+{
+	InterprocessIndexingStatusManager owner("status_test", 0, true);
+	InterprocessIndexingStatusManager indexer("status_test", 1, false);
+
+	owner.setIndexerCommandQueueStopped(false);
+	REQUIRE(!indexer.getIndexerCommandQueueStopped());
+
+	owner.setIndexerCommandQueueStopped(true);
+	REQUIRE(indexer.getIndexerCommandQueueStopped());
+
+	owner.setIndexerCommandQueueStopped(false);
+	REQUIRE(!indexer.getIndexerCommandQueueStopped());
+}
+
+TEST_CASE("indexing status manager clears indexed headers")
+{
+	InterprocessIndexingStatusManager owner("status_test", 0, true);
+	InterprocessIndexingStatusManager indexer("status_test", 1, false);
+
+	indexer.addIndexedHeaderFilePaths(L"a", {FilePath(L"a.h"), FilePath(L"b.h")});
+	indexer.addIndexedHeaderFilePaths(L"b", {FilePath(L"c.h")});
+
+	REQUIRE(owner.getIndexedHeaderFilePaths(L"a").size() == 2);
+	REQUIRE(owner.getIndexedHeaderFilePaths(L"b").size() == 1);
+
+	owner.clearIndexedHeaderFilePaths();
+
+	REQUIRE(indexer.getIndexedHeaderFilePaths(L"a").empty());
+	REQUIRE(indexer.getIndexedHeaderFilePaths(L"b").empty());
+}
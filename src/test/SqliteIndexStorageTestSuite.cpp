@@ -76,3 +76,66 @@ TEST_CASE("storage removes edge successfully")
 
 	REQUIRE(0 == edgeCount);
 }
+
+TEST_CASE("storage replaces stored indexing durations")
+{
+	FilePath databasePath(L"data/SQLiteTestSuite/test.sqlite");
+	std::map<FilePath, size_t> durations;
+	{
+		SqliteIndexStorage storage(databasePath);
+		storage.setup();
+		storage.setIndexingDurations({{FilePath(L"a.cpp"), 10}, {FilePath(L"b.cpp"), 20}});
+		storage.setIndexingDurations({{FilePath(L"b.cpp"), 30}});
+		storage.setIndexingDurations({{FilePath(L"c.cpp"), 5000000000}});
+		durations = storage.getIndexingDurations();
+	}
+	FileSystem::remove(databasePath);
+
+	REQUIRE(3 == durations.size());
+	REQUIRE(10 == durations[FilePath(L"a.cpp")]);
+	REQUIRE(30 == durations[FilePath(L"b.cpp")]);
+	REQUIRE(5000000000 == durations[FilePath(L"c.cpp")]);
+}
+
+TEST_CASE("storage replaces stored indexing phase durations per file")
+{
+	FilePath databasePath(L"data/SQLiteTestSuite/test.sqlite");
+	std::map<FilePath, std::map<std::string, size_t>> phaseDurations;
+	{
+		SqliteIndexStorage storage(databasePath);
+		storage.setup();
+		storage.setIndexingPhaseDurations(
+			{{FilePath(L"a.cpp"), {{"ast traversal", 10}}},
+			 {FilePath(L"b.cpp"), {{"ast traversal", 20}, {"name resolution", 5}}}});
+		storage.setIndexingPhaseDurations({{FilePath(L"b.cpp"), {{"clang frontend", 30}}}});
+		phaseDurations = storage.getIndexingPhaseDurations();
+	}
+	FileSystem::remove(databasePath);
+
+	REQUIRE(2 == phaseDurations.size());
+	REQUIRE(10 == phaseDurations[FilePath(L"a.cpp")]["ast traversal"]);
+	REQUIRE(1 == phaseDurations[FilePath(L"b.cpp")].size());
+	REQUIRE(30 == phaseDurations[FilePath(L"b.cpp")]["clang frontend"]);
+}
+
+TEST_CASE("storage removes indexing phase durations of cleared files")
+{
+	FilePath databasePath(L"data/SQLiteTestSuite/test.sqlite");
+	std::map<FilePath, std::map<std::string, size_t>> phaseDurations;
+	{
+		SqliteIndexStorage storage(databasePath);
+		storage.setup();
+		storage.setIndexingPhaseDurations(
+			{{FilePath(), {{"storage injection", 5}}},
+			 {FilePath(L"a.cpp"), {{"ast traversal", 10}}},
+			 {FilePath(L"b.cpp"), {{"ast traversal", 20}}}});
+		storage.removeIndexingPhaseDurations({FilePath(L"a.cpp"), FilePath(L"c.cpp")});
+		phaseDurations = storage.getIndexingPhaseDurations();
+	}
+	FileSystem::remove(databasePath);
+
+	REQUIRE(2 == phaseDurations.size());
+	REQUIRE(phaseDurations.find(FilePath(L"a.cpp")) == phaseDurations.end());
+	REQUIRE(20 == phaseDurations[FilePath(L"b.cpp")]["ast traversal"]);
+	REQUIRE(5 == phaseDurations[FilePath()]["storage injection"]);
+}
@@ -2,9 +2,13 @@
 
 #include "utilityString.h"
 
+#include "Graph.h"
 #include "IntermediateStorage.h"
 #include "ParseLocation.h"
+#include "ParserClientImpl.h"
 #include "PersistentStorage.h"
+#include "StorageCache.h"
+#include "TokenComponentBundledEdges.h"
 
 namespace
 {
@@ -128,6 +132,459 @@ TEST_CASE("storage saves field as member")
 	REQUIRE(foundEdge);
 }
 
+TEST_CASE("storage builds trail graphs from cached adjacency")
+{
+	TestStorage storage;
+
+	std::shared_ptr<IntermediateStorage> intermetiateStorage = std::make_shared<IntermediateStorage>();
+
+	std::map<std::wstring, Id> ids;
+	for (const std::wstring name: {L"a", L"b", L"c", L"d", L"e"})
+	{
+		const Id id = intermetiateStorage
+						  ->addNode(StorageNodeData(
+							  nodeKindToInt(NODE_FUNCTION),
+							  NameHierarchy::serialize(
+								  createFunctionNameHierarchy(L"void", name, L"()"))))
+						  .first;
+		intermetiateStorage->addSymbol(StorageSymbol(id, DEFINITION_EXPLICIT));
+		ids[name] = id;
+	}
+
+	// a -> b -> c -> d and a -> e
+	for (const std::pair<std::wstring, std::wstring>& call:
+		 std::vector<std::pair<std::wstring, std::wstring>>(
+			 {{L"a", L"b"}, {L"b", L"c"}, {L"c", L"d"}, {L"a", L"e"}}))
+	{
+		intermetiateStorage->addEdge(StorageEdgeData(
+			Edge::typeToInt(Edge::EDGE_CALL), ids[call.first], ids[call.second]));
+	}
+
+	storage.inject(intermetiateStorage.get());
+	storage.buildCaches();
+
+	for (std::pair<const std::wstring, Id>& p: ids)
+	{
+		p.second = storage.getNodeIdForNameHierarchy(
+			createFunctionNameHierarchy(L"void", p.first, L"()"));
+	}
+
+	std::shared_ptr<Graph> callees = storage.getGraphForTrail(
+		ids[L"a"], 0, NODE_FUNCTION, Edge::EDGE_CALL, false, 2, true, 0);
+	REQUIRE(callees->getNodeCount() == 4);
+	REQUIRE(callees->getEdgeCount() == 3);
+	REQUIRE(callees->getNodeById(ids[L"c"]) != nullptr);
+	REQUIRE(callees->getNodeById(ids[L"d"]) == nullptr);
+
+	std::shared_ptr<Graph> callers = storage.getGraphForTrail(
+		0, ids[L"d"], NODE_FUNCTION, Edge::EDGE_CALL, false, 0, true, 0);
+	REQUIRE(callers->getNodeCount() == 4);
+	REQUIRE(callers->getNodeById(ids[L"e"]) == nullptr);
+
+	std::shared_ptr<Graph> path = storage.getGraphForTrail(
+		ids[L"a"], ids[L"d"], NODE_FUNCTION, Edge::EDGE_CALL, false, 0, true, 0);
+	REQUIRE(path->getNodeCount() == 4);
+	REQUIRE(path->getEdgeCount() == 3);
+	REQUIRE(path->getNodeById(ids[L"e"]) == nullptr);
+}
+
+TEST_CASE("storage finds shortest paths for terminated trails")
+{
+	TestStorage storage;
+
+	std::shared_ptr<IntermediateStorage> intermetiateStorage = std::make_shared<IntermediateStorage>();
+
+	std::map<std::wstring, Id> ids;
+	for (const std::wstring name: {L"a", L"b", L"c", L"d", L"e", L"f", L"x"})
+	{
+		const Id id = intermetiateStorage
+						  ->addNode(StorageNodeData(
+							  nodeKindToInt(NODE_FUNCTION),
+							  NameHierarchy::serialize(
+								  createFunctionNameHierarchy(L"void", name, L"()"))))
+						  .first;
+		if (name != L"x")
+		{
+			intermetiateStorage->addSymbol(StorageSymbol(id, DEFINITION_EXPLICIT));
+		}
+		ids[name] = id;
+	}
+
+	// a -> b -> d, a -> c -> d, a -> e -> f -> d and a -> x -> d with x not being defined
+	for (const std::pair<std::wstring, std::wstring>& call:
+		 std::vector<std::pair<std::wstring, std::wstring>>(
+			 {{L"a", L"b"},
+			  {L"b", L"d"},
+			  {L"a", L"c"},
+			  {L"c", L"d"},
+			  {L"a", L"e"},
+			  {L"e", L"f"},
+			  {L"f", L"d"},
+			  {L"a", L"x"},
+			  {L"x", L"d"}}))
+	{
+		intermetiateStorage->addEdge(StorageEdgeData(
+			Edge::typeToInt(Edge::EDGE_CALL), ids[call.first], ids[call.second]));
+	}
+
+	storage.inject(intermetiateStorage.get());
+	storage.buildCaches();
+
+	for (std::pair<const std::wstring, Id>& p: ids)
+	{
+		p.second = storage.getNodeIdForNameHierarchy(
+			createFunctionNameHierarchy(L"void", p.first, L"()"));
+	}
+
+	std::shared_ptr<Graph> shortestPaths = storage.getGraphForTrail(
+		ids[L"a"], ids[L"d"], NODE_FUNCTION, Edge::EDGE_CALL, false, 0, true, 0);
+	REQUIRE(shortestPaths->getNodeCount() == 4);
+	REQUIRE(shortestPaths->getEdgeCount() == 4);
+	REQUIRE(shortestPaths->getNodeById(ids[L"x"]) == nullptr);
+
+	std::shared_ptr<Graph> shortestPath = storage.getGraphForTrail(
+		ids[L"a"], ids[L"d"], NODE_FUNCTION, Edge::EDGE_CALL, false, 0, true, 1);
+	REQUIRE(shortestPath->getNodeCount() == 3);
+	REQUIRE(shortestPath->getEdgeCount() == 2);
+
+	std::shared_ptr<Graph> threePaths = storage.getGraphForTrail(
+		ids[L"a"], ids[L"d"], NODE_FUNCTION, Edge::EDGE_CALL, false, 0, true, 3);
+	REQUIRE(threePaths->getNodeCount() == 6);
+	REQUIRE(threePaths->getEdgeCount() == 7);
+
+	std::shared_ptr<Graph> allPaths = storage.getGraphForTrail(
+		ids[L"a"], ids[L"d"], NODE_FUNCTION, Edge::EDGE_CALL, true, 0, true, 10);
+	REQUIRE(allPaths->getNodeCount() == 7);
+	REQUIRE(allPaths->getEdgeCount() == 9);
+
+	std::shared_ptr<Graph> tooShort = storage.getGraphForTrail(
+		ids[L"a"], ids[L"d"], NODE_FUNCTION, Edge::EDGE_CALL, false, 1, true, 0);
+	REQUIRE(tooShort->getNodeCount() == 1);
+
+	std::shared_ptr<Graph> reversed = storage.getGraphForTrail(
+		ids[L"d"], ids[L"a"], NODE_FUNCTION, Edge::EDGE_CALL, false, 0, true, 0);
+	REQUIRE(reversed->getNodeCount() == 1);
+	REQUIRE(reversed->getNodeById(ids[L"d"]) != nullptr);
+}
+
+TEST_CASE("storage bundles edges of members by their visible parents")
+{
+	TestStorage storage;
+
+	std::shared_ptr<IntermediateStorage> intermetiateStorage = std::make_shared<IntermediateStorage>();
+
+	const std::vector<std::tuple<std::wstring, NodeKind, NameHierarchy>> nodes = {
+		{L"A", NODE_CLASS, createNameHierarchy(L"A")},
+		{L"a1", NODE_METHOD, createFunctionNameHierarchy(L"void", L"A::a1", L"()")},
+		{L"N", NODE_CLASS, createNameHierarchy(L"A::N")},
+		{L"n1", NODE_METHOD, createFunctionNameHierarchy(L"void", L"A::N::n1", L"()")},
+		{L"B", NODE_CLASS, createNameHierarchy(L"B")},
+		{L"b1", NODE_METHOD, createFunctionNameHierarchy(L"void", L"B::b1", L"()")},
+		{L"b2", NODE_METHOD, createFunctionNameHierarchy(L"void", L"B::b2", L"()")},
+		{L"f", NODE_FUNCTION, createFunctionNameHierarchy(L"void", L"f", L"()")}};
+
+	std::map<std::wstring, NameHierarchy> names;
+	std::map<std::wstring, Id> ids;
+	for (const std::tuple<std::wstring, NodeKind, NameHierarchy>& node: nodes)
+	{
+		const Id id = intermetiateStorage
+						  ->addNode(StorageNodeData(
+							  nodeKindToInt(std::get<1>(node)),
+							  NameHierarchy::serialize(std::get<2>(node))))
+						  .first;
+		intermetiateStorage->addSymbol(StorageSymbol(id, DEFINITION_EXPLICIT));
+		names.emplace(std::get<0>(node), std::get<2>(node));
+		ids[std::get<0>(node)] = id;
+	}
+
+	// A::a1 is called from B::b1, B::b2 and f, A::N::n1 is called from B::b1
+	for (const std::pair<std::wstring, std::wstring>& member:
+		 std::vector<std::pair<std::wstring, std::wstring>>(
+			 {{L"A", L"a1"}, {L"A", L"N"}, {L"N", L"n1"}, {L"B", L"b1"}, {L"B", L"b2"}}))
+	{
+		intermetiateStorage->addEdge(StorageEdgeData(
+			Edge::typeToInt(Edge::EDGE_MEMBER), ids[member.first], ids[member.second]));
+	}
+
+	for (const std::pair<std::wstring, std::wstring>& call:
+		 std::vector<std::pair<std::wstring, std::wstring>>(
+			 {{L"b1", L"a1"}, {L"b2", L"a1"}, {L"f", L"a1"}, {L"b1", L"n1"}}))
+	{
+		intermetiateStorage->addEdge(StorageEdgeData(
+			Edge::typeToInt(Edge::EDGE_CALL), ids[call.first], ids[call.second]));
+	}
+
+	storage.inject(intermetiateStorage.get());
+	storage.buildCaches();
+
+	for (std::pair<const std::wstring, Id>& p: ids)
+	{
+		p.second = storage.getNodeIdForNameHierarchy(names[p.first]);
+	}
+
+	auto getBundledEdgeCounts = [&](Id nodeId) {
+		std::map<Id, int> counts;
+		storage.getGraphForActiveTokenIds({nodeId}, {})->forEachEdge([&](Edge* edge) {
+			if (edge->isType(Edge::EDGE_BUNDLED_EDGES))
+			{
+				const Id otherId = edge->getFrom()->getId() == nodeId ? edge->getTo()->getId()
+																	  : edge->getFrom()->getId();
+				counts[otherId] =
+					edge->getComponent<TokenComponentBundledEdges>()->getBundledEdgesCount();
+			}
+		});
+		return counts;
+	};
+
+	const std::map<Id, int> classCounts = getBundledEdgeCounts(ids[L"A"]);
+	REQUIRE(classCounts.size() == 2);
+	REQUIRE(classCounts.at(ids[L"B"]) == 3);
+	REQUIRE(classCounts.at(ids[L"f"]) == 1);
+
+	const std::map<Id, int> nestedClassCounts = getBundledEdgeCounts(ids[L"N"]);
+	REQUIRE(nestedClassCounts.size() == 1);
+	REQUIRE(nestedClassCounts.at(ids[L"B"]) == 1);
+}
+
+TEST_CASE("storage stops graph query for active tokens when cancelled")
+{
+	NameHierarchy a = createNameHierarchy(L"Struct");
+	NameHierarchy b = createNameHierarchy(L"Struct::m_field");
+
+	TestStorage storage;
+
+	std::shared_ptr<IntermediateStorage> intermetiateStorage = std::make_shared<IntermediateStorage>();
+
+	Id aId = intermetiateStorage
+				 ->addNode(StorageNodeData(nodeKindToInt(NODE_STRUCT), NameHierarchy::serialize(a)))
+				 .first;
+	intermetiateStorage->addSymbol(StorageSymbol(aId, DEFINITION_EXPLICIT));
+
+	Id bId = intermetiateStorage
+				 ->addNode(StorageNodeData(nodeKindToInt(NODE_FIELD), NameHierarchy::serialize(b)))
+				 .first;
+	intermetiateStorage->addSymbol(StorageSymbol(bId, DEFINITION_EXPLICIT));
+	intermetiateStorage->addEdge(StorageEdgeData(Edge::typeToInt(Edge::EDGE_MEMBER), aId, bId));
+
+	storage.inject(intermetiateStorage.get());
+	storage.buildCaches();
+
+	const Id structId = storage.getNodeIdForNameHierarchy(a);
+
+	REQUIRE(storage.getGraphForActiveTokenIds({structId}, {})->getNodeCount() == 2);
+	REQUIRE(
+		storage.getGraphForActiveTokenIds({structId}, {}, nullptr, []() { return false; })
+			->getNodeCount() == 2);
+	REQUIRE(
+		storage.getGraphForActiveTokenIds({structId}, {}, nullptr, []() { return true; })
+			->getNodeCount() == 0);
+}
+
+TEST_CASE("storage cache keeps graphs of recent queries until subject changes")
+{
+	NameHierarchy a = createNameHierarchy(L"Struct");
+	NameHierarchy b = createNameHierarchy(L"Struct::m_field");
+
+	std::shared_ptr<TestStorage> storage = std::make_shared<TestStorage>();
+
+	std::shared_ptr<IntermediateStorage> intermetiateStorage = std::make_shared<IntermediateStorage>();
+
+	Id aId = intermetiateStorage
+				 ->addNode(StorageNodeData(nodeKindToInt(NODE_STRUCT), NameHierarchy::serialize(a)))
+				 .first;
+	intermetiateStorage->addSymbol(StorageSymbol(aId, DEFINITION_EXPLICIT));
+
+	Id bId = intermetiateStorage
+				 ->addNode(StorageNodeData(nodeKindToInt(NODE_FIELD), NameHierarchy::serialize(b)))
+				 .first;
+	intermetiateStorage->addSymbol(StorageSymbol(bId, DEFINITION_EXPLICIT));
+	intermetiateStorage->addEdge(StorageEdgeData(Edge::typeToInt(Edge::EDGE_MEMBER), aId, bId));
+
+	storage->inject(intermetiateStorage.get());
+	storage->buildCaches();
+
+	StorageCache cache;
+	cache.setSubject(storage);
+
+	const Id structId = storage->getNodeIdForNameHierarchy(a);
+
+	std::shared_ptr<Graph> graph = cache.getGraphForActiveTokenIds({structId}, {});
+	REQUIRE(graph->getNodeCount() == 2);
+
+	// modifying a returned graph does not modify the cached one
+	graph->removeNode(graph->getNodeById(structId));
+	REQUIRE(cache.getGraphForActiveTokenIds({structId}, {})->getNodeCount() == 2);
+
+	storage->clear();
+	REQUIRE(cache.getGraphForActiveTokenIds({structId}, {})->getNodeCount() == 2);
+
+	cache.setSubject(storage);
+	REQUIRE(cache.getGraphForActiveTokenIds({structId}, {})->getNodeCount() == 0);
+}
+
+TEST_CASE("storage injects large intermediate storage")
+{
+	const size_t nodeCount = 100000;
+	const size_t edgeCount = 1000000;
+
+	std::shared_ptr<IntermediateStorage> injected = std::make_shared<IntermediateStorage>();
+	std::vector<Id> nodeIds;
+	for (size_t i = 0; i < nodeCount; i++)
+	{
+		nodeIds.push_back(
+			injected->addNode(StorageNodeData(nodeKindToInt(NODE_FUNCTION), std::to_wstring(i)))
+				.first);
+	}
+	for (size_t i = 0; i < edgeCount; i++)
+	{
+		injected->addEdge(StorageEdgeData(
+			Edge::typeToInt(Edge::EDGE_CALL),
+			nodeIds[i % nodeCount],
+			nodeIds[(i / nodeCount + i * 7) % nodeCount]));
+	}
+	// edge with a target that is not part of the injected storage
+	injected->addEdge(StorageEdgeData(Edge::typeToInt(Edge::EDGE_CALL), nodeIds[0], 0));
+
+	IntermediateStorage storage;
+	storage.addNode(StorageNodeData(nodeKindToInt(NODE_FUNCTION), L"offset"));
+
+	storage.inject(injected.get());
+
+	REQUIRE(storage.getStorageNodes().size() == nodeCount + 1);
+	REQUIRE(storage.getStorageEdges().size() == edgeCount);
+
+	// every edge keeps its order and connects the nodes it was added for
+	const std::vector<StorageNode>& nodes = storage.getStorageNodes();
+	const std::vector<StorageEdge>& edges = storage.getStorageEdges();
+	bool edgesMatch = true;
+	for (size_t i = 0; i < edgeCount; i++)
+	{
+		edgesMatch &= nodes[edges[i].sourceNodeId - 1].serializedName ==
+				std::to_wstring(i % nodeCount) &&
+			nodes[edges[i].targetNodeId - 1].serializedName ==
+				std::to_wstring((i / nodeCount + i * 7) % nodeCount);
+	}
+	REQUIRE(edgesMatch);
+}
+
+TEST_CASE("parser client records shared name prefixes once")
+{
+	const size_t symbolCount = 1000;
+	const size_t referenceCount = 200000;
+
+	std::vector<NameHierarchy> symbolNames;
+	for (size_t i = 0; i < symbolCount; i++)
+	{
+		symbolNames.push_back(createFunctionNameHierarchy(
+			L"void",
+			L"a::b::c" + std::to_wstring(i % 10) + L"::d" + std::to_wstring(i % 100) + L"::f" +
+				std::to_wstring(i),
+			L"(int)"));
+	}
+
+	IntermediateStorage storage;
+	ParserClientImpl client(&storage);
+
+	std::vector<Id> symbolIds;
+	for (const NameHierarchy& symbolName: symbolNames)
+	{
+		symbolIds.push_back(client.recordSymbol(symbolName));
+	}
+
+	bool idsMatch = true;
+	for (size_t i = 0; i < referenceCount; i++)
+	{
+		idsMatch &= client.recordSymbol(symbolNames[(i * 7) % symbolCount]) ==
+			symbolIds[(i * 7) % symbolCount];
+	}
+	REQUIRE(idsMatch);
+
+	// a, a::b, 10 * a::b::c, 100 * a::b::c::d and all functions
+	REQUIRE(storage.getStorageNodes().size() == 2 + 10 + 100 + symbolCount);
+	REQUIRE(storage.getStorageEdges().size() == storage.getStorageNodes().size() - 1);
+
+	bool foundNode = false;
+	for (const StorageNode& node: storage.getStorageNodes())
+	{
+		if (node.id == symbolIds[42])
+		{
+			foundNode = node.serializedName == NameHierarchy::serialize(symbolNames[42]);
+		}
+	}
+	REQUIRE(foundNode);
+}
+
+// Records what the Cxx parser records for a translation unit like the inputs of CxxParserTestSuite,
+// scaled up: classes in nested namespaces with fields and methods, and method bodies that call
+// methods and use types of other classes. Run with the "[benchmark]" tag.
+TEST_CASE("parser client records references of a large translation unit", "[.][benchmark]")
+{
+	const size_t namespaceCount = 20;
+	const size_t classCount = 400;
+	const size_t memberCount = 10;
+	const size_t callCount = 20;
+
+	std::vector<NameHierarchy> typeNames;
+	std::vector<NameHierarchy> fieldNames;
+	std::vector<NameHierarchy> methodNames;
+	for (size_t i = 0; i < classCount; i++)
+	{
+		const std::wstring className = L"project::module" + std::to_wstring(i % namespaceCount) +
+			L"::detail::Class" + std::to_wstring(i) + L"<int>";
+		typeNames.push_back(createNameHierarchy(className));
+
+		for (size_t j = 0; j < memberCount; j++)
+		{
+			fieldNames.push_back(
+				createNameHierarchy(className + L"::m_field" + std::to_wstring(j)));
+			methodNames.push_back(createFunctionNameHierarchy(
+				L"void",
+				className + L"::method" + std::to_wstring(j),
+				L"(int, const std::basic_string<char> &) const"));
+		}
+	}
+
+	size_t nodeCount = 0;
+	BENCHMARK("record symbols and references")
+	{
+		IntermediateStorage storage;
+		ParserClientImpl client(&storage);
+
+		for (size_t i = 0; i < methodNames.size(); i++)
+		{
+			const Id methodId = client.recordSymbol(methodNames[i]);
+			client.recordSymbolKind(methodId, SYMBOL_METHOD);
+			client.recordLocation(methodId, validLocation(i), ParseLocationType::TOKEN);
+			client.recordSymbolKind(client.recordSymbol(fieldNames[i]), SYMBOL_FIELD);
+
+			for (size_t j = 0; j < callCount; j++)
+			{
+				const size_t target = (i * 31 + j * 17) % methodNames.size();
+				client.recordReference(
+					REFERENCE_CALL,
+					client.recordSymbol(methodNames[target]),
+					methodId,
+					validLocation(i * callCount + j));
+				client.recordReference(
+					REFERENCE_TYPE_USAGE,
+					client.recordSymbol(typeNames[target / memberCount]),
+					methodId,
+					validLocation(i * callCount + j));
+				client.recordReference(
+					REFERENCE_USAGE,
+					client.recordSymbol(fieldNames[target]),
+					methodId,
+					validLocation(i * callCount + j));
+			}
+		}
+
+		nodeCount = storage.getStorageNodes().size();
+	}
+
+	// project, modules, detail namespaces, classes and their members
+	REQUIRE(nodeCount == 1 + 2 * namespaceCount + classCount * (1 + 2 * memberCount));
+}
+
 TEST_CASE("storage saves method static")
 {
 	// TestStorage storage;
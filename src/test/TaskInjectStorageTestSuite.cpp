@@ -0,0 +1,88 @@
+#include "catch.hpp"
+
+#include "Blackboard.h"
+#include "IntermediateStorage.h"
+#include "MessageIndexingInterrupted.h"
+#include "StorageProvider.h"
+#include "TaskInjectStorage.h"
+
+namespace
+{
+std::shared_ptr<IntermediateStorage> createStorage(size_t nodeCount, const std::wstring& name)
+{
+	std::shared_ptr<IntermediateStorage> storage = std::make_shared<IntermediateStorage>();
+	for (size_t i = 0; i < nodeCount; i++)
+	{
+		storage->addNode(StorageNodeData(0, name + std::to_wstring(i)));
+	}
+	return storage;
+}
+
+void interrupt(TaskInjectStorage& task)
+{
+	MessageIndexingInterrupted message;
+	task.handleMessageBase(&message);
+}
+}	 // namespace
+
+TEST_CASE("inject storage task injects all storages")
+{
+	std::shared_ptr<StorageProvider> storageProvider = std::make_shared<StorageProvider>();
+	storageProvider->insert(createStorage(2, L"a"));
+	storageProvider->insert(createStorage(1, L"b"));
+
+	std::shared_ptr<IntermediateStorage> target = std::make_shared<IntermediateStorage>();
+	std::shared_ptr<Blackboard> blackboard = std::make_shared<Blackboard>();
+	TaskInjectStorage task(storageProvider, target);
+
+	REQUIRE(task.update(blackboard) == Task::STATE_SUCCESS);
+	REQUIRE(task.update(blackboard) == Task::STATE_SUCCESS);
+	REQUIRE(task.update(blackboard) == Task::STATE_FAILURE);
+
+	REQUIRE(target->getStorageNodes().size() == 3);
+}
+
+TEST_CASE("inject storage task drops only the batch prepared before an interrupt")
+{
+	std::shared_ptr<StorageProvider> storageProvider = std::make_shared<StorageProvider>();
+	storageProvider->insert(createStorage(3, L"a"));
+	storageProvider->insert(createStorage(2, L"b"));
+	storageProvider->insert(createStorage(1, L"c"));
+
+	std::shared_ptr<IntermediateStorage> target = std::make_shared<IntermediateStorage>();
+	std::shared_ptr<Blackboard> blackboard = std::make_shared<Blackboard>();
+	TaskInjectStorage task(storageProvider, target);
+
+	// injects "a" and prepares "b"
+	REQUIRE(task.update(blackboard) == Task::STATE_SUCCESS);
+	REQUIRE(target->getStorageNodes().size() == 3);
+
+	interrupt(task);
+	REQUIRE(storageProvider->getStorageCount() == 0);
+
+	// translation units that were running during the interrupt still finish
+	storageProvider->insert(createStorage(4, L"d"));
+
+	REQUIRE(task.update(blackboard) == Task::STATE_SUCCESS);
+	REQUIRE(task.update(blackboard) == Task::STATE_FAILURE);
+
+	REQUIRE(target->getStorageNodes().size() == 3 + 4);
+}
+
+TEST_CASE("inject storage task created before an interrupt injects later storages")
+{
+	std::shared_ptr<StorageProvider> storageProvider = std::make_shared<StorageProvider>();
+	storageProvider->insert(createStorage(1, L"a"));
+
+	std::shared_ptr<IntermediateStorage> target = std::make_shared<IntermediateStorage>();
+	std::shared_ptr<Blackboard> blackboard = std::make_shared<Blackboard>();
+	TaskInjectStorage task(storageProvider, target);
+
+	interrupt(task);
+	storageProvider->insert(createStorage(2, L"b"));
+
+	REQUIRE(task.update(blackboard) == Task::STATE_SUCCESS);
+	REQUIRE(task.update(blackboard) == Task::STATE_FAILURE);
+
+	REQUIRE(target->getStorageNodes().size() == 2);
+}
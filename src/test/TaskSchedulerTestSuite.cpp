@@ -129,6 +129,17 @@ TEST_CASE("scheduler loop starts and stops")
 	REQUIRE(!scheduler.loopIsRunning());
 }
 
+TEST_CASE("scheduler loop stops right after start")
+{
+	TaskScheduler scheduler(0);
+
+	scheduler.startSchedulerLoopThreaded();
+	REQUIRE(scheduler.loopIsRunning());
+
+	scheduler.stopSchedulerLoop();
+	REQUIRE(!scheduler.loopIsRunning());
+}
+
 TEST_CASE("tasks get executed without scheduling in correct order")
 {
 	int order = 0;
@@ -0,0 +1,169 @@
+#include "catch.hpp"
+
+#include <random>
+
+#include "DummyEdge.h"
+#include "DummyNode.h"
+#include "Graph.h"
+#include "TrailLayouter.h"
+
+namespace
+{
+class TestTrail
+{
+public:
+	TestTrail(size_t nodeCount)
+	{
+		for (size_t i = 0; i < nodeCount; i++)
+		{
+			const Id id = i + 1;
+
+			std::shared_ptr<DummyNode> node = std::make_shared<DummyNode>(DummyNode::DUMMY_DATA);
+			node->tokenId = id;
+			node->data = m_graph.createNode(
+				id, NodeType(NODE_FUNCTION), NameHierarchy(std::to_wstring(id), NAME_DELIMITER_CXX),
+				DEFINITION_EXPLICIT);
+			node->visible = true;
+			node->size = Vec2i(100, 20);
+
+			nodes.push_back(node);
+			m_topLevelAncestorIds.emplace(id, id);
+		}
+
+		if (nodes.size())
+		{
+			nodes[0]->active = true;
+		}
+	}
+
+	DummyEdge* addEdge(size_t originIndex, size_t targetIndex)
+	{
+		const Id originId = originIndex + 1;
+		const Id targetId = targetIndex + 1;
+
+		std::shared_ptr<DummyEdge> edge = std::make_shared<DummyEdge>(
+			originId,
+			targetId,
+			m_graph.createEdge(
+				nodes.size() + edges.size() + 1,
+				Edge::EDGE_CALL,
+				m_graph.getNodeById(originId),
+				m_graph.getNodeById(targetId)));
+		edge->visible = true;
+
+		edges.push_back(edge);
+		return edge.get();
+	}
+
+	void layout(TrailLayouter::LayoutDirection direction)
+	{
+		TrailLayouter layouter(direction);
+		layouter.layoutGraph(nodes, edges, m_topLevelAncestorIds);
+	}
+
+	bool edgesPointRight() const
+	{
+		for (const std::shared_ptr<DummyEdge>& edge: edges)
+		{
+			if (nodes[edge->ownerId - 1]->position.x >= nodes[edge->targetId - 1]->position.x)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	std::vector<std::shared_ptr<DummyNode>> nodes;
+	std::vector<std::shared_ptr<DummyEdge>> edges;
+
+private:
+	Graph m_graph;
+	std::map<Id, Id> m_topLevelAncestorIds;
+};
+
+void addRandomTrailEdges(TestTrail& trail, size_t nodeCount, unsigned int seed)
+{
+	std::mt19937 random(seed);
+
+	// every node is called by one of its predecessors and calls a few of its successors
+	for (size_t i = 1; i < nodeCount; i++)
+	{
+		trail.addEdge(std::uniform_int_distribution<size_t>(i > 10 ? i - 10 : 0, i - 1)(random), i);
+	}
+
+	for (size_t i = 0; i + 2 < nodeCount; i++)
+	{
+		for (int j = 0; j < 2; j++)
+		{
+			const size_t target = std::uniform_int_distribution<size_t>(
+				i + 2, std::min(i + 20, nodeCount - 1))(random);
+			trail.addEdge(i, target);
+		}
+	}
+}
+}	 // namespace
+
+TEST_CASE("trail layouter places callees behind their callers")
+{
+	TestTrail trail(4);
+	trail.addEdge(0, 1);
+	trail.addEdge(1, 2);
+	trail.addEdge(0, 3);
+	trail.addEdge(3, 2);
+	DummyEdge* skippingEdge = trail.addEdge(0, 2);
+
+	trail.layout(TrailLayouter::LAYOUT_LEFT_RIGHT);
+
+	REQUIRE(trail.edgesPointRight());
+	REQUIRE(trail.nodes[1]->position.x == trail.nodes[3]->position.x);
+	REQUIRE(trail.nodes[1]->position.y != trail.nodes[3]->position.y);
+	REQUIRE(skippingEdge->path.size() == 1);
+}
+
+TEST_CASE("trail layouter breaks cycles of trail")
+{
+	TestTrail trail(3);
+	trail.addEdge(0, 1);
+	trail.addEdge(1, 2);
+	trail.addEdge(2, 0);
+
+	trail.layout(TrailLayouter::LAYOUT_LEFT_RIGHT);
+
+	for (const std::shared_ptr<DummyNode>& node: trail.nodes)
+	{
+		REQUIRE(node->visible);
+	}
+	REQUIRE(trail.nodes[0]->position.x < trail.nodes[1]->position.x);
+	REQUIRE(trail.nodes[1]->position.x < trail.nodes[2]->position.x);
+}
+
+TEST_CASE("trail layouter lays out deep trails")
+{
+	const size_t nodeCount = 5000;
+
+	TestTrail trail(nodeCount);
+	for (size_t i = 0; i + 1 < nodeCount; i++)
+	{
+		trail.addEdge(i, i + 1);
+	}
+
+	trail.layout(TrailLayouter::LAYOUT_TOP_BOTTOM);
+
+	for (size_t i = 0; i + 1 < nodeCount; i++)
+	{
+		REQUIRE(trail.nodes[i]->position.y < trail.nodes[i + 1]->position.y);
+	}
+}
+
+TEST_CASE("trail layouter lays out large synthetic trails")
+{
+	for (size_t nodeCount: {100, 1000, 10000})
+	{
+		TestTrail trail(nodeCount);
+		addRandomTrailEdges(trail, nodeCount, static_cast<unsigned int>(nodeCount));
+
+		trail.layout(TrailLayouter::LAYOUT_LEFT_RIGHT);
+
+		REQUIRE(trail.edgesPointRight());
+	}
+}